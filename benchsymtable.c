@@ -0,0 +1,1207 @@
+/*********************************************************************/
+/* benchsymtable.c                                                   */
+/* COS 217 Assignment 3: A Symbol Table ADT                          */
+/* Date: 10/31/2023                                                  */
+/* Author: Hugh Peterson                                             */
+/* Description: Times each SymTable operation separately over        */
+/*              several key distributions and table sizes, and       */
+/*              writes the results as CSV or JSON lines. Modes:      */
+/*              -DBENCH_U64: times SymTableU64 instead, on the       */
+/*                 numbers that the keys spell                       */
+/*              -DBENCH_FILTER: enables the symtablehash.c filter    */
+/*                 and reports its false-positive rate               */
+/*              -DBENCH_CACHE: also replays the Zipfian lookups on   */
+/*                 symtablehash.c bounded as a cache, and reports    */
+/*                 its hit rate and throughput                       */
+/*              -DBENCH_HUGE: gives symtablehash.c its memory from   */
+/*                 a SymTableHuge_T and reports how it is backed     */
+/*********************************************************************/
+
+/*********************************************************************/
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "symtable.h"
+#ifdef BENCH_U64
+#include "symtableu64.h"
+#endif
+#if defined(BENCH_FILTER) || defined(BENCH_CACHE)
+#include "symtablehash.h"
+#endif
+#ifdef BENCH_HUGE
+#include "symtablehuge.h"
+#endif
+
+/*********************************************************************/
+
+enum {
+   /* longest key any distribution generates, including its NUL */
+   MAX_KEY_LENGTH = 280,
+
+   /* length of the keys of the long-key distribution */
+   LONG_KEY_LENGTH = 256,
+
+   /* fewest operations timed in one phase of one trial */
+   MIN_OPS_PER_TRIAL = 100000,
+
+   /* largest table the adversarial distribution is generated for */
+   MAX_COLLIDING_KEYS = 10000,
+
+   /* largest table size accepted on the command line */
+   MAX_TABLE_SIZE = 100000000,
+
+   /* passes of the churn phase; even, so that the table ends up
+      holding the hits again */
+   CHURN_PASSES = 8
+};
+
+/*
+ * The key distributions that can be measured.
+ */
+enum Distribution {
+   DIST_SEQUENTIAL,
+   DIST_RANDOM,
+   DIST_ZIPF,
+   DIST_LONG,
+   DIST_COLLIDE,
+   DIST_COUNT
+};
+
+/*
+ * The operations that are timed separately.
+ */
+enum Operation {
+   OP_PUT,
+   OP_GET_HIT,
+   OP_GET_MISS,
+   OP_CHURN_FIRST,
+   OP_CHURN_LAST,
+   OP_REMOVE,
+   OP_COUNT
+};
+
+/*********************************************************************/
+
+/* names of the distributions, indexed by enum Distribution */
+static const char *const apcDistNames[DIST_COUNT] = {
+   "sequential", "random", "zipf", "long", "collide"
+};
+
+/* names of the operations, indexed by enum Operation */
+static const char *const apcOpNames[OP_COUNT] = {
+   "put", "get_hit", "get_miss", "churn_first", "churn_last", "remove"
+};
+
+/*********************************************************************/
+
+/*
+ * A set of generated keys stored back to back.
+ */
+struct KeySet {
+   /* the keys that are put into the table */
+   char **hits;
+
+   /* keys of the same shape that are never put into the table */
+   char **misses;
+
+   /* storage for every key of both arrays */
+   char *storage;
+
+   /* the number in each key: ids[i] for hits[i], ids[count + i] for
+      misses[i] */
+   unsigned long *ids;
+
+   /* number of keys in each array */
+   size_t count;
+};
+
+/*
+ * The order in which each phase of a trial visits the keys.
+ */
+struct Schedule {
+   /* indices into hits, in put order */
+   size_t *putOrder;
+
+   /* indices into hits, in lookup order (may repeat keys) */
+   size_t *getOrder;
+
+   /* indices into hits, in removal order */
+   size_t *removeOrder;
+};
+
+/*
+ * The settings given on the command line.
+ */
+struct Options {
+   /* table sizes to measure, in increasing order */
+   size_t sizes[32];
+
+   /* number of entries of sizes */
+   size_t sizeCount;
+
+   /* distributions[d] is 1 if distribution d is measured */
+   int distributions[DIST_COUNT];
+
+   /* number of timed trials per case */
+   int trials;
+
+   /* number of untimed trials per case */
+   int warmups;
+
+   /* seconds one case may take before larger sizes are skipped */
+   double budget;
+
+   /* 1 for JSON lines, 0 for CSV */
+   int json;
+
+   /* name reported for the implementation under test */
+   const char *backend;
+};
+
+/*********************************************************************/
+
+/* state of the pseudo-random number generator */
+static size_t uRandomState = (size_t)0x9e3779b97f4a7c15UL;
+
+/*
+ * Returns the next pseudo-random number (xorshift64*).
+ */
+static size_t nextRandom(void) {
+   uRandomState ^= uRandomState >> 12;
+   uRandomState ^= uRandomState << 25;
+   uRandomState ^= uRandomState >> 27;
+   return uRandomState * (size_t)0x2545f4914f6cdd1dUL;
+}
+
+/*
+ * Returns a well-mixed, invertible function of uValue (the
+ * MurmurHash3 finalizer), so distinct inputs give distinct outputs.
+ */
+static size_t mix(size_t uValue) {
+   uValue ^= uValue >> 33;
+   uValue *= (size_t)0xff51afd7ed558ccdUL;
+   uValue ^= uValue >> 33;
+   uValue *= (size_t)0xc4ceb9fe1a85ec53UL;
+   uValue ^= uValue >> 33;
+   return uValue;
+}
+
+/*
+ * Returns the current time in nanoseconds.
+ */
+static double now(void) {
+   struct timespec sTime;
+
+   clock_gettime(CLOCK_MONOTONIC, &sTime);
+   return (double)sTime.tv_sec * 1e9 + (double)sTime.tv_nsec;
+}
+
+/*
+ * Returns the hash that symtablehash.c computes for pcKey before
+ * reducing it to a bucket.
+ */
+static size_t hashTableHash(const char *pcKey) {
+   const size_t HASH_MULTIPLIER = 65599;
+
+   size_t u;
+   size_t uHash = 0;
+
+   for (u = 0; pcKey[u] != '\0'; u++) {
+      uHash = uHash * HASH_MULTIPLIER + (size_t)pcKey[u];
+   }
+   return uHash;
+}
+
+/*
+ * Returns the number of buckets that symtablehash.c ends up with
+ * after uCount puts into a new table.
+ */
+static size_t hashTableBuckets(size_t uCount) {
+   static const size_t auBuckets[] = {
+      509, 1021, 2039, 4093, 8191, 16381, 32749, 65521
+   };
+   size_t u;
+
+   for (u = 0; u < sizeof(auBuckets) / sizeof(auBuckets[0]) - 1; u++) {
+      if (uCount <= auBuckets[u]) {
+         break;
+      }
+   }
+   return auBuckets[u];
+}
+
+/*********************************************************************/
+
+/*
+ * Returns the number that key number uIndex of distribution eDist
+ * spells in decimal (sequential keys) or hexadecimal (random and
+ * Zipfian keys, and the end of long keys).
+ */
+static unsigned long keyNumber(enum Distribution eDist, size_t uIndex) {
+   if (eDist == DIST_SEQUENTIAL) {
+      return (unsigned long)uIndex;
+   }
+   return (unsigned long)mix(uIndex);
+}
+
+/*
+ * Writes key number uIndex of distribution eDist into pcKey. Keys of
+ * the adversarial distribution come from collidingKey() instead.
+ */
+static void formatKey(enum Distribution eDist, size_t uIndex,
+                      char *pcKey) {
+   size_t u;
+
+   assert(pcKey != NULL);
+
+   switch (eDist) {
+      case DIST_SEQUENTIAL:
+         sprintf(pcKey, "%lu", (unsigned long)uIndex);
+         break;
+      case DIST_LONG:
+         /* a long shared prefix makes every comparison expensive */
+         for (u = 0; u < LONG_KEY_LENGTH - 16; u++) {
+            pcKey[u] = (char)('a' + u % 26);
+         }
+         sprintf(pcKey + u, "%016lx", (unsigned long)mix(uIndex));
+         break;
+      default:
+         sprintf(pcKey, "%016lx", (unsigned long)mix(uIndex));
+         break;
+   }
+}
+
+/*
+ * Writes to pcKey the next key, starting from candidate *puCandidate,
+ * whose hash in symtablehash.c falls in bucket 0 of a table with
+ * uBuckets buckets, and advances *puCandidate past it.
+ */
+static void collidingKey(size_t *puCandidate, size_t uBuckets,
+                         char *pcKey) {
+   assert(puCandidate != NULL);
+   assert(pcKey != NULL);
+
+   do {
+      sprintf(pcKey, "c%lu", (unsigned long)*puCandidate);
+      (*puCandidate)++;
+   } while (hashTableHash(pcKey) % uBuckets != 0);
+}
+
+/*
+ * Fills in psKeys with uCount hit keys and uCount miss keys of
+ * distribution eDist. Returns 1 if successful and 0 if memory is
+ * insufficient.
+ */
+static int makeKeys(enum Distribution eDist, size_t uCount,
+                    struct KeySet *psKeys) {
+   char acKey[MAX_KEY_LENGTH];
+   size_t uBytes = 0;
+   size_t uCandidate = 0;
+   size_t uBuckets;
+   size_t u;
+   char *pcNext;
+   char **ppcSlot;
+
+   assert(psKeys != NULL);
+
+   psKeys->count = uCount;
+   psKeys->hits = (char **) malloc(2 * uCount * sizeof(char *) + 1);
+   if (psKeys->hits == NULL) {
+      return 0;
+   }
+   psKeys->misses = psKeys->hits + uCount;
+
+   /* measure, then copy into one block */
+   uBuckets = hashTableBuckets(uCount);
+   for (u = 0; u < 2 * uCount; u++) {
+      if (eDist == DIST_COLLIDE) {
+         collidingKey(&uCandidate, uBuckets, acKey);
+      }
+      else {
+         formatKey(eDist, u, acKey);
+      }
+      uBytes += strlen(acKey) + 1;
+   }
+   psKeys->storage = (char *) malloc(uBytes + 1);
+   psKeys->ids =
+      (unsigned long *) malloc(2 * uCount * sizeof(unsigned long) + 1);
+   if (psKeys->storage == NULL || psKeys->ids == NULL) {
+      free(psKeys->hits);
+      free(psKeys->storage);
+      free(psKeys->ids);
+      return 0;
+   }
+
+   uCandidate = 0;
+   pcNext = psKeys->storage;
+   for (u = 0; u < 2 * uCount; u++) {
+      ppcSlot = (u < uCount) ? &psKeys->hits[u]
+         : &psKeys->misses[u - uCount];
+      if (eDist == DIST_COLLIDE) {
+         collidingKey(&uCandidate, uBuckets, pcNext);
+      }
+      else {
+         formatKey(eDist, u, pcNext);
+      }
+      *ppcSlot = pcNext;
+      pcNext += strlen(pcNext) + 1;
+      psKeys->ids[u] = keyNumber(eDist, u);
+   }
+   return 1;
+}
+
+/*
+ * Frees the memory of psKeys.
+ */
+static void freeKeys(struct KeySet *psKeys) {
+   assert(psKeys != NULL);
+
+   free(psKeys->hits);
+   free(psKeys->storage);
+   free(psKeys->ids);
+}
+
+/*
+ * Fills auOrder with a random permutation of 0 through uCount - 1.
+ */
+static void shuffle(size_t *auOrder, size_t uCount) {
+   size_t u;
+   size_t v;
+   size_t uTemp;
+
+   assert(auOrder != NULL);
+
+   for (u = 0; u < uCount; u++) {
+      auOrder[u] = u;
+   }
+   for (u = uCount; u > 1; u--) {
+      v = nextRandom() % u;
+      uTemp = auOrder[u - 1];
+      auOrder[u - 1] = auOrder[v];
+      auOrder[v] = uTemp;
+   }
+}
+
+/*
+ * Fills auOrder with uCount samples of 0 through uCount - 1 drawn
+ * from a Zipfian distribution with exponent 0.99, using the method of
+ * Gray et al., "Quickly Generating Billion-Record Synthetic
+ * Databases". Rank 0 is the most popular.
+ */
+static void zipf(size_t *auOrder, size_t uCount) {
+   const double THETA = 0.99;
+
+   double dZetaN = 0.0;
+   double dZeta2;
+   double dAlpha;
+   double dEta;
+   double dU;
+   double dUZ;
+   size_t u;
+   size_t uRank;
+
+   assert(auOrder != NULL);
+
+   for (u = 1; u <= uCount; u++) {
+      dZetaN += 1.0 / pow((double)u, THETA);
+   }
+   dZeta2 = 1.0 + 1.0 / pow(2.0, THETA);
+   dAlpha = 1.0 / (1.0 - THETA);
+   dEta = (1.0 - pow(2.0 / (double)uCount, 1.0 - THETA))
+      / (1.0 - dZeta2 / dZetaN);
+
+   for (u = 0; u < uCount; u++) {
+      dU = (double)(nextRandom() >> 11) / 9007199254740992.0;
+      dUZ = dU * dZetaN;
+      if (dUZ < 1.0) {
+         uRank = 0;
+      }
+      else if (dUZ < dZeta2) {
+         uRank = 1;
+      }
+      else {
+         uRank = (size_t)((double)uCount
+                          * pow(dEta * dU - dEta + 1.0, dAlpha));
+      }
+      auOrder[u] = (uRank < uCount) ? uRank : uCount - 1;
+   }
+}
+
+/*
+ * Fills in psSchedule for uCount keys of distribution eDist. Returns
+ * 1 if successful and 0 if memory is insufficient.
+ */
+static int makeSchedule(enum Distribution eDist, size_t uCount,
+                        struct Schedule *psSchedule) {
+   size_t u;
+   size_t uBytes;
+
+   assert(psSchedule != NULL);
+
+   /* one extra byte keeps malloc(0) from returning NULL */
+   uBytes = uCount * sizeof(size_t) + 1;
+   psSchedule->putOrder = (size_t *) malloc(uBytes);
+   psSchedule->getOrder = (size_t *) malloc(uBytes);
+   psSchedule->removeOrder = (size_t *) malloc(uBytes);
+   if (psSchedule->putOrder == NULL || psSchedule->getOrder == NULL
+       || psSchedule->removeOrder == NULL) {
+      free(psSchedule->putOrder);
+      free(psSchedule->getOrder);
+      free(psSchedule->removeOrder);
+      return 0;
+   }
+
+   /* sequential keys are put in order, as testLargeTable does */
+   if (eDist == DIST_SEQUENTIAL) {
+      for (u = 0; u < uCount; u++) {
+         psSchedule->putOrder[u] = u;
+      }
+   }
+   else {
+      shuffle(psSchedule->putOrder, uCount);
+   }
+
+   if (eDist == DIST_ZIPF) {
+      zipf(psSchedule->getOrder, uCount);
+   }
+   else {
+      shuffle(psSchedule->getOrder, uCount);
+   }
+   shuffle(psSchedule->removeOrder, uCount);
+   return 1;
+}
+
+/*
+ * Frees the memory of psSchedule.
+ */
+static void freeSchedule(struct Schedule *psSchedule) {
+   assert(psSchedule != NULL);
+
+   free(psSchedule->putOrder);
+   free(psSchedule->getOrder);
+   free(psSchedule->removeOrder);
+}
+
+/*********************************************************************/
+
+#ifdef BENCH_FILTER
+/* the false-positive rate of the filter over the misses of the last
+   trial run */
+static double dFalsePositiveRate;
+#endif
+
+#ifdef BENCH_HUGE
+/* how the memory of the full table of the first round was backed */
+static struct SymTableHugeStats sHugeStats;
+#endif
+
+#ifdef BENCH_CACHE
+
+/* capacities at which the cache is measured, as fractions of the
+   number of keys */
+static const double adCacheFractions[] = {0.01, 0.1, 0.5};
+
+/*
+ * Counts an eviction: pvExtra is the count.
+ */
+static void countEviction(const char *pcKey, void *pvValue,
+                          void *pvExtra) {
+   (void) pcKey;
+   (void) pvValue;
+   assert(pvExtra != NULL);
+
+   (*(size_t *)pvExtra)++;
+}
+
+/*
+ * Replays the lookups of psSchedule uRounds times against a table
+ * bounded to each fraction of psKeys in turn, putting each key that
+ * misses, as a memoizing client would. Writes the hit rate and
+ * lookups per second of each capacity to stderr, so that the CSV
+ * compares column for column with benchsymtablehash. Returns 1 if
+ * successful and 0 if memory is insufficient.
+ */
+static int benchCache(enum Distribution eDist,
+                      const struct KeySet *psKeys,
+                      const struct Schedule *psSchedule,
+                      size_t uRounds) {
+   SymTable_T oSymTable;
+   const char *pcKey;
+   size_t uCapacity;
+   size_t uEvicted;
+   size_t uHits;
+   size_t uRound;
+   size_t u;
+   size_t f;
+   double dStart;
+   double dSeconds;
+
+   assert(psKeys != NULL);
+   assert(psSchedule != NULL);
+
+   for (f = 0; f < sizeof(adCacheFractions) / sizeof(double); f++) {
+      uCapacity = (size_t)(adCacheFractions[f] * (double)psKeys->count);
+      if (uCapacity == 0) {
+         continue;
+      }
+      oSymTable = SymTable_new();
+      if (oSymTable == NULL) {
+         return 0;
+      }
+      uEvicted = 0;
+      SymTable_setEvictHandler(oSymTable, countEviction, &uEvicted);
+      SymTable_setCapacity(oSymTable, uCapacity);
+
+      uHits = 0;
+      dStart = now();
+      for (uRound = 0; uRound < uRounds; uRound++) {
+         for (u = 0; u < psKeys->count; u++) {
+            pcKey = psKeys->hits[psSchedule->getOrder[u]];
+            if (SymTable_get(oSymTable, pcKey) != NULL) {
+               uHits++;
+            }
+            else if (!SymTable_put(oSymTable, pcKey, pcKey)) {
+               SymTable_free(oSymTable);
+               return 0;
+            }
+         }
+      }
+      dSeconds = (now() - dStart) / 1e9;
+
+      fprintf(stderr, "%s %lu: cache of %lu hit rate %.4f, "
+              "%.0f lookups/s, %lu evictions\n", apcDistNames[eDist],
+              (unsigned long)psKeys->count, (unsigned long)uCapacity,
+              (double)uHits / (double)(uRounds * psKeys->count),
+              (double)(uRounds * psKeys->count) / dSeconds,
+              (unsigned long)uEvicted);
+      SymTable_free(oSymTable);
+   }
+   return 1;
+}
+
+#endif
+
+#ifndef BENCH_U64
+
+/*
+ * Runs uRounds rounds of put, get of every hit, get of every miss,
+ * churn, and remove over psKeys in the order given by psSchedule,
+ * each on a new table, and adds the nanoseconds spent in each phase to
+ * adPhaseNs. Stores in *pdBytesPerBinding the memory the full table
+ * holds per binding. Returns 1 if every operation gave the expected
+ * result and 0 otherwise.
+ */
+static int runTrial(const struct KeySet *psKeys,
+                    const struct Schedule *psSchedule, size_t uRounds,
+                    double adPhaseNs[OP_COUNT],
+                    double *pdBytesPerBinding) {
+   SymTable_T oSymTable;
+   struct SymTableMemory sMemory;
+   char **apcOut;
+   char **apcIn;
+#ifdef BENCH_FILTER
+   struct SymTableStats sStats;
+#endif
+#ifdef BENCH_HUGE
+   struct SymTableAllocator sAllocator;
+   SymTableHuge_T oHuge;
+#endif
+   size_t uRound;
+   size_t u;
+   size_t uFound;
+   double dStart;
+   double dPassNs;
+   int iPass;
+   int iCorrect = 1;
+
+   assert(psKeys != NULL);
+   assert(psSchedule != NULL);
+   assert(pdBytesPerBinding != NULL);
+
+#ifdef BENCH_HUGE
+   SymTableHuge_getAllocator(&sAllocator);
+#endif
+
+   for (uRound = 0; uRound < uRounds; uRound++) {
+#ifdef BENCH_HUGE
+      oHuge = SymTableHuge_new();
+      if (oHuge == NULL) {
+         return 0;
+      }
+      oSymTable = SymTable_newWithAllocator(&sAllocator, oHuge);
+      if (oSymTable == NULL) {
+         SymTableHuge_free(oHuge);
+         return 0;
+      }
+#else
+      oSymTable = SymTable_new();
+      if (oSymTable == NULL) {
+         return 0;
+      }
+#endif
+#ifdef BENCH_FILTER
+      if (!SymTable_enableFilter(oSymTable)) {
+         SymTable_free(oSymTable);
+         return 0;
+      }
+#endif
+
+      uFound = 0;
+      dStart = now();
+      for (u = 0; u < psKeys->count; u++) {
+         uFound += (size_t)SymTable_put(
+            oSymTable, psKeys->hits[psSchedule->putOrder[u]],
+            psKeys->hits[psSchedule->putOrder[u]]);
+      }
+      adPhaseNs[OP_PUT] += now() - dStart;
+      iCorrect = iCorrect && (uFound == psKeys->count);
+
+      if (uRound == 0) {
+         SymTable_memoryUsage(oSymTable, &sMemory);
+         *pdBytesPerBinding =
+            (double)sMemory.total / (double)psKeys->count;
+#ifdef BENCH_HUGE
+         SymTableHuge_getStats(oHuge, &sHugeStats);
+#endif
+      }
+
+      uFound = 0;
+      dStart = now();
+      for (u = 0; u < psKeys->count; u++) {
+         uFound += (SymTable_get(oSymTable,
+                                 psKeys->hits[psSchedule->getOrder[u]])
+                    != NULL);
+      }
+      adPhaseNs[OP_GET_HIT] += now() - dStart;
+      iCorrect = iCorrect && (uFound == psKeys->count);
+
+      uFound = 0;
+      dStart = now();
+      for (u = 0; u < psKeys->count; u++) {
+         uFound += (SymTable_get(oSymTable, psKeys->misses[u]) != NULL);
+      }
+      adPhaseNs[OP_GET_MISS] += now() - dStart;
+      iCorrect = iCorrect && (uFound == 0);
+
+#ifdef BENCH_FILTER
+      /* the gets of hits never reach the false-positive count */
+      if (uRound == 0) {
+         SymTable_getStats(oSymTable, &sStats);
+         dFalsePositiveRate = (double)sStats.filterFalsePositives
+            / (double)psKeys->count;
+      }
+#endif
+
+      /* each churn pass swaps every binding for one of another key,
+         so a table that leaves tombstones slows down pass by pass */
+      for (iPass = 0; iPass < CHURN_PASSES; iPass++) {
+         apcOut = (iPass % 2 == 0) ? psKeys->hits : psKeys->misses;
+         apcIn = (iPass % 2 == 0) ? psKeys->misses : psKeys->hits;
+         uFound = 0;
+         dStart = now();
+         for (u = 0; u < psKeys->count; u++) {
+            uFound += (SymTable_remove(
+                          oSymTable,
+                          apcOut[psSchedule->removeOrder[u]])
+                       != NULL);
+            uFound += (size_t)SymTable_put(
+               oSymTable, apcIn[psSchedule->removeOrder[u]],
+               apcIn[psSchedule->removeOrder[u]]);
+         }
+         dPassNs = now() - dStart;
+         if (iPass == 0) {
+            adPhaseNs[OP_CHURN_FIRST] += dPassNs;
+         }
+         else if (iPass == CHURN_PASSES - 1) {
+            adPhaseNs[OP_CHURN_LAST] += dPassNs;
+         }
+         iCorrect = iCorrect && (uFound == 2 * psKeys->count);
+      }
+
+      uFound = 0;
+      dStart = now();
+      for (u = 0; u < psKeys->count; u++) {
+         uFound += (SymTable_remove(
+                       oSymTable,
+                       psKeys->hits[psSchedule->removeOrder[u]])
+                    != NULL);
+      }
+      adPhaseNs[OP_REMOVE] += now() - dStart;
+      iCorrect = iCorrect && (uFound == psKeys->count)
+         && (SymTable_getLength(oSymTable) == 0);
+
+      SymTable_free(oSymTable);
+#ifdef BENCH_HUGE
+      SymTableHuge_free(oHuge);
+#endif
+   }
+
+   return iCorrect;
+}
+
+#else
+
+/*
+ * Runs uRounds rounds of put, get of every hit, get of every miss,
+ * churn, and remove of the numbers of psKeys in the order given by
+ * psSchedule, each on a new table, and adds the nanoseconds spent in
+ * each phase to adPhaseNs. Stores in *pdBytesPerBinding the memory
+ * the full table holds per binding. Returns 1 if every operation
+ * gave the expected result and 0 otherwise.
+ */
+static int runTrial(const struct KeySet *psKeys,
+                    const struct Schedule *psSchedule, size_t uRounds,
+                    double adPhaseNs[OP_COUNT],
+                    double *pdBytesPerBinding) {
+   SymTableU64_T oSymTable;
+   struct SymTableMemory sMemory;
+   const unsigned long *aulOut;
+   const unsigned long *aulIn;
+   size_t uRound;
+   size_t u;
+   size_t uFound;
+   double dStart;
+   double dPassNs;
+   int iPass;
+   int iCorrect = 1;
+
+   assert(psKeys != NULL);
+   assert(psSchedule != NULL);
+   assert(pdBytesPerBinding != NULL);
+
+   for (uRound = 0; uRound < uRounds; uRound++) {
+      oSymTable = SymTableU64_new();
+      if (oSymTable == NULL) {
+         return 0;
+      }
+
+      uFound = 0;
+      dStart = now();
+      for (u = 0; u < psKeys->count; u++) {
+         uFound += (size_t)SymTableU64_put(
+            oSymTable, psKeys->ids[psSchedule->putOrder[u]],
+            psKeys->hits[psSchedule->putOrder[u]]);
+      }
+      adPhaseNs[OP_PUT] += now() - dStart;
+      iCorrect = iCorrect && (uFound == psKeys->count);
+
+      if (uRound == 0) {
+         SymTableU64_memoryUsage(oSymTable, &sMemory);
+         *pdBytesPerBinding =
+            (double)sMemory.total / (double)psKeys->count;
+      }
+
+      uFound = 0;
+      dStart = now();
+      for (u = 0; u < psKeys->count; u++) {
+         uFound += (SymTableU64_get(
+                       oSymTable, psKeys->ids[psSchedule->getOrder[u]])
+                    != NULL);
+      }
+      adPhaseNs[OP_GET_HIT] += now() - dStart;
+      iCorrect = iCorrect && (uFound == psKeys->count);
+
+      uFound = 0;
+      dStart = now();
+      for (u = 0; u < psKeys->count; u++) {
+         uFound += (SymTableU64_get(oSymTable,
+                                    psKeys->ids[psKeys->count + u])
+                    != NULL);
+      }
+      adPhaseNs[OP_GET_MISS] += now() - dStart;
+      iCorrect = iCorrect && (uFound == 0);
+
+      for (iPass = 0; iPass < CHURN_PASSES; iPass++) {
+         aulOut = psKeys->ids + ((iPass % 2 == 0) ? 0 : psKeys->count);
+         aulIn = psKeys->ids + ((iPass % 2 == 0) ? psKeys->count : 0);
+         uFound = 0;
+         dStart = now();
+         for (u = 0; u < psKeys->count; u++) {
+            uFound += (SymTableU64_remove(
+                          oSymTable,
+                          aulOut[psSchedule->removeOrder[u]])
+                       != NULL);
+            uFound += (size_t)SymTableU64_put(
+               oSymTable, aulIn[psSchedule->removeOrder[u]],
+               psKeys->hits[psSchedule->removeOrder[u]]);
+         }
+         dPassNs = now() - dStart;
+         if (iPass == 0) {
+            adPhaseNs[OP_CHURN_FIRST] += dPassNs;
+         }
+         else if (iPass == CHURN_PASSES - 1) {
+            adPhaseNs[OP_CHURN_LAST] += dPassNs;
+         }
+         iCorrect = iCorrect && (uFound == 2 * psKeys->count);
+      }
+
+      uFound = 0;
+      dStart = now();
+      for (u = 0; u < psKeys->count; u++) {
+         uFound += (SymTableU64_remove(
+                       oSymTable,
+                       psKeys->ids[psSchedule->removeOrder[u]])
+                    != NULL);
+      }
+      adPhaseNs[OP_REMOVE] += now() - dStart;
+      iCorrect = iCorrect && (uFound == psKeys->count)
+         && (SymTableU64_getLength(oSymTable) == 0);
+
+      SymTableU64_free(oSymTable);
+   }
+
+   return iCorrect;
+}
+
+#endif
+
+/*
+ * Compares the doubles that pv1 and pv2 point to, for qsort.
+ */
+static int compareDoubles(const void *pv1, const void *pv2) {
+   double d1 = *(const double *) pv1;
+   double d2 = *(const double *) pv2;
+
+   return (d1 > d2) - (d1 < d2);
+}
+
+/*
+ * Returns the nearest-rank dPercent percentile of the uCount sorted
+ * values adValues.
+ */
+static double percentile(const double *adValues, size_t uCount,
+                         double dPercent) {
+   size_t uRank;
+
+   assert(adValues != NULL);
+   assert(uCount > 0);
+
+   uRank = (size_t)ceil(dPercent / 100.0 * (double)uCount);
+   if (uRank > 0) {
+      uRank--;
+   }
+   if (uRank >= uCount) {
+      uRank = uCount - 1;
+   }
+   return adValues[uRank];
+}
+
+/*
+ * Writes the result line for operation eOp of distribution eDist at
+ * size uSize, given the sorted per-trial ns/op values adNsPerOp and
+ * the memory per binding dBytesPerBinding.
+ */
+static void report(const struct Options *psOptions,
+                   enum Distribution eDist, size_t uSize,
+                   enum Operation eOp, const double *adNsPerOp,
+                   double dBytesPerBinding) {
+   size_t uTrials;
+
+   assert(psOptions != NULL);
+   assert(adNsPerOp != NULL);
+
+   uTrials = (size_t)psOptions->trials;
+   if (psOptions->json) {
+      printf("{\"backend\": \"%s\", \"distribution\": \"%s\", "
+             "\"size\": %lu, \"operation\": \"%s\", \"trials\": %lu, ",
+             psOptions->backend, apcDistNames[eDist],
+             (unsigned long)uSize, apcOpNames[eOp],
+             (unsigned long)uTrials);
+      printf("\"median_ns\": %.2f, \"p10_ns\": %.2f, \"p90_ns\": %.2f, "
+             "\"min_ns\": %.2f, \"max_ns\": %.2f, "
+             "\"bytes_per_binding\": %.1f}\n",
+             percentile(adNsPerOp, uTrials, 50.0),
+             percentile(adNsPerOp, uTrials, 10.0),
+             percentile(adNsPerOp, uTrials, 90.0),
+             adNsPerOp[0], adNsPerOp[uTrials - 1], dBytesPerBinding);
+   }
+   else {
+      printf("%s,%s,%lu,%s,%lu,%.2f,%.2f,%.2f,%.2f,%.2f,%.1f\n",
+             psOptions->backend, apcDistNames[eDist],
+             (unsigned long)uSize, apcOpNames[eOp],
+             (unsigned long)uTrials,
+             percentile(adNsPerOp, uTrials, 50.0),
+             percentile(adNsPerOp, uTrials, 10.0),
+             percentile(adNsPerOp, uTrials, 90.0),
+             adNsPerOp[0], adNsPerOp[uTrials - 1], dBytesPerBinding);
+   }
+   fflush(stdout);
+}
+
+/*
+ * Measures distribution eDist at size uSize and reports the results.
+ * Returns the seconds the timed trials took, or -1 if the case could
+ * not be run.
+ */
+static double benchCase(const struct Options *psOptions,
+                        enum Distribution eDist, size_t uSize) {
+   struct KeySet sKeys;
+   struct Schedule sSchedule;
+   double adPhaseNs[OP_COUNT];
+   double *adNsPerOp;
+   double dBytesPerBinding = 0.0;
+   size_t uRounds;
+   double dStart;
+   double dElapsed;
+   int iTrial;
+   int iCorrect = 1;
+   int e;
+
+   assert(psOptions != NULL);
+
+   if (!makeKeys(eDist, uSize, &sKeys)) {
+      fprintf(stderr, "%s %lu: insufficient memory\n",
+              apcDistNames[eDist], (unsigned long)uSize);
+      return -1.0;
+   }
+   if (!makeSchedule(eDist, uSize, &sSchedule)) {
+      freeKeys(&sKeys);
+      fprintf(stderr, "%s %lu: insufficient memory\n",
+              apcDistNames[eDist], (unsigned long)uSize);
+      return -1.0;
+   }
+   adNsPerOp = (double *) malloc(OP_COUNT * (size_t)psOptions->trials
+                                 * sizeof(double));
+   if (adNsPerOp == NULL) {
+      freeSchedule(&sSchedule);
+      freeKeys(&sKeys);
+      return -1.0;
+   }
+
+   /* small tables are rebuilt until each phase times enough ops */
+   uRounds = (MIN_OPS_PER_TRIAL + uSize - 1) / uSize;
+
+   for (iTrial = 0; iTrial < psOptions->warmups; iTrial++) {
+      for (e = 0; e < OP_COUNT; e++) {
+         adPhaseNs[e] = 0.0;
+      }
+      iCorrect = runTrial(&sKeys, &sSchedule, uRounds, adPhaseNs,
+                          &dBytesPerBinding) && iCorrect;
+   }
+
+   dStart = now();
+   for (iTrial = 0; iTrial < psOptions->trials; iTrial++) {
+      for (e = 0; e < OP_COUNT; e++) {
+         adPhaseNs[e] = 0.0;
+      }
+      iCorrect = runTrial(&sKeys, &sSchedule, uRounds, adPhaseNs,
+                          &dBytesPerBinding) && iCorrect;
+      for (e = 0; e < OP_COUNT; e++) {
+         adNsPerOp[e * psOptions->trials + iTrial] =
+            adPhaseNs[e] / (double)(uRounds * uSize);
+      }
+   }
+   dElapsed = (now() - dStart) / 1e9;
+
+   if (!iCorrect) {
+      fprintf(stderr, "%s %lu: wrong result from the table\n",
+              apcDistNames[eDist], (unsigned long)uSize);
+   }
+#ifdef BENCH_FILTER
+   /* on stderr, so the CSV compares column for column with
+      benchsymtablehash */
+   fprintf(stderr, "%s %lu: filter false-positive rate %.4f\n",
+           apcDistNames[eDist], (unsigned long)uSize,
+           dFalsePositiveRate);
+#endif
+#ifdef BENCH_HUGE
+   fprintf(stderr, "%s %lu: KB mapped with MAP_HUGETLB %lu, "
+           "advised %lu, plain %lu\n",
+           apcDistNames[eDist], (unsigned long)uSize,
+           (unsigned long)(sHugeStats.hugetlbBytes / 1024),
+           (unsigned long)(sHugeStats.advisedBytes / 1024),
+           (unsigned long)(sHugeStats.plainBytes / 1024));
+#endif
+#ifdef BENCH_CACHE
+   if (eDist == DIST_ZIPF
+       && !benchCache(eDist, &sKeys, &sSchedule, uRounds)) {
+      fprintf(stderr, "%s %lu: insufficient memory\n",
+              apcDistNames[eDist], (unsigned long)uSize);
+      iCorrect = 0;
+   }
+#endif
+   for (e = 0; e < OP_COUNT; e++) {
+      qsort(adNsPerOp + e * psOptions->trials,
+            (size_t)psOptions->trials, sizeof(double), compareDoubles);
+      report(psOptions, eDist, uSize, (enum Operation)e,
+             adNsPerOp + e * psOptions->trials, dBytesPerBinding);
+   }
+
+   free(adNsPerOp);
+   freeSchedule(&sSchedule);
+   freeKeys(&sKeys);
+   return iCorrect ? dElapsed : -1.0;
+}
+
+/*********************************************************************/
+
+/*
+ * Fills in psOptions from the command-line arguments argv[1] through
+ * argv[argc - 1]. Returns 1 if successful and 0 after writing a
+ * message to stderr.
+ */
+static int parseOptions(int argc, char *argv[],
+                        struct Options *psOptions) {
+   static const size_t auDefaultSizes[] = {
+      10, 100, 1000, 10000, 100000, 1000000
+   };
+   char *pcItem;
+   const char *pcSlash;
+   unsigned long ulSize;
+   int iArg;
+   int e;
+
+   assert(psOptions != NULL);
+
+   pcSlash = strrchr(argv[0], '/');
+   psOptions->backend = (pcSlash == NULL) ? argv[0] : pcSlash + 1;
+   psOptions->sizeCount = sizeof(auDefaultSizes) / sizeof(size_t);
+   memcpy(psOptions->sizes, auDefaultSizes, sizeof(auDefaultSizes));
+   for (e = 0; e < DIST_COUNT; e++) {
+      psOptions->distributions[e] = 1;
+   }
+   psOptions->trials = 7;
+   psOptions->warmups = 1;
+   psOptions->budget = 10.0;
+   psOptions->json = 0;
+
+   for (iArg = 1; iArg < argc; iArg++) {
+      if (strcmp(argv[iArg], "-j") == 0) {
+         psOptions->json = 1;
+         continue;
+      }
+      if (iArg + 1 >= argc) {
+         fprintf(stderr, "%s: missing value for %s\n", argv[0],
+                 argv[iArg]);
+         return 0;
+      }
+      if (strcmp(argv[iArg], "-s") == 0) {
+         psOptions->sizeCount = 0;
+         for (pcItem = strtok(argv[++iArg], ","); pcItem != NULL;
+              pcItem = strtok(NULL, ",")) {
+            if (sscanf(pcItem, "%lu", &ulSize) != 1 || ulSize == 0
+                || ulSize > MAX_TABLE_SIZE
+                || psOptions->sizeCount == 32) {
+               fprintf(stderr, "%s: bad size %s\n", argv[0], pcItem);
+               return 0;
+            }
+            psOptions->sizes[psOptions->sizeCount++] = (size_t)ulSize;
+         }
+      }
+      else if (strcmp(argv[iArg], "-d") == 0) {
+         for (e = 0; e < DIST_COUNT; e++) {
+            psOptions->distributions[e] = 0;
+         }
+         for (pcItem = strtok(argv[++iArg], ","); pcItem != NULL;
+              pcItem = strtok(NULL, ",")) {
+            for (e = 0; e < DIST_COUNT; e++) {
+               if (strcmp(pcItem, apcDistNames[e]) == 0) {
+                  psOptions->distributions[e] = 1;
+                  break;
+               }
+            }
+            if (e == DIST_COUNT) {
+               fprintf(stderr, "%s: unknown distribution %s\n",
+                       argv[0], pcItem);
+               return 0;
+            }
+         }
+      }
+      else if (strcmp(argv[iArg], "-t") == 0) {
+         if (sscanf(argv[++iArg], "%d", &psOptions->trials) != 1
+             || psOptions->trials < 1) {
+            fprintf(stderr, "%s: bad trial count\n", argv[0]);
+            return 0;
+         }
+      }
+      else if (strcmp(argv[iArg], "-w") == 0) {
+         if (sscanf(argv[++iArg], "%d", &psOptions->warmups) != 1
+             || psOptions->warmups < 0) {
+            fprintf(stderr, "%s: bad warm-up count\n", argv[0]);
+            return 0;
+         }
+      }
+      else if (strcmp(argv[iArg], "-b") == 0) {
+         if (sscanf(argv[++iArg], "%lf", &psOptions->budget) != 1) {
+            fprintf(stderr, "%s: bad budget\n", argv[0]);
+            return 0;
+         }
+      }
+      else {
+         fprintf(stderr,
+                 "Usage: %s [-s size,...] [-d distribution,...] "
+                 "[-t trials]\n"
+                 "       [-w warmups] [-b budgetseconds] [-j]\n"
+                 "Distributions: sequential random zipf long collide\n",
+                 argv[0]);
+         return 0;
+      }
+   }
+   return 1;
+}
+
+/*
+ * Measures the SymTable implementation that this program is linked
+ * with and writes one line per (distribution, size, operation) to
+ * stdout. Once a case of a distribution takes longer than the
+ * budget, its larger sizes are skipped. Returns 0 if every case ran
+ * correctly and EXIT_FAILURE otherwise.
+ */
+int main(int argc, char *argv[]) {
+   struct Options sOptions;
+   double dSeconds;
+   size_t u;
+   int e;
+   int iStatus = 0;
+
+   if (!parseOptions(argc, argv, &sOptions)) {
+      return EXIT_FAILURE;
+   }
+
+   if (!sOptions.json) {
+      printf("backend,distribution,size,operation,trials,"
+             "median_ns,p10_ns,p90_ns,min_ns,max_ns,"
+             "bytes_per_binding\n");
+   }
+
+   for (e = 0; e < DIST_COUNT; e++) {
+      if (!sOptions.distributions[e]) {
+         continue;
+      }
+      for (u = 0; u < sOptions.sizeCount; u++) {
+#ifdef BENCH_U64
+         /* numbers can neither be long nor collide in the string
+            hash */
+         if (e == DIST_LONG || e == DIST_COLLIDE) {
+            break;
+         }
+#endif
+         if (e == DIST_COLLIDE
+             && sOptions.sizes[u] > MAX_COLLIDING_KEYS) {
+            fprintf(stderr, "%s %lu: skipped, too costly to generate\n",
+                    apcDistNames[e], (unsigned long)sOptions.sizes[u]);
+            continue;
+         }
+         dSeconds = benchCase(&sOptions, (enum Distribution)e,
+                              sOptions.sizes[u]);
+         if (dSeconds < 0.0) {
+            iStatus = EXIT_FAILURE;
+            break;
+         }
+         if (dSeconds > sOptions.budget) {
+            fprintf(stderr, "%s: sizes above %lu skipped, "
+                    "over budget\n", apcDistNames[e],
+                    (unsigned long)sOptions.sizes[u]);
+            break;
+         }
+      }
+   }
+
+   return iStatus;
+}
@@ -0,0 +1,212 @@
+/*********************************************************************/
+/* gensymtable.c                                                     */
+/* COS 217 Assignment 3: A Symbol Table ADT                          */
+/* Date: 10/31/2023                                                  */
+/* Author: Hugh Peterson                                             */
+/* Description: Reads a list of key-value pairs and writes C source  */
+/*              for a constant symbol table indexed by a perfect     */
+/*              hash                                                 */
+/*********************************************************************/
+
+/*********************************************************************/
+
+#include <assert.h>
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "symtable.h"
+#include "symtablefrozen.h"
+
+/*********************************************************************/
+
+enum {MAX_LINE_LENGTH = 4096};
+
+/*********************************************************************/
+
+/*
+ * Frees the string value pvValue. pcKey and pvExtra are unused.
+ */
+static void freeValue(const char *pcKey, void *pvValue, void *pvExtra) {
+   assert(pcKey != NULL);
+
+   (void) pvExtra;
+   free(pvValue);
+}
+
+/*
+ * Returns 1 if pcName is a valid C identifier and 0 otherwise.
+ */
+static int isIdentifier(const char *pcName) {
+   size_t u;
+
+   assert(pcName != NULL);
+
+   if (!isalpha((unsigned char)pcName[0]) && pcName[0] != '_') {
+      return 0;
+   }
+   for (u = 1; pcName[u] != '\0'; u++) {
+      if (!isalnum((unsigned char)pcName[u]) && pcName[u] != '_') {
+         return 0;
+      }
+   }
+   return 1;
+}
+
+/*
+ * Writes a header declaring the functions generated for pcName to
+ * psFile.
+ */
+static void writeHeader(FILE *psFile, const char *pcName) {
+   size_t u;
+
+   assert(psFile != NULL);
+   assert(pcName != NULL);
+
+   fprintf(psFile, "/* Generated by gensymtable. Do not edit. */\n\n");
+   fprintf(psFile, "#ifndef ");
+   for (u = 0; pcName[u] != '\0'; u++) {
+      fputc(toupper((unsigned char)pcName[u]), psFile);
+   }
+   fprintf(psFile, "_INCLUDED\n#define ");
+   for (u = 0; pcName[u] != '\0'; u++) {
+      fputc(toupper((unsigned char)pcName[u]), psFile);
+   }
+   fprintf(psFile, "_INCLUDED\n\n#include <stddef.h>\n\n");
+
+   fprintf(psFile,
+           "/* Returns the number of bindings in the table. */\n"
+           "size_t %s_getLength(void);\n\n"
+           "/* Returns 1 if pcKey is present and 0 otherwise. */\n"
+           "int %s_contains(const char *pcKey);\n\n"
+           "/* If pcKey is present, returns its associated value.\n"
+           "   Returns NULL otherwise. */\n"
+           "void *%s_get(const char *pcKey);\n\n"
+           "#endif\n", pcName, pcName, pcName);
+}
+
+/*
+ * Reads lines of the form "key value" from psFile into oSymTable.
+ * The key ends at the first space or tab; the value is the rest of
+ * the line without surrounding white space. Blank lines and lines
+ * starting with '#' are skipped. Returns 1 if successful and 0 after
+ * writing an error message to stderr.
+ */
+static int readBindings(FILE *psFile, SymTable_T oSymTable) {
+   char acLine[MAX_LINE_LENGTH];
+   char *pcKey;
+   char *pcValue;
+   char *pcEnd;
+   char *pcCopy;
+   int iLineNum = 0;
+
+   assert(psFile != NULL);
+   assert(oSymTable != NULL);
+
+   while (fgets(acLine, MAX_LINE_LENGTH, psFile) != NULL) {
+      iLineNum++;
+      if (strchr(acLine, '\n') == NULL && !feof(psFile)) {
+         fprintf(stderr, "line %d: line too long\n", iLineNum);
+         return 0;
+      }
+
+      /* strip surrounding white space */
+      pcKey = acLine;
+      while (isspace((unsigned char)*pcKey)) {
+         pcKey++;
+      }
+      pcEnd = pcKey + strlen(pcKey);
+      while (pcEnd > pcKey && isspace((unsigned char)pcEnd[-1])) {
+         pcEnd--;
+      }
+      *pcEnd = '\0';
+      if (*pcKey == '\0' || *pcKey == '#') {
+         continue;
+      }
+
+      /* split key from value */
+      pcValue = pcKey + strcspn(pcKey, " \t");
+      if (*pcValue != '\0') {
+         *pcValue = '\0';
+         pcValue++;
+         pcValue += strspn(pcValue, " \t");
+      }
+
+      if (SymTable_contains(oSymTable, pcKey)) {
+         fprintf(stderr, "line %d: duplicate key \"%s\"\n", iLineNum,
+                 pcKey);
+         return 0;
+      }
+      pcCopy = (char *) malloc(strlen(pcValue) + 1);
+      if (pcCopy == NULL) {
+         fprintf(stderr, "insufficient memory\n");
+         return 0;
+      }
+      strcpy(pcCopy, pcValue);
+      if (!SymTable_put(oSymTable, pcKey, pcCopy)) {
+         free(pcCopy);
+         fprintf(stderr, "insufficient memory\n");
+         return 0;
+      }
+   }
+
+   return 1;
+}
+
+/*********************************************************************/
+
+/*
+ * Reads key-value pairs from stdin and writes to stdout C source
+ * code for a constant table named argv[argc - 1] holding them. With
+ * the option -h, writes the matching header instead. Returns 0 if
+ * successful and EXIT_FAILURE otherwise.
+ */
+int main(int argc, char *argv[]) {
+   SymTable_T oSymTable;
+   SymTableFrozen_T oFrozen;
+   const char *pcName;
+   int iSuccessful;
+
+   if (argc == 3 && strcmp(argv[1], "-h") == 0) {
+      if (!isIdentifier(argv[2])) {
+         fprintf(stderr, "%s: invalid name \"%s\"\n", argv[0], argv[2]);
+         return EXIT_FAILURE;
+      }
+      writeHeader(stdout, argv[2]);
+      return ferror(stdout) ? EXIT_FAILURE : 0;
+   }
+   if (argc != 2) {
+      fprintf(stderr, "Usage: %s [-h] name < bindings\n", argv[0]);
+      return EXIT_FAILURE;
+   }
+   pcName = argv[1];
+   if (!isIdentifier(pcName)) {
+      fprintf(stderr, "%s: invalid name \"%s\"\n", argv[0], pcName);
+      return EXIT_FAILURE;
+   }
+
+   oSymTable = SymTable_new();
+   if (oSymTable == NULL) {
+      fprintf(stderr, "%s: insufficient memory\n", argv[0]);
+      return EXIT_FAILURE;
+   }
+
+   iSuccessful = readBindings(stdin, oSymTable);
+   if (iSuccessful) {
+      oFrozen = SymTable_freeze(oSymTable);
+      if (oFrozen == NULL) {
+         fprintf(stderr, "%s: cannot build the table: insufficient "
+                 "memory, or no perfect hash separates the keys\n",
+                 argv[0]);
+         iSuccessful = 0;
+      }
+      else {
+         iSuccessful = SymTableFrozen_write(oFrozen, stdout, pcName);
+         SymTableFrozen_free(oFrozen);
+      }
+   }
+
+   SymTable_map(oSymTable, freeValue, NULL);
+   SymTable_free(oSymTable);
+   return iSuccessful ? 0 : EXIT_FAILURE;
+}
@@ -20,6 +20,54 @@
  */
 typedef struct SymTable *SymTable_T;
 
+/*
+ * The source of all the memory a SymTable_T uses: the table, its
+ * buckets, its binding nodes, and its key copies.
+ */
+struct SymTableAllocator {
+   /* returns uSize bytes, suitably aligned for any object, or NULL
+      if memory is insufficient; pvContext is the context pointer
+      the table was created with */
+   void *(*pfAlloc)(void *pvContext, size_t uSize);
+
+   /* releases pvMemory, which pfAlloc returned for a request of
+      uSize bytes; if NULL, memory is never released one allocation
+      at a time, and SymTable_free does nothing, so that the client
+      can release it all at once (by discarding a region, say) */
+   void (*pfFree)(void *pvContext, void *pvMemory, size_t uSize);
+
+   /* returns the bytes that a request of uSize bytes costs beyond
+      uSize, in headers and rounding, for SymTable_memoryUsage; if
+      NULL, such slack is counted as 0 */
+   size_t (*pfSlack)(void *pvContext, size_t uSize);
+};
+
+/*
+ * The bytes of memory that a SymTable_T holds, by what they hold.
+ * Every implementation fills in the same fields, so the numbers of
+ * different implementations can be compared.
+ */
+struct SymTableMemory {
+   /* the table structure itself */
+   size_t table;
+
+   /* the bucket array, or 0 if there is none */
+   size_t buckets;
+
+   /* the nodes that hold the bindings, excluding their keys */
+   size_t nodes;
+
+   /* the copies of the keys, including their terminating '\0's */
+   size_t keys;
+
+   /* estimated bytes the allocator spends beyond those requested, in
+      headers and rounding, for all of the above (see pfSlack) */
+   size_t slack;
+
+   /* the sum of all of the above */
+   size_t total;
+};
+
 /*********************************************************************/
 
 /*
@@ -27,6 +75,14 @@ typedef struct SymTable *SymTable_T;
  */
 SymTable_T SymTable_new(void);
 
+/*
+ * Construct a new SymTable_T that gets all of its memory from
+ * *psAllocator, passing pvContext to its functions. *psAllocator is
+ * copied. Return NULL if memory is insufficient.
+ */
+SymTable_T SymTable_newWithAllocator(
+     const struct SymTableAllocator *psAllocator, void *pvContext);
+
 /*
  * Frees all memory previously allocated for a SymTable_T. 
  * Takes a symbol table oSymTable.
@@ -77,12 +133,22 @@ void *SymTable_remove(SymTable_T oSymTable, const char *pcKey);
 /*
  * Applies (*pfApply) to all bindings in oSymTable, passing 
  * *pvExtra as a parameter. pfApply takes a key pcKey, a value 
- * pvValue, and an extra parameter pvExtra.
+ * pvValue, and an extra parameter pvExtra. pcKey is valid only until
+ * pfApply returns, since an implementation may spell it out in a
+ * buffer that it reuses; pfApply must copy it to keep it.
  */
 void SymTable_map(SymTable_T oSymTable,
      void (*pfApply)(const char *pcKey, void *pvValue, void *pvExtra),
      const void *pvExtra);
 
+/*
+ * Fills in *psMemory with the memory that oSymTable holds. Visits
+ * every binding, so takes time proportional to the number of
+ * bindings. The values are not counted; they belong to the client.
+ */
+void SymTable_memoryUsage(SymTable_T oSymTable,
+     struct SymTableMemory *psMemory);
+
 /*********************************************************************/
 
 #endif
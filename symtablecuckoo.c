@@ -0,0 +1,748 @@
+/*********************************************************************/
+/* symtablecuckoo.c                                                  */
+/* COS 217 Assignment 3: A Symbol Table ADT                          */
+/* Date: 10/31/2023                                                  */
+/* Author: Hugh Peterson                                             */
+/* Description: A symbol table module to associate string keys with  */
+/*              generic values (bucketized cuckoo hash table         */
+/*              implementation)                                      */
+/*********************************************************************/
+
+/*********************************************************************/
+
+#include <assert.h>
+#include <string.h>
+#include "symtable.h"
+#include "symtablemalloc.h"
+
+/*
+ * With -DSYMTABLE_LATENCY, put, get, remove, and map are compiled
+ * under other names and timed by symtablelatency.c.
+ */
+#ifdef SYMTABLE_LATENCY
+#include "symtablelatency.h"
+#define SymTable_put SymTable_untimedPut
+#define SymTable_get SymTable_untimedGet
+#define SymTable_remove SymTable_untimedRemove
+#define SymTable_map SymTable_untimedMap
+#endif
+
+/*********************************************************************/
+
+enum {
+   /* bindings per bucket */
+   BUCKET_SLOTS = 4,
+
+   /* number of buckets of a new table; always a power of two */
+   INITIAL_BUCKETS = 128,
+
+   /* the table doubles before more than MAX_LOAD_NUMERATOR /
+      MAX_LOAD_DENOMINATOR of its slots would be in use */
+   MAX_LOAD_NUMERATOR = 9,
+   MAX_LOAD_DENOMINATOR = 10,
+
+   /* longest chain of evictions an insertion follows before it puts
+      its homeless binding in the stash */
+   MAX_KICKS = 256,
+
+   /* tries at rehashing all bindings with new hash functions before
+      the table doubles instead */
+   MAX_RESEEDS = 4,
+
+   /* bytes of a cache line, which is the size and alignment of a
+      bucket */
+   CACHE_LINE_BYTES = 64
+};
+
+enum {
+   /* bytes of the tags and keys of a bucket, with the tags rounded up
+      to a whole key pointer */
+   BUCKET_USED_BYTES = ((BUCKET_SLOTS + sizeof(char *) - 1)
+                        / sizeof(char *) + BUCKET_SLOTS)
+                       * sizeof(char *)
+};
+
+/*********************************************************************/
+
+/*
+ * Holds the keys of up to BUCKET_SLOTS bindings in one cache line; the
+ * values live apart, so that a lookup reads them only on a match. A
+ * slot is empty if its key is NULL.
+ */
+struct Bucket {
+   /* eight bits of the hash of each key, compared before the key
+      itself, so that a lookup rarely follows a key pointer in
+      vain */
+   unsigned char tags[BUCKET_SLOTS];
+
+   /* the keys, which the table owns */
+   char *keys[BUCKET_SLOTS];
+
+   /* fills the bucket out to CACHE_LINE_BYTES */
+   char padding[CACHE_LINE_BYTES - BUCKET_USED_BYTES];
+};
+
+/*
+ * A bucketized cuckoo hash table. Each key may live in only two
+ * buckets, chosen by two hash functions, so a lookup examines at most
+ * 2 * BUCKET_SLOTS slots, plus the stash. An insertion into two full
+ * buckets evicts a binding to its other bucket, which may evict
+ * another, and so on; a binding still homeless after MAX_KICKS
+ * evictions goes to the stash. A full stash makes the table rehash.
+ */
+struct SymTable {
+   /* the memory block that holds the buckets and the values */
+   char *block;
+
+   /* the buckets, aligned to a cache line within block */
+   struct Bucket *buckets;
+
+   /* the values, BUCKET_SLOTS per bucket, in the order of the
+      buckets; they follow the buckets in block */
+   void **values;
+
+   /* number of buckets; always a power of two */
+   size_t bucketCount;
+
+   /* bindings that could not be placed in their buckets; empty
+      except after a rare failed insertion */
+   struct Bucket stash;
+
+   /* the values of the stash */
+   void *stashValues[BUCKET_SLOTS];
+
+   /* number of bindings in the stash */
+   size_t stashCount;
+
+   /* number of bindings */
+   size_t size;
+
+   /* seed of the hash functions, changed on each rehash */
+   size_t seed;
+
+   /* picks the slot an eviction takes, varying from one eviction
+      to the next so that evictions do not cycle */
+   size_t kickCursor;
+
+   /* the source of all memory of the table */
+   struct SymTableAllocator allocator;
+
+   /* the context pointer passed to the allocator */
+   void *context;
+};
+
+/*********************************************************************/
+
+/*
+ * Returns a well-mixed function of uHash (the MurmurHash3
+ * finalizer).
+ */
+static size_t SymTable_mix(size_t uHash) {
+   uHash ^= uHash >> 33;
+   uHash *= (size_t)0xff51afd7ed558ccdUL;
+   uHash ^= uHash >> 33;
+   uHash *= (size_t)0xc4ceb9fe1a85ec53UL;
+   uHash ^= uHash >> 33;
+   return uHash;
+}
+
+/*
+ * Returns the hash code of pcKey under seed uSeed. Both bucket
+ * indices and the tag of a key come from different bits of it. The
+ * hash is FNV-1a rather than the hash of symtablehash.c, because that
+ * hash is linear in the key's bytes, so keys that collide in it
+ * collide under every seed, and no rehash could separate them.
+ */
+static size_t SymTable_hash(const char *pcKey, size_t uSeed) {
+   size_t uHash = uSeed ^ (size_t)0xcbf29ce484222325UL;
+   size_t u;
+
+   assert(pcKey != NULL);
+
+   for (u = 0; pcKey[u] != '\0'; u++) {
+      uHash = (uHash ^ (unsigned char)pcKey[u])
+         * (size_t)0x100000001b3UL;
+   }
+   return SymTable_mix(uHash);
+}
+
+/*
+ * Returns the first bucket index, the second bucket index, and the
+ * tag of a key of hash code uHash in a table of uBucketCount
+ * buckets.
+ */
+static size_t SymTable_index1(size_t uHash, size_t uBucketCount) {
+   return uHash & (uBucketCount - 1);
+}
+
+static size_t SymTable_index2(size_t uHash, size_t uBucketCount) {
+   return ((uHash >> 16) >> 16) & (uBucketCount - 1);
+}
+
+static unsigned char SymTable_tag(size_t uHash) {
+   return (unsigned char)(uHash >> 24);
+}
+
+/*
+ * Returns uSize bytes from the allocator of oSymTable, or NULL if
+ * memory is insufficient.
+ */
+static void *SymTable_alloc(SymTable_T oSymTable, size_t uSize) {
+   assert(oSymTable != NULL);
+
+   return (*oSymTable->allocator.pfAlloc)(oSymTable->context, uSize);
+}
+
+/*
+ * Gives pvMemory, an allocation of uSize bytes, back to the allocator
+ * of oSymTable, if that allocator releases memory at all.
+ */
+static void SymTable_release(SymTable_T oSymTable, void *pvMemory,
+                             size_t uSize) {
+   assert(oSymTable != NULL);
+
+   if (oSymTable->allocator.pfFree != NULL) {
+      (*oSymTable->allocator.pfFree)(oSymTable->context, pvMemory,
+                                     uSize);
+   }
+}
+
+/*
+ * Returns the bytes that the allocator of oSymTable spends beyond a
+ * request of uBytes, or 0 if the allocator does not say.
+ */
+static size_t SymTable_allocSlack(SymTable_T oSymTable,
+                                  size_t uBytes) {
+   assert(oSymTable != NULL);
+
+   if (oSymTable->allocator.pfSlack == NULL) {
+      return 0;
+   }
+   return (*oSymTable->allocator.pfSlack)(oSymTable->context, uBytes);
+}
+
+/*
+ * Returns the bytes of the block that holds uBucketCount buckets and
+ * their values, with room to align the buckets to a cache line.
+ */
+static size_t SymTable_blockBytes(size_t uBucketCount) {
+   return uBucketCount
+      * (sizeof(struct Bucket) + BUCKET_SLOTS * sizeof(void *))
+      + CACHE_LINE_BYTES - 1;
+}
+
+/*
+ * Gives oSymTable a new block of uBucketCount empty buckets, without
+ * releasing the old one. Returns 1 if successful and 0 if memory is
+ * insufficient, in which case oSymTable is unchanged.
+ */
+static int SymTable_newBlock(SymTable_T oSymTable,
+                             size_t uBucketCount) {
+   char *pcBlock;
+   size_t uBytes;
+   size_t uOffset;
+
+   assert(oSymTable != NULL);
+
+   uBytes = SymTable_blockBytes(uBucketCount);
+   pcBlock = (char *) SymTable_alloc(oSymTable, uBytes);
+   if (pcBlock == NULL) {
+      return 0;
+   }
+   memset(pcBlock, 0, uBytes);
+
+   uOffset = (CACHE_LINE_BYTES - (size_t)pcBlock % CACHE_LINE_BYTES)
+      % CACHE_LINE_BYTES;
+   oSymTable->block = pcBlock;
+   oSymTable->buckets = (struct Bucket *)(pcBlock + uOffset);
+   oSymTable->values = (void **)(oSymTable->buckets + uBucketCount);
+   oSymTable->bucketCount = uBucketCount;
+   return 1;
+}
+
+/*
+ * Returns the address of the value in slot iSlot of psBucket, which
+ * is a bucket of oSymTable or its stash.
+ */
+static void **SymTable_value(SymTable_T oSymTable,
+                             const struct Bucket *psBucket,
+                             int iSlot) {
+   assert(oSymTable != NULL);
+   assert(psBucket != NULL);
+
+   if (psBucket == &oSymTable->stash) {
+      return &oSymTable->stashValues[iSlot];
+   }
+   return &oSymTable->values[
+      (size_t)(psBucket - oSymTable->buckets) * BUCKET_SLOTS
+      + (size_t)iSlot];
+}
+
+/*
+ * Stores the binding of pcKey, whose tag is ucTag, to pvValue in an
+ * empty slot of psBucket, a bucket of oSymTable or its stash. Returns
+ * 1 if successful and 0 if psBucket is full.
+ */
+static int SymTable_fill(SymTable_T oSymTable, struct Bucket *psBucket,
+                         char *pcKey, unsigned char ucTag,
+                         void *pvValue) {
+   int i;
+
+   assert(oSymTable != NULL);
+   assert(psBucket != NULL);
+   assert(pcKey != NULL);
+
+   for (i = 0; i < BUCKET_SLOTS; i++) {
+      if (psBucket->keys[i] == NULL) {
+         psBucket->tags[i] = ucTag;
+         psBucket->keys[i] = pcKey;
+         *SymTable_value(oSymTable, psBucket, i) = pvValue;
+         return 1;
+      }
+   }
+   return 0;
+}
+
+/*
+ * Returns the bucket of oSymTable (one of its two buckets or the
+ * stash) that holds pcKey and stores the slot in *piSlot, or returns
+ * NULL if pcKey is absent.
+ */
+static struct Bucket *SymTable_find(SymTable_T oSymTable,
+                                    const char *pcKey, int *piSlot) {
+   struct Bucket *apsBuckets[2];
+   size_t uHash;
+   unsigned char ucTag;
+   int b;
+   int i;
+
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+   assert(piSlot != NULL);
+
+   uHash = SymTable_hash(pcKey, oSymTable->seed);
+   ucTag = SymTable_tag(uHash);
+   apsBuckets[0] = &oSymTable->buckets[
+      SymTable_index1(uHash, oSymTable->bucketCount)];
+   apsBuckets[1] = &oSymTable->buckets[
+      SymTable_index2(uHash, oSymTable->bucketCount)];
+
+   for (b = 0; b < 2; b++) {
+      for (i = 0; i < BUCKET_SLOTS; i++) {
+         if (apsBuckets[b]->keys[i] != NULL
+             && apsBuckets[b]->tags[i] == ucTag
+             && strcmp(apsBuckets[b]->keys[i], pcKey) == 0) {
+            *piSlot = i;
+            return apsBuckets[b];
+         }
+      }
+   }
+
+   if (oSymTable->stashCount > 0) {
+      for (i = 0; i < BUCKET_SLOTS; i++) {
+         if (oSymTable->stash.keys[i] != NULL
+             && strcmp(oSymTable->stash.keys[i], pcKey) == 0) {
+            *piSlot = i;
+            return &oSymTable->stash;
+         }
+      }
+   }
+   return NULL;
+}
+
+/*
+ * Places the binding of pcKey to pvValue in oSymTable, evicting other
+ * bindings to their other buckets as needed, and in the stash if the
+ * chain of evictions grows too long. Does not change the size.
+ * Returns 1 if successful and 0 if the stash is full, in which case
+ * some binding (not necessarily this one) was dropped: callers
+ * either make sure the stash has room or discard the table.
+ */
+static int SymTable_place(SymTable_T oSymTable, char *pcKey,
+                          void *pvValue) {
+   struct Bucket *psBucket;
+   size_t uHash;
+   size_t uIndex;
+   size_t uIndex1;
+   unsigned char ucTag;
+   char *pcVictimKey;
+   void *pvVictimValue;
+   int iKick;
+   int i;
+
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   uHash = SymTable_hash(pcKey, oSymTable->seed);
+   ucTag = SymTable_tag(uHash);
+   uIndex = SymTable_index1(uHash, oSymTable->bucketCount);
+   if (SymTable_fill(oSymTable, &oSymTable->buckets[uIndex], pcKey,
+                     ucTag, pvValue)) {
+      return 1;
+   }
+   uIndex = SymTable_index2(uHash, oSymTable->bucketCount);
+   if (SymTable_fill(oSymTable, &oSymTable->buckets[uIndex], pcKey,
+                     ucTag, pvValue)) {
+      return 1;
+   }
+
+   for (iKick = 0; iKick < MAX_KICKS; iKick++) {
+      /* take the place of a binding of the full bucket */
+      psBucket = &oSymTable->buckets[uIndex];
+      i = (int)(oSymTable->kickCursor++ % BUCKET_SLOTS);
+      pcVictimKey = psBucket->keys[i];
+      pvVictimValue = *SymTable_value(oSymTable, psBucket, i);
+      psBucket->tags[i] = ucTag;
+      psBucket->keys[i] = pcKey;
+      *SymTable_value(oSymTable, psBucket, i) = pvValue;
+
+      /* and move that binding to its other bucket */
+      pcKey = pcVictimKey;
+      pvValue = pvVictimValue;
+      uHash = SymTable_hash(pcKey, oSymTable->seed);
+      ucTag = SymTable_tag(uHash);
+      uIndex1 = SymTable_index1(uHash, oSymTable->bucketCount);
+      uIndex = (uIndex == uIndex1)
+         ? SymTable_index2(uHash, oSymTable->bucketCount) : uIndex1;
+      if (SymTable_fill(oSymTable, &oSymTable->buckets[uIndex],
+                        pcKey, ucTag, pvValue)) {
+         return 1;
+      }
+   }
+
+   if (!SymTable_fill(oSymTable, &oSymTable->stash, pcKey, ucTag,
+                      pvValue)) {
+      return 0;
+   }
+   oSymTable->stashCount++;
+   return 1;
+}
+
+/*
+ * Moves every binding of oSymTable into a new bucket array of
+ * uBucketCount buckets, with new hash functions. If the bindings do
+ * not all fit with room to spare in the stash, tries other hash
+ * functions, and then twice as many buckets. Returns 1 if successful
+ * and 0 if memory is insufficient, in which case oSymTable is
+ * unchanged.
+ */
+static int SymTable_rehash(SymTable_T oSymTable, size_t uBucketCount) {
+   struct SymTable sNew;
+   struct Bucket *psBucket;
+   size_t u;
+   int iReseeds = 0;
+   int iPlaced;
+   int i;
+
+   assert(oSymTable != NULL);
+
+   for (;;) {
+      sNew = *oSymTable;
+      if (!SymTable_newBlock(&sNew, uBucketCount)) {
+         return 0;
+      }
+      memset(&sNew.stash, 0, sizeof(struct Bucket));
+      sNew.stashCount = 0;
+      sNew.seed = SymTable_mix(oSymTable->seed + (size_t)iReseeds + 1);
+
+      iPlaced = 1;
+      for (u = 0; u <= oSymTable->bucketCount && iPlaced; u++) {
+         /* the stash comes last */
+         psBucket = (u < oSymTable->bucketCount)
+            ? &oSymTable->buckets[u] : &oSymTable->stash;
+         for (i = 0; i < BUCKET_SLOTS && iPlaced; i++) {
+            if (psBucket->keys[i] != NULL) {
+               iPlaced = SymTable_place(&sNew, psBucket->keys[i],
+                  *SymTable_value(oSymTable, psBucket, i));
+            }
+         }
+      }
+
+      /* a full stash would leave the next insertion nowhere to go */
+      if (iPlaced && sNew.stashCount < BUCKET_SLOTS) {
+         SymTable_release(oSymTable, oSymTable->block,
+            SymTable_blockBytes(oSymTable->bucketCount));
+         *oSymTable = sNew;
+         return 1;
+      }
+
+      /* the new array only borrowed the keys */
+      SymTable_release(oSymTable, sNew.block,
+                       SymTable_blockBytes(uBucketCount));
+      if (++iReseeds >= MAX_RESEEDS) {
+         iReseeds = 0;
+         uBucketCount *= 2;
+      }
+   }
+}
+
+/*********************************************************************/
+
+/*
+ * Construct a new SymTable_T. Return NULL if memory is insufficient.
+ */
+SymTable_T SymTable_new(void) {
+   struct SymTableAllocator sMalloc;
+
+   SymTableMalloc_getAllocator(&sMalloc);
+   return SymTable_newWithAllocator(&sMalloc, NULL);
+}
+
+/*
+ * Construct a new SymTable_T that gets its memory from *psAllocator.
+ * Return NULL if memory is insufficient.
+ */
+SymTable_T SymTable_newWithAllocator(
+     const struct SymTableAllocator *psAllocator, void *pvContext) {
+   SymTable_T oSymTable;
+
+   assert(psAllocator != NULL);
+   assert(psAllocator->pfAlloc != NULL);
+   assert(sizeof(struct Bucket) == CACHE_LINE_BYTES);
+
+   oSymTable = (SymTable_T)
+      (*psAllocator->pfAlloc)(pvContext, sizeof(struct SymTable));
+   if (oSymTable == NULL) {
+      return NULL;
+   }
+   memset(oSymTable, 0, sizeof(struct SymTable));
+   oSymTable->allocator = *psAllocator;
+   oSymTable->context = pvContext;
+
+   if (!SymTable_newBlock(oSymTable, INITIAL_BUCKETS)) {
+      SymTable_release(oSymTable, oSymTable, sizeof(struct SymTable));
+      return NULL;
+   }
+   return oSymTable;
+}
+
+/*
+ * Frees all memory previously allocated for a SymTable_T
+ */
+void SymTable_free(SymTable_T oSymTable) {
+   struct Bucket *psBucket;
+   size_t u;
+   int i;
+
+   assert(oSymTable != NULL);
+
+   /* the client releases the memory of such a table all at once */
+   if (oSymTable->allocator.pfFree == NULL) {
+      return;
+   }
+
+   for (u = 0; u <= oSymTable->bucketCount; u++) {
+      psBucket = (u < oSymTable->bucketCount)
+         ? &oSymTable->buckets[u] : &oSymTable->stash;
+      for (i = 0; i < BUCKET_SLOTS; i++) {
+         if (psBucket->keys[i] != NULL) {
+            SymTable_release(oSymTable, psBucket->keys[i],
+                             strlen(psBucket->keys[i]) + 1);
+         }
+      }
+   }
+   SymTable_release(oSymTable, oSymTable->block,
+                    SymTable_blockBytes(oSymTable->bucketCount));
+   SymTable_release(oSymTable, oSymTable, sizeof(struct SymTable));
+}
+
+/*
+ * Returns a size_t specifying the number of bindings contained within
+ * the specified SymTable_T.
+ */
+size_t SymTable_getLength(SymTable_T oSymTable) {
+   assert(oSymTable != NULL);
+
+   return oSymTable->size;
+}
+
+/*
+ * Tries to insert a new key-value binding with a String key and
+ * generic value into the specified SymTable_T. Returns 1 if successful
+ * and 0 if binding is already present or memory is insufficient.
+ */
+int SymTable_put(SymTable_T oSymTable,
+                 const char *pcKey, const void *pvValue) {
+   char *pcKeyCopy;
+   size_t uKeyBytes;
+   int iSlot;
+
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   if (SymTable_find(oSymTable, pcKey, &iSlot) != NULL) {
+      return 0;
+   }
+
+   /* a full stash must be emptied, since the insertion may need it */
+   if ((oSymTable->size + 1) * MAX_LOAD_DENOMINATOR
+       > oSymTable->bucketCount * BUCKET_SLOTS * MAX_LOAD_NUMERATOR
+       || oSymTable->stashCount == BUCKET_SLOTS) {
+      if (!SymTable_rehash(oSymTable, 2 * oSymTable->bucketCount)
+          && oSymTable->stashCount == BUCKET_SLOTS) {
+         return 0;
+      }
+   }
+
+   uKeyBytes = strlen(pcKey) + 1;
+   pcKeyCopy = (char *) SymTable_alloc(oSymTable, uKeyBytes);
+   if (pcKeyCopy == NULL) {
+      return 0;
+   }
+   memcpy(pcKeyCopy, pcKey, uKeyBytes);
+
+   SymTable_place(oSymTable, pcKeyCopy, (void *) pvValue);
+   oSymTable->size++;
+   return 1;
+}
+
+/*
+ * If pcKey is present in oSymTable, its value is changed to pvValue
+ * and the old value is returned. Otherwise, NULL is returned.
+ */
+void *SymTable_replace(SymTable_T oSymTable,
+     const char *pcKey, const void *pvValue) {
+   struct Bucket *psBucket;
+   void *pvOldValue;
+   int iSlot;
+
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   psBucket = SymTable_find(oSymTable, pcKey, &iSlot);
+   if (psBucket == NULL) {
+      return NULL;
+   }
+   pvOldValue = *SymTable_value(oSymTable, psBucket, iSlot);
+   *SymTable_value(oSymTable, psBucket, iSlot) = (void *) pvValue;
+   return pvOldValue;
+}
+
+/*
+ * Returns 1 if pcKey is present in oSymTable and 0 otherwise.
+ */
+int SymTable_contains(SymTable_T oSymTable, const char *pcKey) {
+   int iSlot;
+
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   return SymTable_find(oSymTable, pcKey, &iSlot) != NULL;
+}
+
+/*
+ * If pcKey is present in oSymTable, returns its associated value.
+ * Returns NULL otherwise.
+ */
+void *SymTable_get(SymTable_T oSymTable, const char *pcKey) {
+   struct Bucket *psBucket;
+   int iSlot;
+
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   psBucket = SymTable_find(oSymTable, pcKey, &iSlot);
+   if (psBucket == NULL) {
+      return NULL;
+   }
+   return *SymTable_value(oSymTable, psBucket, iSlot);
+}
+
+/*
+ * If pcKey is present in oSymTable, removes its binding and returns
+ * the associated value. Returns NULL otherwise.
+ */
+void *SymTable_remove(SymTable_T oSymTable, const char *pcKey) {
+   struct Bucket *psBucket;
+   void *pvOldValue;
+   int iSlot;
+
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   psBucket = SymTable_find(oSymTable, pcKey, &iSlot);
+   if (psBucket == NULL) {
+      return NULL;
+   }
+   pvOldValue = *SymTable_value(oSymTable, psBucket, iSlot);
+   SymTable_release(oSymTable, psBucket->keys[iSlot],
+                    strlen(psBucket->keys[iSlot]) + 1);
+   psBucket->keys[iSlot] = NULL;
+   if (psBucket == &oSymTable->stash) {
+      oSymTable->stashCount--;
+   }
+   oSymTable->size--;
+   return pvOldValue;
+}
+
+/*
+ * Applies (*pfApply) to all bindings in the symbol table, passing
+ * *pvExtra as a parameter.
+ */
+void SymTable_map(SymTable_T oSymTable,
+     void (*pfApply)(const char *pcKey, void *pvValue, void *pvExtra),
+                  const void *pvExtra) {
+   struct Bucket *psBucket;
+   size_t u;
+   int i;
+
+   assert(oSymTable != NULL);
+   assert(pfApply != NULL);
+
+   for (u = 0; u <= oSymTable->bucketCount; u++) {
+      psBucket = (u < oSymTable->bucketCount)
+         ? &oSymTable->buckets[u] : &oSymTable->stash;
+      for (i = 0; i < BUCKET_SLOTS; i++) {
+         if (psBucket->keys[i] != NULL) {
+            (*pfApply)(psBucket->keys[i],
+                       *SymTable_value(oSymTable, psBucket, i),
+                       (void *) pvExtra);
+         }
+      }
+   }
+}
+
+/*
+ * Fills in *psMemory with the memory that oSymTable holds. The slots
+ * of the block that hold bindings, each with its value, are reported
+ * as nodes, and the rest of the block as buckets; the stash is part
+ * of the table.
+ */
+void SymTable_memoryUsage(SymTable_T oSymTable,
+                          struct SymTableMemory *psMemory) {
+   const size_t SLOT_BYTES =
+      sizeof(struct Bucket) / BUCKET_SLOTS + sizeof(void *);
+
+   struct Bucket *psBucket;
+   size_t uArrayBytes;
+   size_t uKeyBytes;
+   size_t u;
+   int i;
+
+   assert(oSymTable != NULL);
+   assert(psMemory != NULL);
+
+   uArrayBytes = SymTable_blockBytes(oSymTable->bucketCount);
+   psMemory->table = sizeof(struct SymTable);
+   psMemory->nodes =
+      (oSymTable->size - oSymTable->stashCount) * SLOT_BYTES;
+   psMemory->buckets = uArrayBytes - psMemory->nodes;
+   psMemory->keys = 0;
+   psMemory->slack = SymTable_allocSlack(oSymTable, psMemory->table)
+      + SymTable_allocSlack(oSymTable, uArrayBytes);
+
+   for (u = 0; u <= oSymTable->bucketCount; u++) {
+      psBucket = (u < oSymTable->bucketCount)
+         ? &oSymTable->buckets[u] : &oSymTable->stash;
+      for (i = 0; i < BUCKET_SLOTS; i++) {
+         if (psBucket->keys[i] != NULL) {
+            uKeyBytes = strlen(psBucket->keys[i]) + 1;
+            psMemory->keys += uKeyBytes;
+            psMemory->slack +=
+               SymTable_allocSlack(oSymTable, uKeyBytes);
+         }
+      }
+   }
+   psMemory->total = psMemory->table + psMemory->buckets
+      + psMemory->nodes + psMemory->keys + psMemory->slack;
+}
@@ -0,0 +1,699 @@
+/*********************************************************************/
+/* symtablefrozen.c                                                  */
+/* COS 217 Assignment 3: A Symbol Table ADT                          */
+/* Date: 10/31/2023                                                  */
+/* Author: Hugh Peterson                                             */
+/* Description: An immutable symbol table built once from a         */
+/*              SymTable_T and indexed by a minimal perfect hash     */
+/*              (hash-and-displace with one pilot per bucket)        */
+/*********************************************************************/
+
+/*********************************************************************/
+
+#include <assert.h>
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "symtablefrozen.h"
+
+/*********************************************************************/
+
+enum {
+   /* average number of keys per pilot bucket */
+   KEYS_PER_BUCKET = 4,
+
+   /* number of seeds to try before giving up on a key set */
+   MAX_SEEDS = 32
+};
+
+/*********************************************************************/
+
+/*
+ * Stores a key-value pair in its perfect-hash position.
+ */
+struct FrozenSlot {
+   /* key, pointing into the table's contiguous key storage */
+   const char *key;
+
+   /* value */
+   void *val;
+};
+
+/*
+ * Structure storing the slots, one pilot per bucket, and the key
+ * storage of a frozen symbol table.
+ */
+struct SymTableFrozen {
+   /* array of size slots, one per binding */
+   struct FrozenSlot *slots;
+
+   /* array of bucketCount pilots selecting each bucket's positions */
+   size_t *pilots;
+
+   /* all keys, NUL-terminated and stored back to back */
+   char *keys;
+
+   /* number of bindings (and slots) */
+   size_t size;
+
+   /* number of pilot buckets */
+   size_t bucketCount;
+
+   /* seed of the key hash that the pilots were found for */
+   size_t seed;
+};
+
+/*
+ * Scratch state used while building a SymTableFrozen_T.
+ */
+struct FrozenBuild {
+   /* keys of the source table, copied into the key storage of the
+      table being built */
+   const char **keys;
+
+   /* values of the source table */
+   void **vals;
+
+   /* seeded hash of each key */
+   size_t *hashes;
+
+   /* number of keys collected so far */
+   size_t count;
+
+   /* total bytes needed to store every key with its NUL */
+   size_t keyBytes;
+
+   /* next free byte of the key storage of the table being built */
+   char *nextKey;
+};
+
+/*********************************************************************/
+
+/*
+ * Returns a well-mixed version of uValue (the MurmurHash3 finalizer).
+ */
+static size_t SymTableFrozen_mix(size_t uValue) {
+   uValue ^= uValue >> 33;
+   uValue *= (size_t)0xff51afd7ed558ccdUL;
+   uValue ^= uValue >> 33;
+   uValue *= (size_t)0xc4ceb9fe1a85ec53UL;
+   uValue ^= uValue >> 33;
+   return uValue;
+}
+
+/*
+ * Return a hash code for pcKey under the seed uSeed.
+ */
+static size_t SymTableFrozen_hash(const char *pcKey, size_t uSeed) {
+   const size_t HASH_MULTIPLIER = (size_t)0x100000001b3UL;
+
+   size_t u;
+   size_t uHash = uSeed ^ (size_t)0xcbf29ce484222325UL;
+
+   assert(pcKey != NULL);
+
+   for (u = 0; pcKey[u] != '\0'; u++) {
+      uHash = (uHash ^ (size_t)(unsigned char)pcKey[u])
+         * HASH_MULTIPLIER;
+   }
+
+   return SymTableFrozen_mix(uHash);
+}
+
+/*
+ * Returns the pilot bucket of a key whose hash is uHash.
+ */
+static size_t SymTableFrozen_bucket(size_t uHash,
+                                    size_t uBucketCount) {
+   return (uHash >> (sizeof(size_t) * 4)) % uBucketCount;
+}
+
+/*
+ * Returns the slot of a key whose hash is uHash when its bucket uses
+ * the pilot uPilot.
+ */
+static size_t SymTableFrozen_position(size_t uHash, size_t uPilot,
+                                      size_t uSize) {
+   return SymTableFrozen_mix(uHash ^ SymTableFrozen_mix(uPilot + 1))
+      % uSize;
+}
+
+/*
+ * Adds the bytes that pcKey needs to the key storage size of the
+ * FrozenBuild pvExtra.
+ */
+static void SymTableFrozen_measure(const char *pcKey, void *pvValue,
+                                   void *pvExtra) {
+   struct FrozenBuild *psBuild = (struct FrozenBuild *) pvExtra;
+
+   assert(pcKey != NULL);
+   assert(psBuild != NULL);
+   (void) pvValue;
+
+   psBuild->keyBytes += strlen(pcKey) + 1;
+}
+
+/*
+ * Records the binding (pcKey, pvValue) in the FrozenBuild pvExtra,
+ * copying pcKey into its key storage, since pcKey need not outlive
+ * the call (see SymTable_map).
+ */
+static void SymTableFrozen_collect(const char *pcKey, void *pvValue,
+                                   void *pvExtra) {
+   struct FrozenBuild *psBuild = (struct FrozenBuild *) pvExtra;
+   size_t uBytes;
+
+   assert(pcKey != NULL);
+   assert(psBuild != NULL);
+   assert(psBuild->nextKey != NULL);
+
+   uBytes = strlen(pcKey) + 1;
+   memcpy(psBuild->nextKey, pcKey, uBytes);
+   psBuild->keys[psBuild->count] = psBuild->nextKey;
+   psBuild->vals[psBuild->count] = pvValue;
+   psBuild->nextKey += uBytes;
+   psBuild->count++;
+}
+
+/*
+ * Sorts the key indices of psBuild by bucket into auOrder, so that
+ * the keys of bucket u are auOrder[auBucketStart[u]] through
+ * auOrder[auBucketStart[u + 1] - 1]. auCursor is scratch space with
+ * one entry per bucket. Returns the size of the largest bucket.
+ */
+static size_t SymTableFrozen_group(SymTableFrozen_T oFrozen,
+                                   const struct FrozenBuild *psBuild,
+                                   size_t *auBucketStart,
+                                   size_t *auOrder, size_t *auCursor) {
+   size_t uMaxBucketSize = 0;
+   size_t uBucket;
+   size_t u;
+
+   assert(oFrozen != NULL);
+   assert(psBuild != NULL);
+
+   memset(auBucketStart, 0,
+          (oFrozen->bucketCount + 1) * sizeof(size_t));
+   for (u = 0; u < oFrozen->size; u++) {
+      uBucket = SymTableFrozen_bucket(psBuild->hashes[u],
+                                      oFrozen->bucketCount);
+      auBucketStart[uBucket + 1]++;
+   }
+   for (u = 0; u < oFrozen->bucketCount; u++) {
+      if (auBucketStart[u + 1] > uMaxBucketSize) {
+         uMaxBucketSize = auBucketStart[u + 1];
+      }
+      auBucketStart[u + 1] += auBucketStart[u];
+      auCursor[u] = auBucketStart[u];
+   }
+   for (u = 0; u < oFrozen->size; u++) {
+      uBucket = SymTableFrozen_bucket(psBuild->hashes[u],
+                                      oFrozen->bucketCount);
+      auOrder[auCursor[uBucket]++] = u;
+   }
+
+   return uMaxBucketSize;
+}
+
+/*
+ * Searches for a pilot that sends the uCount keys of psBuild listed
+ * in auKeys to distinct slots not yet marked in acTaken. On success,
+ * stores the pilot for uBucket, fills in the slots, and returns 1.
+ * Returns 0 if no pilot works. auPositions is scratch space with
+ * uCount entries.
+ */
+static int SymTableFrozen_place(SymTableFrozen_T oFrozen,
+                                const struct FrozenBuild *psBuild,
+                                size_t uBucket, const size_t *auKeys,
+                                size_t uCount, char *acTaken,
+                                size_t *auPositions) {
+   size_t uMaxPilot = 16 * oFrozen->size + 4096;
+   size_t uPilot;
+   size_t u;
+   size_t v;
+
+   assert(oFrozen != NULL);
+   assert(psBuild != NULL);
+
+   /* identical hashes can never be separated by a pilot */
+   for (u = 0; u < uCount; u++) {
+      for (v = u + 1; v < uCount; v++) {
+         if (psBuild->hashes[auKeys[u]]
+             == psBuild->hashes[auKeys[v]]) {
+            return 0;
+         }
+      }
+   }
+
+   for (uPilot = 0; uPilot < uMaxPilot; uPilot++) {
+      for (u = 0; u < uCount; u++) {
+         auPositions[u] = SymTableFrozen_position(
+            psBuild->hashes[auKeys[u]], uPilot, oFrozen->size);
+         if (acTaken[auPositions[u]]) {
+            break;
+         }
+         for (v = 0; v < u; v++) {
+            if (auPositions[v] == auPositions[u]) {
+               break;
+            }
+         }
+         if (v < u) {
+            break;
+         }
+      }
+      if (u == uCount) {
+         break;
+      }
+   }
+   if (uPilot == uMaxPilot) {
+      return 0;
+   }
+
+   /* claim the slots */
+   oFrozen->pilots[uBucket] = uPilot;
+   for (u = 0; u < uCount; u++) {
+      acTaken[auPositions[u]] = 1;
+      oFrozen->slots[auPositions[u]].key = psBuild->keys[auKeys[u]];
+      oFrozen->slots[auPositions[u]].val = psBuild->vals[auKeys[u]];
+   }
+   return 1;
+}
+
+/*
+ * Tries to find a pilot for every bucket of oFrozen so that the keys
+ * of psBuild land in distinct slots under oFrozen->seed, largest
+ * buckets first. Returns 1 on success and 0 if this seed does not
+ * work or memory is insufficient.
+ */
+static int SymTableFrozen_search(SymTableFrozen_T oFrozen,
+                                 struct FrozenBuild *psBuild) {
+   size_t *auBucketStart;
+   size_t *auOrder;
+   size_t *auBySize;
+   size_t *auPositions;
+   char *acTaken;
+   size_t uMaxBucketSize;
+   size_t uBucket;
+   size_t u;
+   size_t v;
+   int iSuccessful = 1;
+
+   assert(oFrozen != NULL);
+   assert(psBuild != NULL);
+
+   auBucketStart = (size_t *) malloc((oFrozen->bucketCount + 1)
+                                     * sizeof(size_t));
+   auOrder = (size_t *) malloc(oFrozen->size * sizeof(size_t));
+   auBySize = (size_t *) malloc(oFrozen->bucketCount * sizeof(size_t));
+   auPositions = (size_t *) malloc(oFrozen->size * sizeof(size_t));
+   acTaken = (char *) calloc(oFrozen->size, sizeof(char));
+   if (auBucketStart == NULL || auOrder == NULL || auBySize == NULL
+       || auPositions == NULL || acTaken == NULL) {
+      iSuccessful = 0;
+   }
+
+   if (iSuccessful) {
+      for (u = 0; u < oFrozen->size; u++) {
+         psBuild->hashes[u] = SymTableFrozen_hash(psBuild->keys[u],
+                                                  oFrozen->seed);
+      }
+      uMaxBucketSize = SymTableFrozen_group(oFrozen, psBuild,
+                                            auBucketStart, auOrder,
+                                            auBySize);
+
+      /* order the buckets from largest to smallest */
+      u = 0;
+      for (v = uMaxBucketSize; v > 0; v--) {
+         for (uBucket = 0; uBucket < oFrozen->bucketCount; uBucket++) {
+            if (auBucketStart[uBucket + 1] - auBucketStart[uBucket]
+                == v) {
+               auBySize[u++] = uBucket;
+            }
+         }
+      }
+
+      for (v = 0; v < u && iSuccessful; v++) {
+         uBucket = auBySize[v];
+         iSuccessful = SymTableFrozen_place(
+            oFrozen, psBuild, uBucket,
+            auOrder + auBucketStart[uBucket],
+            auBucketStart[uBucket + 1] - auBucketStart[uBucket],
+            acTaken, auPositions);
+      }
+   }
+
+   free(auBucketStart);
+   free(auOrder);
+   free(auBySize);
+   free(auPositions);
+   free(acTaken);
+   return iSuccessful;
+}
+
+/*********************************************************************/
+
+/*
+ * Builds a frozen copy of the bindings in oSymTable. Returns NULL if
+ * memory is insufficient or no perfect hash separates the keys.
+ */
+SymTableFrozen_T SymTable_freeze(SymTable_T oSymTable) {
+   SymTableFrozen_T oFrozen;
+   struct FrozenBuild sBuild;
+   size_t u;
+   int iSuccessful = 0;
+
+   assert(oSymTable != NULL);
+
+   oFrozen =
+      (SymTableFrozen_T) calloc(1, sizeof(struct SymTableFrozen));
+   if (oFrozen == NULL) {
+      return NULL;
+   }
+   oFrozen->size = SymTable_getLength(oSymTable);
+   oFrozen->bucketCount = oFrozen->size / KEYS_PER_BUCKET + 1;
+
+   /* collect the bindings */
+   sBuild.count = 0;
+   sBuild.keyBytes = 0;
+   sBuild.nextKey = NULL;
+   sBuild.keys = (const char **) malloc((oFrozen->size + 1)
+                                        * sizeof(const char *));
+   sBuild.vals = (void **) malloc((oFrozen->size + 1) * sizeof(void *));
+   sBuild.hashes = (size_t *) malloc((oFrozen->size + 1)
+                                     * sizeof(size_t));
+   oFrozen->slots = (struct FrozenSlot *)
+      calloc(oFrozen->size + 1, sizeof(struct FrozenSlot));
+   oFrozen->pilots = (size_t *) calloc(oFrozen->bucketCount,
+                                       sizeof(size_t));
+   if (sBuild.keys != NULL && sBuild.vals != NULL
+       && sBuild.hashes != NULL && oFrozen->slots != NULL
+       && oFrozen->pilots != NULL) {
+      /* size the key storage, then copy the keys into it */
+      SymTable_map(oSymTable, SymTableFrozen_measure, &sBuild);
+      oFrozen->keys = (char *) malloc(sBuild.keyBytes + 1);
+   }
+
+   if (oFrozen->keys != NULL) {
+      sBuild.nextKey = oFrozen->keys;
+      SymTable_map(oSymTable, SymTableFrozen_collect, &sBuild);
+      assert(sBuild.count == oFrozen->size);
+
+      /* an empty table needs no pilots at all */
+      iSuccessful = (oFrozen->size == 0);
+      for (u = 0; u < MAX_SEEDS && !iSuccessful; u++) {
+         oFrozen->seed = SymTableFrozen_mix(u);
+         iSuccessful = SymTableFrozen_search(oFrozen, &sBuild);
+      }
+   }
+
+   free(sBuild.keys);
+   free(sBuild.vals);
+   free(sBuild.hashes);
+   if (!iSuccessful) {
+      SymTableFrozen_free(oFrozen);
+      return NULL;
+   }
+   return oFrozen;
+}
+
+/*
+ * Frees all memory previously allocated for a SymTableFrozen_T.
+ */
+void SymTableFrozen_free(SymTableFrozen_T oFrozen) {
+   assert(oFrozen != NULL);
+
+   free(oFrozen->slots);
+   free(oFrozen->pilots);
+   free(oFrozen->keys);
+   free(oFrozen);
+}
+
+/*
+ * Returns the number of bindings contained within oFrozen.
+ */
+size_t SymTableFrozen_getLength(SymTableFrozen_T oFrozen) {
+   assert(oFrozen != NULL);
+
+   return oFrozen->size;
+}
+
+/*
+ * Returns the slot that pcKey would occupy in oFrozen if present.
+ */
+static struct FrozenSlot *SymTableFrozen_find(SymTableFrozen_T oFrozen,
+                                              const char *pcKey) {
+   size_t uHash;
+   size_t uPilot;
+
+   assert(oFrozen != NULL);
+   assert(pcKey != NULL);
+   assert(oFrozen->size > 0);
+
+   uHash = SymTableFrozen_hash(pcKey, oFrozen->seed);
+   uPilot = oFrozen->pilots[SymTableFrozen_bucket(
+                               uHash, oFrozen->bucketCount)];
+   return &oFrozen->slots[SymTableFrozen_position(uHash, uPilot,
+                                                  oFrozen->size)];
+}
+
+/*
+ * Returns 1 if pcKey is present and 0 otherwise.
+ */
+int SymTableFrozen_contains(SymTableFrozen_T oFrozen,
+                            const char *pcKey) {
+   struct FrozenSlot *psSlot;
+
+   assert(oFrozen != NULL);
+   assert(pcKey != NULL);
+
+   if (oFrozen->size == 0) {
+      return 0;
+   }
+
+   psSlot = SymTableFrozen_find(oFrozen, pcKey);
+   return strcmp(pcKey, psSlot->key) == 0;
+}
+
+/*
+ * If pcKey is present, returns its associated value. Returns NULL
+ * otherwise.
+ */
+void *SymTableFrozen_get(SymTableFrozen_T oFrozen, const char *pcKey) {
+   struct FrozenSlot *psSlot;
+
+   assert(oFrozen != NULL);
+   assert(pcKey != NULL);
+
+   if (oFrozen->size == 0) {
+      return NULL;
+   }
+
+   psSlot = SymTableFrozen_find(oFrozen, pcKey);
+   if (strcmp(pcKey, psSlot->key) == 0) {
+      return psSlot->val;
+   }
+
+   return NULL;
+}
+
+/*
+ * Applies (*pfApply) to all bindings in oFrozen, passing *pvExtra as
+ * a parameter.
+ */
+void SymTableFrozen_map(SymTableFrozen_T oFrozen,
+     void (*pfApply)(const char *pcKey, void *pvValue, void *pvExtra),
+                        const void *pvExtra) {
+   size_t u;
+
+   assert(oFrozen != NULL);
+   assert(pfApply != NULL);
+
+   for (u = 0; u < oFrozen->size; u++) {
+      (*pfApply)(oFrozen->slots[u].key, oFrozen->slots[u].val,
+                 (void *) pvExtra);
+   }
+}
+
+/*********************************************************************/
+
+/*
+ * Writes pcString to psFile as a C string literal, or NULL if
+ * pcString is NULL. Every byte that is not a printable character is
+ * written as a three-digit octal escape.
+ */
+static void SymTableFrozen_writeString(FILE *psFile,
+                                       const char *pcString) {
+   size_t u;
+
+   assert(psFile != NULL);
+
+   if (pcString == NULL) {
+      fprintf(psFile, "NULL");
+      return;
+   }
+
+   fputc('"', psFile);
+   for (u = 0; pcString[u] != '\0'; u++) {
+      if (pcString[u] == '"' || pcString[u] == '\\'
+          || pcString[u] == '?'
+          || !isprint((unsigned char)pcString[u])) {
+         fprintf(psFile, "\\%03o", (unsigned int)(unsigned char)
+                 pcString[u]);
+      }
+      else {
+         fputc(pcString[u], psFile);
+      }
+   }
+   fputc('"', psFile);
+}
+
+/*
+ * Writes the lookup functions of a table with no bindings.
+ */
+static void SymTableFrozen_writeEmpty(FILE *psFile,
+                                      const char *pcName) {
+   assert(psFile != NULL);
+   assert(pcName != NULL);
+
+   fprintf(psFile,
+           "size_t %s_getLength(void) {\n"
+           "   return 0;\n"
+           "}\n\n", pcName);
+   fprintf(psFile,
+           "int %s_contains(const char *pcKey) {\n"
+           "   assert(pcKey != NULL);\n"
+           "   return 0;\n"
+           "}\n\n", pcName);
+   fprintf(psFile,
+           "void *%s_get(const char *pcKey) {\n"
+           "   assert(pcKey != NULL);\n"
+           "   return NULL;\n"
+           "}\n", pcName);
+}
+
+/*
+ * Writes C source code for a constant copy of oFrozen to psFile.
+ * The values of oFrozen must be strings or NULL.
+ */
+int SymTableFrozen_write(SymTableFrozen_T oFrozen, FILE *psFile,
+                         const char *pcName) {
+   size_t u;
+   size_t uOffset;
+   const char *pcKey;
+
+   assert(oFrozen != NULL);
+   assert(psFile != NULL);
+   assert(pcName != NULL);
+
+   fprintf(psFile,
+           "/* Generated by gensymtable. Do not edit. */\n\n"
+           "#include <assert.h>\n"
+           "#include <stddef.h>\n"
+           "#include <string.h>\n\n");
+
+   if (oFrozen->size == 0) {
+      SymTableFrozen_writeEmpty(psFile, pcName);
+      return !ferror(psFile);
+   }
+
+   /* key storage in slot order, one key per line */
+   fprintf(psFile,
+           "/* Keys, NUL-terminated and stored back to back. */\n"
+           "static const char %s_acKeys[] = {\n", pcName);
+   for (u = 0; u < oFrozen->size; u++) {
+      fprintf(psFile, "  ");
+      for (pcKey = oFrozen->slots[u].key; *pcKey != '\0'; pcKey++) {
+         if (isalnum((unsigned char)*pcKey) || *pcKey == '_') {
+            fprintf(psFile, " '%c',", *pcKey);
+         }
+         else {
+            fprintf(psFile, " %d,", (int)(unsigned char)*pcKey);
+         }
+      }
+      fprintf(psFile, " 0,\n");
+   }
+   fprintf(psFile, "};\n\n");
+
+   /* slots, with key offsets matching the storage above */
+   fprintf(psFile,
+           "/* The binding in each slot: the offset of its key in\n"
+           "   %s_acKeys, and its value. */\n"
+           "static const struct {\n"
+           "   size_t uKey;\n"
+           "   const char *pcValue;\n"
+           "} %s_asSlots[] = {\n", pcName, pcName);
+   uOffset = 0;
+   for (u = 0; u < oFrozen->size; u++) {
+      fprintf(psFile, "   {%lu, ", (unsigned long)uOffset);
+      SymTableFrozen_writeString(psFile,
+                                 (const char *) oFrozen->slots[u].val);
+      fprintf(psFile, "},\n");
+      uOffset += strlen(oFrozen->slots[u].key) + 1;
+   }
+   fprintf(psFile, "};\n\n");
+
+   /* pilots, already mixed */
+   fprintf(psFile,
+           "/* The mask that each bucket applies to its hashes. */\n"
+           "static const size_t %s_auMasks[] = {\n", pcName);
+   for (u = 0; u < oFrozen->bucketCount; u++) {
+      fprintf(psFile, "   (size_t)0x%lxUL,\n", (unsigned long)
+              SymTableFrozen_mix(oFrozen->pilots[u] + 1));
+   }
+   fprintf(psFile, "};\n\n");
+
+   /* the hash functions; keep in step with SymTableFrozen_mix(),
+      SymTableFrozen_hash(), and SymTableFrozen_position() */
+   fprintf(psFile,
+           "/* Return a well-mixed version of uValue. */\n"
+           "static size_t %s_mix(size_t uValue) {\n"
+           "   uValue ^= uValue >> 33;\n"
+           "   uValue *= (size_t)0xff51afd7ed558ccdUL;\n"
+           "   uValue ^= uValue >> 33;\n"
+           "   uValue *= (size_t)0xc4ceb9fe1a85ec53UL;\n"
+           "   uValue ^= uValue >> 33;\n"
+           "   return uValue;\n"
+           "}\n\n", pcName);
+   fprintf(psFile,
+           "/* Return the slot that pcKey would occupy if present. */\n"
+           "static size_t %s_find(const char *pcKey) {\n"
+           "   size_t u;\n"
+           "   size_t uHash = (size_t)0x%lxUL;\n\n",
+           pcName,
+           (unsigned long)
+           (oFrozen->seed ^ (size_t)0xcbf29ce484222325UL));
+   fprintf(psFile,
+           "   assert(pcKey != NULL);\n\n"
+           "   for (u = 0; pcKey[u] != '\\0'; u++) {\n"
+           "      uHash = (uHash ^ (size_t)(unsigned char)pcKey[u])\n"
+           "         * (size_t)0x100000001b3UL;\n"
+           "   }\n"
+           "   uHash = %s_mix(uHash);\n\n"
+           "   u = (uHash >> (sizeof(size_t) * 4)) %% %luU;\n"
+           "   return %s_mix(uHash ^ %s_auMasks[u]) %% %luU;\n"
+           "}\n\n",
+           pcName, (unsigned long)oFrozen->bucketCount, pcName, pcName,
+           (unsigned long)oFrozen->size);
+
+   fprintf(psFile,
+           "size_t %s_getLength(void) {\n"
+           "   return %luU;\n"
+           "}\n\n", pcName, (unsigned long)oFrozen->size);
+   fprintf(psFile,
+           "int %s_contains(const char *pcKey) {\n"
+           "   return strcmp(pcKey, %s_acKeys\n"
+           "                 + %s_asSlots[%s_find(pcKey)].uKey) == 0;\n"
+           "}\n\n", pcName, pcName, pcName, pcName);
+   fprintf(psFile,
+           "void *%s_get(const char *pcKey) {\n"
+           "   size_t uSlot = %s_find(pcKey);\n\n"
+           "   if (strcmp(pcKey, %s_acKeys + %s_asSlots[uSlot].uKey)"
+           " == 0) {\n"
+           "      return (void *) %s_asSlots[uSlot].pcValue;\n"
+           "   }\n"
+           "   return NULL;\n"
+           "}\n", pcName, pcName, pcName, pcName, pcName);
+
+   return !ferror(psFile);
+}
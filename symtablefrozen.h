@@ -0,0 +1,83 @@
+/*********************************************************************/
+/* symtablefrozen.h                                                  */
+/* COS 217 Assignment 3: A Symbol Table ADT                          */
+/* Date: 10/31/2023                                                  */
+/* Author: Hugh Peterson                                             */
+/* Description: An immutable symbol table built once from a         */
+/*              SymTable_T and indexed by a minimal perfect hash     */
+/*********************************************************************/
+
+/*********************************************************************/
+
+#ifndef SYMTABLEFROZEN_INCLUDED
+#define SYMTABLEFROZEN_INCLUDED
+
+#include <stddef.h>
+#include <stdio.h>
+#include "symtable.h"
+
+/*
+ * A SymTableFrozen_T object is a read-only snapshot of the bindings
+ * of a SymTable_T. Every lookup takes exactly one probe and one key
+ * comparison.
+ */
+typedef struct SymTableFrozen *SymTableFrozen_T;
+
+/*********************************************************************/
+
+/*
+ * Builds a frozen copy of the bindings in oSymTable. The keys are
+ * copied into one contiguous block; the values are shared with
+ * oSymTable, which is left unchanged. Returns NULL if memory is
+ * insufficient, or if no perfect hash separates the keys, as when two
+ * of them hash alike under every seed tried.
+ */
+SymTableFrozen_T SymTable_freeze(SymTable_T oSymTable);
+
+/*
+ * Frees all memory previously allocated for a SymTableFrozen_T.
+ * Takes a frozen symbol table oFrozen.
+ */
+void SymTableFrozen_free(SymTableFrozen_T oFrozen);
+
+/*
+ * Returns the number of bindings contained within oFrozen.
+ */
+size_t SymTableFrozen_getLength(SymTableFrozen_T oFrozen);
+
+/*
+ * Returns 1 if pcKey is present in oFrozen and 0 otherwise.
+ * Takes a frozen symbol table oFrozen and a key pcKey.
+ */
+int SymTableFrozen_contains(SymTableFrozen_T oFrozen,
+     const char *pcKey);
+
+/*
+ * If pcKey is present in oFrozen, returns its associated value.
+ * Returns NULL otherwise.
+ */
+void *SymTableFrozen_get(SymTableFrozen_T oFrozen,
+     const char *pcKey);
+
+/*
+ * Applies (*pfApply) to all bindings in oFrozen, passing *pvExtra
+ * as a parameter. pfApply takes a key pcKey, a value pvValue, and an
+ * extra parameter pvExtra.
+ */
+void SymTableFrozen_map(SymTableFrozen_T oFrozen,
+     void (*pfApply)(const char *pcKey, void *pvValue, void *pvExtra),
+     const void *pvExtra);
+
+/*
+ * Writes C source code for a constant, heap-free copy of oFrozen to
+ * psFile. The code defines pcName_getLength(), pcName_contains(), and
+ * pcName_get(), which behave like their SymTableFrozen_T counterparts
+ * without taking a table. The values of oFrozen must be strings or
+ * NULL. Returns 1 if successful and 0 if writing failed.
+ */
+int SymTableFrozen_write(SymTableFrozen_T oFrozen, FILE *psFile,
+     const char *pcName);
+
+/*********************************************************************/
+
+#endif
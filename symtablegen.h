@@ -0,0 +1,292 @@
+/*********************************************************************/
+/* symtablegen.h                                                     */
+/* COS 217 Assignment 3: A Symbol Table ADT                          */
+/* Date: 10/31/2023                                                  */
+/* Author: Hugh Peterson                                             */
+/* Description: Macros that generate symbol tables specialized to    */
+/*              one value type, with values stored inline            */
+/*********************************************************************/
+
+/*********************************************************************/
+
+#ifndef SYMTABLEGEN_INCLUDED
+#define SYMTABLEGEN_INCLUDED
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * SYMTABLE_DECLARE(name, ValueType) declares a table type name##_T
+ * that maps string keys to values of type ValueType, and these
+ * functions on it:
+ *
+ *    name##_T name##_new(void);
+ *       Returns a new table, or NULL if memory is insufficient.
+ *    void name##_free(name##_T oTable);
+ *       Frees all memory of oTable.
+ *    size_t name##_getLength(name##_T oTable);
+ *       Returns the number of bindings in oTable.
+ *    int name##_put(name##_T oTable, const char *pcKey,
+ *                   ValueType value);
+ *       Binds a copy of pcKey to a copy of value. Returns 1 if
+ *       successful and 0 if pcKey is already present or memory is
+ *       insufficient.
+ *    int name##_contains(name##_T oTable, const char *pcKey);
+ *       Returns 1 if pcKey is present and 0 otherwise.
+ *    ValueType *name##_get(name##_T oTable, const char *pcKey);
+ *       Returns the address of the value of pcKey inside oTable, or
+ *       NULL if pcKey is absent. The address is valid until the next
+ *       put or remove, and the value may be changed through it.
+ *    int name##_remove(name##_T oTable, const char *pcKey,
+ *                      ValueType *pOldValue);
+ *       If pcKey is present, removes its binding, stores its value in
+ *       *pOldValue unless pOldValue is NULL, and returns 1. Returns 0
+ *       otherwise.
+ *    void name##_map(name##_T oTable,
+ *       void (*pfApply)(const char *pcKey, ValueType *pValue,
+ *                       void *pvExtra),
+ *       const void *pvExtra);
+ *       Applies (*pfApply) to all bindings, passing the address of
+ *       each value and pvExtra.
+ *
+ * SYMTABLE_DEFINE(name, ValueType) defines them, and must follow
+ * SYMTABLE_DECLARE(name, ValueType). Put SYMTABLE_DECLARE in a
+ * header and SYMTABLE_DEFINE in exactly one source file that
+ * includes it, or both in the one source file that uses the table.
+ * Follow each by a semicolon.
+ *
+ * Unlike a SymTable_T, which holds void pointers, these tables copy
+ * each value into the slot of its binding, so small values need no
+ * allocation of their own and a get touches no memory outside the
+ * table. The slots are searched by linear probing; each slot caches
+ * the hash of its key, so strcmp runs only on a full hash match.
+ */
+#define SYMTABLE_DECLARE(name, ValueType)                            \
+                                                                     \
+   typedef struct name *name##_T;                                    \
+                                                                     \
+   name##_T name##_new(void);                                        \
+   void name##_free(name##_T oTable);                                \
+   size_t name##_getLength(name##_T oTable);                         \
+   int name##_put(name##_T oTable, const char *pcKey,                \
+                  ValueType value);                                  \
+   int name##_contains(name##_T oTable, const char *pcKey);          \
+   ValueType *name##_get(name##_T oTable, const char *pcKey);        \
+   int name##_remove(name##_T oTable, const char *pcKey,             \
+                     ValueType *pOldValue);                          \
+   void name##_map(name##_T oTable,                                  \
+      void (*pfApply)(const char *pcKey, ValueType *pValue,          \
+                      void *pvExtra),                                \
+      const void *pvExtra)
+
+#define SYMTABLE_DEFINE(name, ValueType)                             \
+                                                                     \
+   /* A binding, or an empty slot if key is NULL. */                 \
+   struct name##_Slot {                                              \
+      char *key;                                                     \
+      size_t hash;                                                   \
+      ValueType value;                                               \
+   };                                                                \
+                                                                     \
+   /* A power-of-two array of slots, at most 2/3 full. */            \
+   struct name {                                                     \
+      struct name##_Slot *slots;                                     \
+      size_t capacity;                                               \
+      size_t size;                                                   \
+   };                                                                \
+                                                                     \
+   static size_t name##_hash(const char *pcKey) {                    \
+      const size_t HASH_MULTIPLIER = 65599;                          \
+      size_t u;                                                      \
+      size_t uHash = 0;                                              \
+      for (u = 0; pcKey[u] != '\0'; u++) {                           \
+         uHash = uHash * HASH_MULTIPLIER + (size_t)pcKey[u];         \
+      }                                                              \
+      /* spread every bit into the low bits the mask keeps (the      \
+         MurmurHash3 finalizer, as in symtableu64.c) */              \
+      uHash ^= uHash >> 33;                                          \
+      uHash *= (size_t)0xff51afd7ed558ccdUL;                         \
+      uHash ^= uHash >> 33;                                          \
+      uHash *= (size_t)0xc4ceb9fe1a85ec53UL;                         \
+      uHash ^= uHash >> 33;                                          \
+      return uHash;                                                  \
+   }                                                                 \
+                                                                     \
+   static struct name##_Slot *name##_find(name##_T oTable,           \
+         const char *pcKey, size_t uHash) {                          \
+      size_t uMask = oTable->capacity - 1;                           \
+      size_t u;                                                      \
+      for (u = uHash & uMask; oTable->slots[u].key != NULL;          \
+           u = (u + 1) & uMask) {                                    \
+         if (oTable->slots[u].hash == uHash                          \
+             && strcmp(oTable->slots[u].key, pcKey) == 0) {          \
+            return &oTable->slots[u];                                \
+         }                                                           \
+      }                                                              \
+      return NULL;                                                   \
+   }                                                                 \
+                                                                     \
+   static struct name##_Slot *name##_emptySlot(                      \
+         struct name##_Slot *aSlots, size_t uCapacity,               \
+         size_t uHash) {                                             \
+      size_t uMask = uCapacity - 1;                                  \
+      size_t u = uHash & uMask;                                      \
+      while (aSlots[u].key != NULL) {                                \
+         u = (u + 1) & uMask;                                        \
+      }                                                              \
+      return &aSlots[u];                                             \
+   }                                                                 \
+                                                                     \
+   static int name##_grow(name##_T oTable) {                         \
+      struct name##_Slot *aNewSlots;                                 \
+      size_t uNewCapacity = 2 * oTable->capacity;                    \
+      size_t u;                                                      \
+      aNewSlots = (struct name##_Slot *)                             \
+         calloc(uNewCapacity, sizeof(struct name##_Slot));           \
+      if (aNewSlots == NULL) {                                       \
+         return 0;                                                   \
+      }                                                              \
+      for (u = 0; u < oTable->capacity; u++) {                       \
+         if (oTable->slots[u].key != NULL) {                         \
+            *name##_emptySlot(aNewSlots, uNewCapacity,               \
+                              oTable->slots[u].hash) =               \
+               oTable->slots[u];                                     \
+         }                                                           \
+      }                                                              \
+      free(oTable->slots);                                           \
+      oTable->slots = aNewSlots;                                     \
+      oTable->capacity = uNewCapacity;                               \
+      return 1;                                                      \
+   }                                                                 \
+                                                                     \
+   name##_T name##_new(void) {                                       \
+      name##_T oTable = (name##_T) malloc(sizeof(struct name));      \
+      if (oTable == NULL) {                                          \
+         return NULL;                                                \
+      }                                                              \
+      oTable->capacity = 16;                                         \
+      oTable->size = 0;                                              \
+      oTable->slots = (struct name##_Slot *)                         \
+         calloc(oTable->capacity, sizeof(struct name##_Slot));       \
+      if (oTable->slots == NULL) {                                   \
+         free(oTable);                                               \
+         return NULL;                                                \
+      }                                                              \
+      return oTable;                                                 \
+   }                                                                 \
+                                                                     \
+   void name##_free(name##_T oTable) {                               \
+      size_t u;                                                      \
+      assert(oTable != NULL);                                        \
+      for (u = 0; u < oTable->capacity; u++) {                       \
+         free(oTable->slots[u].key);                                 \
+      }                                                              \
+      free(oTable->slots);                                           \
+      free(oTable);                                                  \
+   }                                                                 \
+                                                                     \
+   size_t name##_getLength(name##_T oTable) {                        \
+      assert(oTable != NULL);                                        \
+      return oTable->size;                                           \
+   }                                                                 \
+                                                                     \
+   int name##_put(name##_T oTable, const char *pcKey,                \
+                  ValueType value) {                                 \
+      struct name##_Slot *psSlot;                                    \
+      size_t uHash;                                                  \
+      char *pcKeyCopy;                                               \
+      assert(oTable != NULL);                                        \
+      assert(pcKey != NULL);                                         \
+      uHash = name##_hash(pcKey);                                    \
+      if (name##_find(oTable, pcKey, uHash) != NULL) {               \
+         return 0;                                                   \
+      }                                                              \
+      if ((oTable->size + 1) * 3 > oTable->capacity * 2              \
+          && !name##_grow(oTable)) {                                 \
+         return 0;                                                   \
+      }                                                              \
+      pcKeyCopy = (char *) malloc(strlen(pcKey) + 1);                \
+      if (pcKeyCopy == NULL) {                                       \
+         return 0;                                                   \
+      }                                                              \
+      strcpy(pcKeyCopy, pcKey);                                      \
+      psSlot = name##_emptySlot(oTable->slots, oTable->capacity,     \
+                                uHash);                              \
+      psSlot->key = pcKeyCopy;                                       \
+      psSlot->hash = uHash;                                          \
+      psSlot->value = value;                                         \
+      oTable->size++;                                                \
+      return 1;                                                      \
+   }                                                                 \
+                                                                     \
+   int name##_contains(name##_T oTable, const char *pcKey) {         \
+      assert(oTable != NULL);                                        \
+      assert(pcKey != NULL);                                         \
+      return name##_find(oTable, pcKey, name##_hash(pcKey)) != NULL; \
+   }                                                                 \
+                                                                     \
+   ValueType *name##_get(name##_T oTable, const char *pcKey) {       \
+      struct name##_Slot *psSlot;                                    \
+      assert(oTable != NULL);                                        \
+      assert(pcKey != NULL);                                         \
+      psSlot = name##_find(oTable, pcKey, name##_hash(pcKey));       \
+      return (psSlot == NULL) ? NULL : &psSlot->value;               \
+   }                                                                 \
+                                                                     \
+   int name##_remove(name##_T oTable, const char *pcKey,             \
+                     ValueType *pOldValue) {                         \
+      struct name##_Slot *psSlot;                                    \
+      size_t uMask;                                                  \
+      size_t uHole;                                                  \
+      size_t uHome;                                                  \
+      size_t u;                                                      \
+      assert(oTable != NULL);                                        \
+      assert(pcKey != NULL);                                         \
+      psSlot = name##_find(oTable, pcKey, name##_hash(pcKey));       \
+      if (psSlot == NULL) {                                          \
+         return 0;                                                   \
+      }                                                              \
+      if (pOldValue != NULL) {                                       \
+         *pOldValue = psSlot->value;                                 \
+      }                                                              \
+      free(psSlot->key);                                             \
+      /* shift the rest of the probe run back into the hole */       \
+      uMask = oTable->capacity - 1;                                  \
+      uHole = (size_t)(psSlot - oTable->slots);                      \
+      for (u = (uHole + 1) & uMask; oTable->slots[u].key != NULL;    \
+           u = (u + 1) & uMask) {                                    \
+         uHome = oTable->slots[u].hash & uMask;                      \
+         if ((uHole <= u) ? (uHole < uHome && uHome <= u)            \
+             : (uHole < uHome || uHome <= u)) {                      \
+            continue;                                                \
+         }                                                           \
+         oTable->slots[uHole] = oTable->slots[u];                    \
+         uHole = u;                                                  \
+      }                                                              \
+      oTable->slots[uHole].key = NULL;                               \
+      oTable->size--;                                                \
+      return 1;                                                      \
+   }                                                                 \
+                                                                     \
+   void name##_map(name##_T oTable,                                  \
+      void (*pfApply)(const char *pcKey, ValueType *pValue,          \
+                      void *pvExtra),                                \
+      const void *pvExtra) {                                         \
+      size_t u;                                                      \
+      assert(oTable != NULL);                                        \
+      assert(pfApply != NULL);                                       \
+      for (u = 0; u < oTable->capacity; u++) {                       \
+         if (oTable->slots[u].key != NULL) {                         \
+            (*pfApply)(oTable->slots[u].key, &oTable->slots[u].value,\
+                       (void *) pvExtra);                            \
+         }                                                           \
+      }                                                              \
+   }                                                                 \
+                                                                     \
+   /* a declaration, so that the macro takes a semicolon */          \
+   size_t name##_getLength(name##_T oTable)
+
+/*********************************************************************/
+
+#endif
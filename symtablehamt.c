@@ -0,0 +1,901 @@
+/*********************************************************************/
+/* symtablehamt.c                                                    */
+/* COS 217 Assignment 3: A Symbol Table ADT                          */
+/* Date: 10/31/2023                                                  */
+/* Author: Hugh Peterson                                             */
+/* Description: A symbol table module to associate string keys with  */
+/*              generic values (persistent hash array mapped trie    */
+/*              implementation)                                      */
+/*********************************************************************/
+
+/*********************************************************************/
+
+#include <assert.h>
+#include <string.h>
+#include "symtablehamt.h"
+#include "symtablemalloc.h"
+
+/*
+ * With -DSYMTABLE_LATENCY, put, get, remove, and map are compiled
+ * under other names and timed by symtablelatency.c.
+ */
+#ifdef SYMTABLE_LATENCY
+#include "symtablelatency.h"
+#define SymTable_put SymTable_untimedPut
+#define SymTable_get SymTable_untimedGet
+#define SymTable_remove SymTable_untimedRemove
+#define SymTable_map SymTable_untimedMap
+#endif
+
+/*********************************************************************/
+
+enum {
+   /* bits of the hash consumed by each level of the trie */
+   BITS_PER_LEVEL = 5,
+
+   /* children a branch can have: 2 ^ BITS_PER_LEVEL */
+   BRANCH_WIDTH = 32
+};
+
+/*********************************************************************/
+
+/*
+ * The part common to the two kinds of node. A node may be shared by
+ * any number of tables and parent nodes, and is freed when the last
+ * of them lets it go.
+ */
+struct Node {
+   /* number of tables and nodes that point to this node */
+   size_t refCount;
+
+   /* 1 for a struct Leaf and 0 for a struct Branch */
+   int isLeaf;
+};
+
+/*
+ * A binding, at the head of a list of the bindings whose keys have
+ * the same full hash code (almost always a list of one).
+ */
+struct Leaf {
+   /* common part; must be first */
+   struct Node node;
+
+   /* full hash code of key */
+   size_t hash;
+
+   /* the key, which the leaf owns */
+   char *key;
+
+   /* the value */
+   void *value;
+
+   /* the next binding with the same hash code, or NULL */
+   struct Leaf *next;
+};
+
+/*
+ * An interior node of the trie. A branch at depth d has a child for
+ * each value of bits d * BITS_PER_LEVEL and up of the hash codes
+ * below it that occurs; only those children are stored. No branch
+ * but the root has a single child that is a leaf, so a binding sits
+ * as close to the root as its hash code allows.
+ */
+struct Branch {
+   /* common part; must be first */
+   struct Node node;
+
+   /* bit i is set if there is a child for the value i */
+   unsigned long childMap;
+
+   /* number of children: the number of bits set in childMap */
+   unsigned int childCount;
+
+   /* the children, in order of value; really childCount long */
+   struct Node *children[1];
+};
+
+/*
+ * A version of a persistent table. The nodes it points to never
+ * change.
+ */
+struct SymTable {
+   /* the root: a branch, a leaf, or NULL if the table is empty */
+   struct Node *root;
+
+   /* number of bindings */
+   size_t size;
+
+   /* the source of all memory of the table */
+   struct SymTableAllocator allocator;
+
+   /* the context pointer passed to the allocator */
+   void *context;
+};
+
+/*********************************************************************/
+
+/*
+ * Returns the hash code of pcKey: the hash of symtablehash.c, mixed
+ * (by the MurmurHash3 finalizer) so that each level of the trie
+ * sees bits that depend on every byte of the key.
+ */
+static size_t SymTable_hash(const char *pcKey) {
+   const size_t HASH_MULTIPLIER = 65599;
+
+   size_t u;
+   size_t uHash = 0;
+
+   assert(pcKey != NULL);
+
+   for (u = 0; pcKey[u] != '\0'; u++) {
+      uHash = uHash * HASH_MULTIPLIER + (size_t)pcKey[u];
+   }
+
+   uHash ^= uHash >> 33;
+   uHash *= (size_t)0xff51afd7ed558ccdUL;
+   uHash ^= uHash >> 33;
+   uHash *= (size_t)0xc4ceb9fe1a85ec53UL;
+   uHash ^= uHash >> 33;
+   return uHash;
+}
+
+/*
+ * Returns the bit of a childMap for hash code uHash at the level
+ * that starts at bit iShift.
+ */
+static unsigned long SymTable_bit(size_t uHash, int iShift) {
+   return 1UL << ((uHash >> iShift) & (BRANCH_WIDTH - 1));
+}
+
+/*
+ * Returns the index among the children of psBranch of the child for
+ * ulBit.
+ */
+static unsigned int SymTable_position(const struct Branch *psBranch,
+                                      unsigned long ulBit) {
+   unsigned long ul;
+
+   assert(psBranch != NULL);
+
+   /* count the bits below ulBit, 32 at a time in parallel */
+   ul = psBranch->childMap & (ulBit - 1);
+   ul = ul - ((ul >> 1) & 0x55555555UL);
+   ul = (ul & 0x33333333UL) + ((ul >> 2) & 0x33333333UL);
+   ul = (ul + (ul >> 4)) & 0x0f0f0f0fUL;
+   return (unsigned int)(((ul * 0x01010101UL) & 0xffffffffUL) >> 24);
+}
+
+/*
+ * Returns uSize bytes from the allocator of oSymTable, or NULL if
+ * memory is insufficient.
+ */
+static void *SymTable_alloc(SymTable_T oSymTable, size_t uSize) {
+   assert(oSymTable != NULL);
+
+   return (*oSymTable->allocator.pfAlloc)(oSymTable->context, uSize);
+}
+
+/*
+ * Gives pvMemory, an allocation of uSize bytes, back to the allocator
+ * of oSymTable, if that allocator releases memory at all.
+ */
+static void SymTable_release(SymTable_T oSymTable, void *pvMemory,
+                             size_t uSize) {
+   assert(oSymTable != NULL);
+
+   if (oSymTable->allocator.pfFree != NULL) {
+      (*oSymTable->allocator.pfFree)(oSymTable->context, pvMemory,
+                                     uSize);
+   }
+}
+
+/*
+ * Returns the bytes that the allocator of oSymTable spends beyond a
+ * request of uBytes, or 0 if the allocator does not say.
+ */
+static size_t SymTable_allocSlack(SymTable_T oSymTable,
+                                  size_t uBytes) {
+   assert(oSymTable != NULL);
+
+   if (oSymTable->allocator.pfSlack == NULL) {
+      return 0;
+   }
+   return (*oSymTable->allocator.pfSlack)(oSymTable->context, uBytes);
+}
+
+/*
+ * Returns the bytes of a branch of uChildCount children.
+ */
+static size_t SymTable_branchBytes(unsigned int uChildCount) {
+   return sizeof(struct Branch)
+      + ((uChildCount > 0) ? uChildCount - 1 : 0)
+         * sizeof(struct Node *);
+}
+
+/*
+ * Adds a reference to psNode, which may be NULL, and returns it.
+ */
+static struct Node *SymTable_retain(struct Node *psNode) {
+   if (psNode != NULL) {
+      psNode->refCount++;
+   }
+   return psNode;
+}
+
+/*
+ * Drops a reference to psNode, which may be NULL, freeing it (with
+ * the allocator of oSymTable) and dropping its references to other
+ * nodes if it was the last.
+ */
+static void SymTable_drop(SymTable_T oSymTable, struct Node *psNode) {
+   struct Branch *psBranch;
+   struct Leaf *psLeaf;
+   unsigned int u;
+
+   assert(oSymTable != NULL);
+
+   /* the list of a leaf is walked rather than recursed down */
+   while (psNode != NULL && --psNode->refCount == 0) {
+      if (!psNode->isLeaf) {
+         psBranch = (struct Branch *) psNode;
+         for (u = 0; u < psBranch->childCount; u++) {
+            SymTable_drop(oSymTable, psBranch->children[u]);
+         }
+         SymTable_release(oSymTable, psBranch,
+                          SymTable_branchBytes(psBranch->childCount));
+         return;
+      }
+      psLeaf = (struct Leaf *) psNode;
+      psNode = (struct Node *) psLeaf->next;
+      SymTable_release(oSymTable, psLeaf->key,
+                       strlen(psLeaf->key) + 1);
+      SymTable_release(oSymTable, psLeaf, sizeof(struct Leaf));
+   }
+}
+
+/*
+ * Returns a new leaf, of one reference, binding a copy of pcKey,
+ * whose hash code is uHash, to pvValue, or NULL if memory is
+ * insufficient.
+ */
+static struct Leaf *SymTable_newLeaf(SymTable_T oSymTable,
+                                     const char *pcKey, size_t uHash,
+                                     void *pvValue) {
+   struct Leaf *psLeaf;
+   size_t uKeyBytes;
+
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   psLeaf = (struct Leaf *) SymTable_alloc(oSymTable,
+                                           sizeof(struct Leaf));
+   if (psLeaf == NULL) {
+      return NULL;
+   }
+   uKeyBytes = strlen(pcKey) + 1;
+   psLeaf->key = (char *) SymTable_alloc(oSymTable, uKeyBytes);
+   if (psLeaf->key == NULL) {
+      SymTable_release(oSymTable, psLeaf, sizeof(struct Leaf));
+      return NULL;
+   }
+   memcpy(psLeaf->key, pcKey, uKeyBytes);
+   psLeaf->node.refCount = 1;
+   psLeaf->node.isLeaf = 1;
+   psLeaf->hash = uHash;
+   psLeaf->value = pvValue;
+   psLeaf->next = NULL;
+   return psLeaf;
+}
+
+/*
+ * Returns a new branch, of one reference, with the children of
+ * psBranch (or none, if psBranch is NULL) changed as follows: if
+ * psChild is NULL, the child for ulBit is removed; otherwise, it
+ * becomes psChild, which the new branch takes the caller's
+ * reference to. The other children gain a reference. Returns NULL
+ * if memory is insufficient.
+ */
+static struct Branch *SymTable_copyBranch(SymTable_T oSymTable,
+                                          const struct Branch *psBranch,
+                                          unsigned long ulBit,
+                                          struct Node *psChild) {
+   struct Branch *psCopy;
+   unsigned long ulOldMap;
+   unsigned long ulNewMap;
+   unsigned int uCount;
+   unsigned int uFrom;
+   unsigned int uTo;
+   unsigned long ul;
+
+   assert(oSymTable != NULL);
+
+   ulOldMap = (psBranch == NULL) ? 0 : psBranch->childMap;
+   ulNewMap = (psChild == NULL) ? (ulOldMap & ~ulBit)
+      : (ulOldMap | ulBit);
+   uCount = (psBranch == NULL) ? 0 : psBranch->childCount;
+   if (ulNewMap != ulOldMap) {
+      uCount = (psChild == NULL) ? uCount - 1 : uCount + 1;
+   }
+
+   psCopy = (struct Branch *)
+      SymTable_alloc(oSymTable, SymTable_branchBytes(uCount));
+   if (psCopy == NULL) {
+      return NULL;
+   }
+   psCopy->node.refCount = 1;
+   psCopy->node.isLeaf = 0;
+   psCopy->childMap = ulNewMap;
+   psCopy->childCount = uCount;
+
+   uFrom = 0;
+   uTo = 0;
+   for (ul = 1; ul != 0 && ul <= (ulOldMap | ulNewMap); ul <<= 1) {
+      if (ul == ulBit) {
+         if (psChild != NULL) {
+            psCopy->children[uTo++] = psChild;
+         }
+         if (ulOldMap & ul) {
+            uFrom++;
+         }
+      }
+      else if (ulOldMap & ul) {
+         psCopy->children[uTo++] =
+            SymTable_retain(psBranch->children[uFrom++]);
+      }
+   }
+   return psCopy;
+}
+
+/*
+ * Returns a new subtree, of one reference, holding the leaves psOne
+ * and psOther, whose hash codes differ, below the level that starts
+ * at bit iShift. Both leaves gain a reference. Returns NULL if memory
+ * is insufficient.
+ */
+static struct Node *SymTable_pair(SymTable_T oSymTable,
+                                  struct Leaf *psOne,
+                                  struct Leaf *psOther, int iShift) {
+   struct Branch *psBranch;
+   struct Node *psChild;
+   unsigned long ulOne;
+   unsigned long ulOther;
+
+   assert(oSymTable != NULL);
+   assert(psOne != NULL);
+   assert(psOther != NULL);
+   assert(psOne->hash != psOther->hash);
+
+   ulOne = SymTable_bit(psOne->hash, iShift);
+   ulOther = SymTable_bit(psOther->hash, iShift);
+
+   if (ulOne == ulOther) {
+      psChild = SymTable_pair(oSymTable, psOne, psOther,
+                              iShift + BITS_PER_LEVEL);
+      if (psChild == NULL) {
+         return NULL;
+      }
+      psBranch = SymTable_copyBranch(oSymTable, NULL, ulOne, psChild);
+      if (psBranch == NULL) {
+         SymTable_drop(oSymTable, psChild);
+      }
+      return (struct Node *) psBranch;
+   }
+
+   psBranch = SymTable_copyBranch(oSymTable, NULL, ulOne,
+                                  SymTable_retain(&psOne->node));
+   if (psBranch == NULL) {
+      SymTable_drop(oSymTable, &psOne->node);
+      return NULL;
+   }
+   psChild = (struct Node *) psBranch;
+   psBranch = SymTable_copyBranch(oSymTable, psBranch, ulOther,
+                                  SymTable_retain(&psOther->node));
+   SymTable_drop(oSymTable, psChild);
+   if (psBranch == NULL) {
+      SymTable_drop(oSymTable, &psOther->node);
+   }
+   return (struct Node *) psBranch;
+}
+
+/*
+ * Returns the leaf of the subtree psNode, whose level starts at bit
+ * iShift, that binds pcKey, whose hash code is uHash, or NULL if
+ * there is none.
+ */
+static struct Leaf *SymTable_find(const struct Node *psNode,
+                                  const char *pcKey, size_t uHash) {
+   const struct Branch *psBranch;
+   struct Leaf *psLeaf;
+   unsigned long ulBit;
+   int iShift = 0;
+
+   assert(pcKey != NULL);
+
+   while (psNode != NULL && !psNode->isLeaf) {
+      psBranch = (const struct Branch *) psNode;
+      ulBit = SymTable_bit(uHash, iShift);
+      if ((psBranch->childMap & ulBit) == 0) {
+         return NULL;
+      }
+      psNode = psBranch->children[SymTable_position(psBranch, ulBit)];
+      iShift += BITS_PER_LEVEL;
+   }
+
+   for (psLeaf = (struct Leaf *) psNode; psLeaf != NULL;
+        psLeaf = psLeaf->next) {
+      if (psLeaf->hash == uHash && strcmp(psLeaf->key, pcKey) == 0) {
+         return psLeaf;
+      }
+   }
+   return NULL;
+}
+
+/*
+ * Returns a new version, of one reference, of the subtree psNode,
+ * whose level starts at bit iShift, with the leaf psNew (of one
+ * reference, and no next leaf) added; psNew gains a reference. Only
+ * the path from psNode to psNew is copied. Returns NULL if memory is
+ * insufficient or the key of psNew is already present, which
+ * *piPresent tells apart.
+ */
+static struct Node *SymTable_insert(SymTable_T oSymTable,
+                                    struct Node *psNode, int iShift,
+                                    struct Leaf *psNew,
+                                    int *piPresent) {
+   struct Branch *psBranch;
+   struct Branch *psCopy;
+   struct Leaf *psLeaf;
+   struct Node *psChild;
+   unsigned long ulBit;
+
+   assert(oSymTable != NULL);
+   assert(psNew != NULL);
+   assert(piPresent != NULL);
+
+   *piPresent = 0;
+   if (psNode == NULL) {
+      return SymTable_retain(&psNew->node);
+   }
+
+   if (psNode->isLeaf) {
+      psLeaf = (struct Leaf *) psNode;
+      if (psLeaf->hash != psNew->hash) {
+         return SymTable_pair(oSymTable, psLeaf, psNew, iShift);
+      }
+      if (SymTable_find(psNode, psNew->key, psNew->hash) != NULL) {
+         *piPresent = 1;
+         return NULL;
+      }
+      /* psNew is not yet shared, so it may still change */
+      psNew->next = (struct Leaf *) SymTable_retain(psNode);
+      return SymTable_retain(&psNew->node);
+   }
+
+   psBranch = (struct Branch *) psNode;
+   ulBit = SymTable_bit(psNew->hash, iShift);
+   if ((psBranch->childMap & ulBit) == 0) {
+      psCopy = SymTable_copyBranch(oSymTable, psBranch, ulBit,
+                                   SymTable_retain(&psNew->node));
+      if (psCopy == NULL) {
+         SymTable_drop(oSymTable, &psNew->node);
+      }
+      return (struct Node *) psCopy;
+   }
+
+   psChild = SymTable_insert(
+      oSymTable,
+      psBranch->children[SymTable_position(psBranch, ulBit)],
+      iShift + BITS_PER_LEVEL, psNew, piPresent);
+   if (psChild == NULL) {
+      return NULL;
+   }
+   psCopy = SymTable_copyBranch(oSymTable, psBranch, ulBit, psChild);
+   if (psCopy == NULL) {
+      SymTable_drop(oSymTable, psChild);
+   }
+   return (struct Node *) psCopy;
+}
+
+/*
+ * Makes *ppsNew a new version, of one reference, of the subtree
+ * psNode, whose level starts at bit iShift, in which the binding of
+ * pcKey, whose hash code is uHash, is removed (if pvValue is NULL)
+ * or bound to pvValue instead. *ppsNew is NULL if the subtree
+ * becomes empty. Stores the old value in *ppvOldValue. Returns 1 if
+ * successful, 0 if pcKey is absent, and -1 if memory is
+ * insufficient.
+ */
+static int SymTable_change(SymTable_T oSymTable, struct Node *psNode,
+                           int iShift, const char *pcKey, size_t uHash,
+                           int iRemove, void *pvValue,
+                           struct Node **ppsNew, void **ppvOldValue) {
+   struct Branch *psBranch;
+   struct Branch *psCopy;
+   struct Leaf *psLeaf;
+   struct Leaf *psTarget;
+   struct Leaf *psHead;
+   struct Leaf **ppsLink;
+   struct Leaf *psLeafCopy;
+   struct Node *psChild;
+   unsigned long ulBit;
+   int iStatus;
+
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+   assert(ppsNew != NULL);
+   assert(ppvOldValue != NULL);
+
+   if (psNode == NULL) {
+      return 0;
+   }
+
+   if (psNode->isLeaf) {
+      psTarget = SymTable_find(psNode, pcKey, uHash);
+      if (psTarget == NULL) {
+         return 0;
+      }
+      *ppvOldValue = psTarget->value;
+
+      /* copy the list up to the target, which shares its key with
+         no other leaf, so the copies need keys of their own */
+      psHead = NULL;
+      ppsLink = &psHead;
+      for (psLeaf = (struct Leaf *) psNode; psLeaf != psTarget;
+           psLeaf = psLeaf->next) {
+         psLeafCopy = SymTable_newLeaf(oSymTable, psLeaf->key,
+                                       psLeaf->hash, psLeaf->value);
+         if (psLeafCopy == NULL) {
+            SymTable_drop(oSymTable, (struct Node *) psHead);
+            return -1;
+         }
+         *ppsLink = psLeafCopy;
+         ppsLink = &psLeafCopy->next;
+      }
+      if (!iRemove) {
+         psLeafCopy = SymTable_newLeaf(oSymTable, psTarget->key,
+                                       psTarget->hash, pvValue);
+         if (psLeafCopy == NULL) {
+            SymTable_drop(oSymTable, (struct Node *) psHead);
+            return -1;
+         }
+         *ppsLink = psLeafCopy;
+         ppsLink = &psLeafCopy->next;
+      }
+      *ppsLink = (struct Leaf *)
+         SymTable_retain((struct Node *) psTarget->next);
+      *ppsNew = (struct Node *) psHead;
+      return 1;
+   }
+
+   psBranch = (struct Branch *) psNode;
+   ulBit = SymTable_bit(uHash, iShift);
+   if ((psBranch->childMap & ulBit) == 0) {
+      return 0;
+   }
+   iStatus = SymTable_change(
+      oSymTable, psBranch->children[SymTable_position(psBranch, ulBit)],
+      iShift + BITS_PER_LEVEL, pcKey, uHash, iRemove, pvValue,
+      &psChild, ppvOldValue);
+   if (iStatus != 1) {
+      return iStatus;
+   }
+
+   /* a branch left with one leaf gives way to the leaf */
+   if (psChild != NULL && psChild->isLeaf
+       && psBranch->childCount == 1) {
+      *ppsNew = psChild;
+      return 1;
+   }
+   if (psChild == NULL && psBranch->childCount == 1) {
+      *ppsNew = NULL;
+      return 1;
+   }
+   if (psChild == NULL && psBranch->childCount == 2) {
+      /* the other child, if a leaf, can move up */
+      psNode = psBranch->children[
+         (SymTable_position(psBranch, ulBit) == 0) ? 1 : 0];
+      if (psNode->isLeaf) {
+         *ppsNew = SymTable_retain(psNode);
+         return 1;
+      }
+   }
+
+   psCopy = SymTable_copyBranch(oSymTable, psBranch, ulBit, psChild);
+   if (psCopy == NULL) {
+      SymTable_drop(oSymTable, psChild);
+      return -1;
+   }
+   *ppsNew = (struct Node *) psCopy;
+   return 1;
+}
+
+/*
+ * Applies (*pfApply) to all bindings of the subtree psNode, passing
+ * pvExtra.
+ */
+static void SymTable_mapNode(const struct Node *psNode,
+     void (*pfApply)(const char *pcKey, void *pvValue, void *pvExtra),
+     void *pvExtra) {
+   const struct Branch *psBranch;
+   const struct Leaf *psLeaf;
+   unsigned int u;
+
+   assert(pfApply != NULL);
+
+   if (psNode == NULL) {
+      return;
+   }
+   if (!psNode->isLeaf) {
+      psBranch = (const struct Branch *) psNode;
+      for (u = 0; u < psBranch->childCount; u++) {
+         SymTable_mapNode(psBranch->children[u], pfApply, pvExtra);
+      }
+      return;
+   }
+   for (psLeaf = (const struct Leaf *) psNode; psLeaf != NULL;
+        psLeaf = psLeaf->next) {
+      (*pfApply)(psLeaf->key, psLeaf->value, pvExtra);
+   }
+}
+
+/*
+ * Adds the memory of the subtree psNode to *psMemory, counting
+ * branches as buckets and leaves as nodes.
+ */
+static void SymTable_measure(SymTable_T oSymTable,
+                             const struct Node *psNode,
+                             struct SymTableMemory *psMemory) {
+   const struct Branch *psBranch;
+   const struct Leaf *psLeaf;
+   size_t uBytes;
+   unsigned int u;
+
+   assert(psMemory != NULL);
+
+   if (psNode == NULL) {
+      return;
+   }
+   if (!psNode->isLeaf) {
+      psBranch = (const struct Branch *) psNode;
+      uBytes = SymTable_branchBytes(psBranch->childCount);
+      psMemory->buckets += uBytes;
+      psMemory->slack += SymTable_allocSlack(oSymTable, uBytes);
+      for (u = 0; u < psBranch->childCount; u++) {
+         SymTable_measure(oSymTable, psBranch->children[u], psMemory);
+      }
+      return;
+   }
+   for (psLeaf = (const struct Leaf *) psNode; psLeaf != NULL;
+        psLeaf = psLeaf->next) {
+      uBytes = strlen(psLeaf->key) + 1;
+      psMemory->nodes += sizeof(struct Leaf);
+      psMemory->keys += uBytes;
+      psMemory->slack +=
+         SymTable_allocSlack(oSymTable, sizeof(struct Leaf))
+         + SymTable_allocSlack(oSymTable, uBytes);
+   }
+}
+
+/*********************************************************************/
+
+/*
+ * Construct a new SymTable_T. Return NULL if memory is insufficient.
+ */
+SymTable_T SymTable_new(void) {
+   struct SymTableAllocator sMalloc;
+
+   SymTableMalloc_getAllocator(&sMalloc);
+   return SymTable_newWithAllocator(&sMalloc, NULL);
+}
+
+/*
+ * Construct a new SymTable_T that gets its memory from *psAllocator.
+ * Return NULL if memory is insufficient.
+ */
+SymTable_T SymTable_newWithAllocator(
+     const struct SymTableAllocator *psAllocator, void *pvContext) {
+   SymTable_T oSymTable;
+
+   assert(psAllocator != NULL);
+   assert(psAllocator->pfAlloc != NULL);
+
+   oSymTable = (SymTable_T)
+      (*psAllocator->pfAlloc)(pvContext, sizeof(struct SymTable));
+   if (oSymTable == NULL) {
+      return NULL;
+   }
+   oSymTable->root = NULL;
+   oSymTable->size = 0;
+   oSymTable->allocator = *psAllocator;
+   oSymTable->context = pvContext;
+   return oSymTable;
+}
+
+/*
+ * Returns a new SymTable_T sharing all of the nodes of oSymTable.
+ */
+SymTable_T SymTable_snapshot(SymTable_T oSymTable) {
+   SymTable_T oSnapshot;
+
+   assert(oSymTable != NULL);
+
+   oSnapshot = SymTable_newWithAllocator(&oSymTable->allocator,
+                                         oSymTable->context);
+   if (oSnapshot == NULL) {
+      return NULL;
+   }
+   oSnapshot->root = SymTable_retain(oSymTable->root);
+   oSnapshot->size = oSymTable->size;
+   return oSnapshot;
+}
+
+/*
+ * Frees all memory previously allocated for a SymTable_T that no
+ * other version shares.
+ */
+void SymTable_free(SymTable_T oSymTable) {
+   assert(oSymTable != NULL);
+
+   /* the client releases the memory of such a table all at once */
+   if (oSymTable->allocator.pfFree == NULL) {
+      return;
+   }
+
+   SymTable_drop(oSymTable, oSymTable->root);
+   SymTable_release(oSymTable, oSymTable, sizeof(struct SymTable));
+}
+
+/*
+ * Returns a size_t specifying the number of bindings contained within
+ * the specified SymTable_T.
+ */
+size_t SymTable_getLength(SymTable_T oSymTable) {
+   assert(oSymTable != NULL);
+
+   return oSymTable->size;
+}
+
+/*
+ * Tries to insert a new key-value binding with a String key and
+ * generic value into the specified SymTable_T. Returns 1 if successful
+ * and 0 if binding is already present or memory is insufficient.
+ */
+int SymTable_put(SymTable_T oSymTable,
+                 const char *pcKey, const void *pvValue) {
+   struct Leaf *psLeaf;
+   struct Node *psRoot;
+   size_t uHash;
+   int iPresent;
+
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   uHash = SymTable_hash(pcKey);
+   if (SymTable_find(oSymTable->root, pcKey, uHash) != NULL) {
+      return 0;
+   }
+
+   psLeaf = SymTable_newLeaf(oSymTable, pcKey, uHash, (void *) pvValue);
+   if (psLeaf == NULL) {
+      return 0;
+   }
+   psRoot = SymTable_insert(oSymTable, oSymTable->root, 0, psLeaf,
+                            &iPresent);
+   /* the new root, if any, holds the leaf now */
+   SymTable_drop(oSymTable, &psLeaf->node);
+   if (psRoot == NULL) {
+      return 0;
+   }
+
+   SymTable_drop(oSymTable, oSymTable->root);
+   oSymTable->root = psRoot;
+   oSymTable->size++;
+   return 1;
+}
+
+/*
+ * If pcKey is present in oSymTable, its value is changed to pvValue
+ * and the old value is returned. Otherwise, NULL is returned, as it
+ * is if memory is insufficient.
+ */
+void *SymTable_replace(SymTable_T oSymTable,
+     const char *pcKey, const void *pvValue) {
+   struct Node *psRoot;
+   void *pvOldValue = NULL;
+
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   if (SymTable_change(oSymTable, oSymTable->root, 0, pcKey,
+                       SymTable_hash(pcKey), 0, (void *) pvValue,
+                       &psRoot, &pvOldValue) != 1) {
+      return NULL;
+   }
+   SymTable_drop(oSymTable, oSymTable->root);
+   oSymTable->root = psRoot;
+   return pvOldValue;
+}
+
+/*
+ * Returns 1 if pcKey is present in oSymTable and 0 otherwise.
+ */
+int SymTable_contains(SymTable_T oSymTable, const char *pcKey) {
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   return SymTable_find(oSymTable->root, pcKey, SymTable_hash(pcKey))
+      != NULL;
+}
+
+/*
+ * If pcKey is present in oSymTable, returns its associated value.
+ * Returns NULL otherwise.
+ */
+void *SymTable_get(SymTable_T oSymTable, const char *pcKey) {
+   struct Leaf *psLeaf;
+
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   psLeaf = SymTable_find(oSymTable->root, pcKey, SymTable_hash(pcKey));
+   if (psLeaf == NULL) {
+      return NULL;
+   }
+   return psLeaf->value;
+}
+
+/*
+ * If pcKey is present in oSymTable, removes its binding and returns
+ * the associated value. Returns NULL otherwise, as it does if memory
+ * is insufficient.
+ */
+void *SymTable_remove(SymTable_T oSymTable, const char *pcKey) {
+   struct Node *psRoot;
+   void *pvOldValue = NULL;
+
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   if (SymTable_change(oSymTable, oSymTable->root, 0, pcKey,
+                       SymTable_hash(pcKey), 1, NULL,
+                       &psRoot, &pvOldValue) != 1) {
+      return NULL;
+   }
+   SymTable_drop(oSymTable, oSymTable->root);
+   oSymTable->root = psRoot;
+   oSymTable->size--;
+   return pvOldValue;
+}
+
+/*
+ * Applies (*pfApply) to all bindings in the symbol table, passing
+ * *pvExtra as a parameter.
+ */
+void SymTable_map(SymTable_T oSymTable,
+     void (*pfApply)(const char *pcKey, void *pvValue, void *pvExtra),
+                  const void *pvExtra) {
+   assert(oSymTable != NULL);
+   assert(pfApply != NULL);
+
+   SymTable_mapNode(oSymTable->root, pfApply, (void *) pvExtra);
+}
+
+/*
+ * Fills in *psMemory with the memory that oSymTable holds, including
+ * any that it shares with other versions. The branches are reported
+ * as buckets and the leaves as nodes.
+ */
+void SymTable_memoryUsage(SymTable_T oSymTable,
+                          struct SymTableMemory *psMemory) {
+   assert(oSymTable != NULL);
+   assert(psMemory != NULL);
+
+   psMemory->table = sizeof(struct SymTable);
+   psMemory->buckets = 0;
+   psMemory->nodes = 0;
+   psMemory->keys = 0;
+   psMemory->slack = SymTable_allocSlack(oSymTable, psMemory->table);
+   SymTable_measure(oSymTable, oSymTable->root, psMemory);
+   psMemory->total = psMemory->table + psMemory->buckets
+      + psMemory->nodes + psMemory->keys + psMemory->slack;
+}
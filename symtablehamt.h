@@ -0,0 +1,37 @@
+/*********************************************************************/
+/* symtablehamt.h                                                    */
+/* COS 217 Assignment 3: A Symbol Table ADT                          */
+/* Date: 10/31/2023                                                  */
+/* Author: Hugh Peterson                                             */
+/* Description: Extensions of the persistent (hash array mapped      */
+/*              trie) implementation of the symbol table module      */
+/*********************************************************************/
+
+/*********************************************************************/
+
+#ifndef SYMTABLEHAMT_INCLUDED
+#define SYMTABLEHAMT_INCLUDED
+
+#include "symtable.h"
+
+/*
+ * In symtablehamt.c, a SymTable_T never changes a node once it is
+ * built: put, replace, and remove copy the path from the root to the
+ * binding they change and share everything else. A table can
+ * therefore be snapshotted without copying any bindings.
+ */
+
+/*********************************************************************/
+
+/*
+ * Returns a new SymTable_T holding the bindings oSymTable holds now,
+ * in constant time: the two tables share all of their nodes. Later
+ * changes to either table do not affect the other, and each must be
+ * freed with SymTable_free. The snapshot gets its memory from the
+ * allocator of oSymTable. Returns NULL if memory is insufficient.
+ */
+SymTable_T SymTable_snapshot(SymTable_T oSymTable);
+
+/*********************************************************************/
+
+#endif
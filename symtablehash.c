@@ -9,10 +9,28 @@
 
 /*********************************************************************/
 
+#ifdef SYMTABLE_STATS
+#define _POSIX_C_SOURCE 199309L
+#endif
+
 #include <assert.h>
-#include <stdlib.h>
+#include <limits.h>
 #include <string.h>
-#include "symtable.h"
+#include <time.h>
+#include "symtablehash.h"
+#include "symtablemalloc.h"
+
+/*
+ * With -DSYMTABLE_LATENCY, put, get, remove, and map are compiled
+ * under other names and timed by symtablelatency.c.
+ */
+#ifdef SYMTABLE_LATENCY
+#include "symtablelatency.h"
+#define SymTable_put SymTable_untimedPut
+#define SymTable_get SymTable_untimedGet
+#define SymTable_remove SymTable_untimedRemove
+#define SymTable_map SymTable_untimedMap
+#endif
 
 /* /\* DEBUG *\/ */
 /* #include <stdio.h> */
@@ -30,8 +48,130 @@ enum NumBuckets {
    BUCKET_8 = 65521
 };
 
+/* the bucket counts a table grows through, in increasing order */
+static const enum NumBuckets aeBucketCounts[] = {
+   BUCKET_1, BUCKET_2, BUCKET_3, BUCKET_4,
+   BUCKET_5, BUCKET_6, BUCKET_7, BUCKET_8
+};
+
+enum {
+   /* bytes of one block of a filter; one cache line */
+   FILTER_BLOCK_BYTES = 64,
+
+   /* bits of filter per binding it is sized for */
+   FILTER_BITS_PER_KEY = 10,
+
+   /* bits each key sets within its block */
+   FILTER_PROBES = 6,
+
+   /* entries of the first undo log of a table */
+   UNDO_LOG_INITIAL = 16,
+
+   /* checkpoints of the first checkpoint stack of a table */
+   CHECKPOINTS_INITIAL = 8,
+
+   /* slots of the timer wheel, one per second; a binding that
+      expires further ahead waits in its slot for more turns */
+   WHEEL_SLOTS = 256,
+
+   /* buckets of the old bucket array that each put or remove moves
+      into the new one while the table grows */
+   REHASH_STEP = 4
+};
+
+/*
+ * What undoing an entry of an undo log does to its Binding.
+ */
+enum UndoKind {
+   /* the Binding was put; undoing frees it */
+   UNDO_PUT,
+
+   /* the Binding was shadowed, replaced, or removed in a scope;
+      undoing restores its value and scope and puts it back on its
+      chain */
+   UNDO_CHANGE,
+
+   /* the Binding was removed in a transaction; undoing is as for
+      UNDO_CHANGE, and committing frees it */
+   UNDO_REMOVE
+};
+
+/*
+ * SYMTABLE_COUNT(oSymTable, field) adds one to the named counter of
+ * oSymTable when the module is compiled with -DSYMTABLE_STATS, and
+ * does nothing otherwise.
+ */
+#ifdef SYMTABLE_STATS
+#define SYMTABLE_COUNT(oSymTable, field) ((oSymTable)->counters.field++)
+#else
+#define SYMTABLE_COUNT(oSymTable, field) ((void) 0)
+#endif
+
 /*********************************************************************/
 
+/*
+ * Counts the work done by a SymTable since its creation.
+ */
+struct SymTableCounters {
+   /* number of buckets searched for a key */
+   size_t probes;
+
+   /* number of key comparisons */
+   size_t compares;
+
+   /* number of calls to SymTable_expand that grew the table */
+   size_t expansions;
+
+   /* total seconds spent in those calls */
+   double expansionSeconds;
+};
+
+/*
+ * A blocked Bloom filter over the keys of a SymTable. Each key sets
+ * FILTER_PROBES bits of one block, so a lookup reads one cache line.
+ * Removing a key cannot clear its bits; they are dropped when the
+ * filter is rebuilt.
+ */
+struct SymTableFilter {
+   /* the blocks, or NULL if the table has no filter */
+   unsigned char *bits;
+
+   /* number of blocks */
+   size_t blockCount;
+
+   /* number of keys the filter was sized for */
+   size_t capacity;
+
+   /* number of keys removed since the filter was built, whose bits
+      are still set */
+   size_t stale;
+
+   /* number of lookups the filter answered alone */
+   size_t rejects;
+
+   /* number of lookups the filter let through for absent keys */
+   size_t falsePositives;
+};
+
+/*
+ * The expiry of a Binding put with a TTL, on the timer wheel of its
+ * SymTable.
+ */
+struct Timer {
+   /* the Binding that expires */
+   struct Binding *binding;
+
+   /* time, by the clock of the SymTable, at which binding expires */
+   unsigned long deadline;
+
+   /* next Timer in the same slot of the wheel */
+   struct Timer *next;
+
+   /* the pointer that points to this Timer: a slot of the wheel, the
+      sweep list, or the next field of the previous Timer */
+   struct Timer **link;
+};
+
 /*
  * Stores a key-value pair and a pointer to the next Binding.
  */
@@ -42,8 +182,47 @@ struct Binding {
    /* value */
    void *val;
 
+   /* full hash code of key (see SymTable_hashKey), so that the key
+      need not be hashed again when the Binding changes buckets */
+   size_t hash;
+
+   /* length of key, not counting its '\0' */
+   size_t length;
+
    /* pointer to next Binding */
    struct Binding *next;
+
+   /* depth of the scope that declared or last shadowed the Binding,
+      or 0 if no open scope did */
+   unsigned int scope;
+
+   /* 1 if the Binding was removed in an open scope or transaction:
+      it is off its chain, and the undo log frees or restores it */
+   unsigned int hidden : 1;
+
+   /* 1 if the Binding was used since the clock hand last passed it
+      (see SymTable_setCapacity) */
+   unsigned int referenced : 1;
+
+   /* the expiry of the Binding, or NULL if it was put without a TTL */
+   struct Timer *timer;
+};
+
+/*
+ * One change that SymTable_exitScope or SymTable_rollback may undo.
+ */
+struct UndoEntry {
+   /* the Binding that changed */
+   struct Binding *binding;
+
+   /* the value of the Binding before the change */
+   void *val;
+
+   /* the scope of the Binding before the change */
+   unsigned int scope;
+
+   /* what undoing the entry does */
+   enum UndoKind kind;
 };
 
 /*
@@ -56,31 +235,114 @@ struct SymTable {
    /* number of bindings stored in the SymTable */
    size_t size;
 
+   /* source of all the memory of the SymTable */
+   struct SymTableAllocator allocator;
+
+   /* context pointer passed to the allocator's functions */
+   void *context;
+
    /* number of buckets */
    enum NumBuckets bucketCount;
-   
+
+   /* the bucket array that buckets replaced, whose bindings are
+      still being moved into buckets, or NULL if none is */
+   struct Binding **oldBuckets;
+
+   /* number of buckets of oldBuckets */
+   enum NumBuckets oldBucketCount;
+
+   /* the buckets of oldBuckets below this index have been moved */
+   size_t rehashIndex;
+
+   /* filter answering most lookups of absent keys */
+   struct SymTableFilter filter;
+
+   /* number of open scopes */
+   unsigned int scopeDepth;
+
+   /* the changes made in the open scopes or transactions, oldest
+      first, or NULL if there have been none */
+   struct UndoEntry *undoLog;
+
+   /* number of entries in undoLog */
+   size_t undoLength;
+
+   /* number of entries undoLog has room for */
+   size_t undoCapacity;
+
+   /* the length of undoLog when each open transaction began, oldest
+      first, or NULL if there have been none */
+   size_t *checkpoints;
+
+   /* number of open transactions */
+   size_t checkpointCount;
+
+   /* number of entries checkpoints has room for */
+   size_t checkpointCapacity;
+
+   /* most bindings the SymTable may hold, or 0 if there is no limit */
+   size_t capacity;
+
+   /* bucket the clock hand points to: where the search for a binding
+      to evict resumes */
+   size_t clockHand;
+
+   /* function called on each evicted binding, or NULL */
+   void (*evictHandler)(const char *pcKey, void *pvValue,
+                        void *pvExtra);
+
+   /* extra parameter passed to evictHandler */
+   void *evictExtra;
+
+   /* WHEEL_SLOTS lists of Timers, a Timer in the slot of its deadline
+      (or of wheelTime, if that is later), or NULL if no binding has
+      been put with a TTL */
+   struct Timer **wheel;
+
+   /* first second whose slot SymTable_expire has yet to sweep */
+   unsigned long wheelTime;
+
+   /* Timers taken from the slot being swept that SymTable_expire has
+      yet to examine */
+   struct Timer *sweepList;
+
+   /* number of Timers on the wheel */
+   size_t timerCount;
+
+   /* function that returns the time in seconds */
+   unsigned long (*clock)(void *pvContext);
+
+   /* context pointer passed to clock */
+   void *clockContext;
+
+#ifdef SYMTABLE_STATS
+   /* work done since creation */
+   struct SymTableCounters counters;
+#endif
 };
       
 
 /*********************************************************************/
 
 /*
- * Return a hash code for pcKey that is between 0 and uBucketCount - 1,
- * inclusive.
+ * Return the full hash code of pcKey, before it is reduced to a
+ * bucket, and store the length of pcKey in *puLength.
  */
-static size_t SymTable_hash(const char *pcKey, size_t uBucketCount) {
+static size_t SymTable_hashKey(const char *pcKey, size_t *puLength) {
    const size_t HASH_MULTIPLIER = 65599;
    
    size_t u;
    size_t uHash = 0;
 
    assert(pcKey != NULL);
+   assert(puLength != NULL);
 
    for (u = 0; pcKey[u] != '\0'; u++) {
       uHash = uHash * HASH_MULTIPLIER + (size_t)pcKey[u];
    }
 
-   return uHash % uBucketCount;
+   *puLength = u;
+   return uHash;
 }
 
 /* static void printAsString(SymTable_T oSymTable) { */
@@ -114,361 +376,1278 @@ static size_t SymTable_hash(const char *pcKey, size_t uBucketCount) {
 /* } */
 
 /*
- * Puts a new binding at the end of a linked list beginning at the 
- * specified index. Takes an array of Binding pointers.
+ * Returns uSize bytes from the allocator of oSymTable, or NULL if
+ * memory is insufficient.
  */
-static void SymTable_listPut(struct Binding **buckets,
-                           int index, struct Binding *b) {
-   struct Binding *current;
-
-   assert(buckets != NULL);
-   assert(b != NULL);
-   
-   if (buckets[index] == NULL) {
-      buckets[index] = b;
-      return;
-   }
-   
-   current = buckets[index];
-   while (current->next != NULL) {
-      current = current->next;
-   }
+static void *SymTable_alloc(SymTable_T oSymTable, size_t uSize) {
+   assert(oSymTable != NULL);
 
-   current->next = b;
+   return (*oSymTable->allocator.pfAlloc)(oSymTable->context, uSize);
 }
 
 /*
- * Grows a hash table to the next size in the specified sequence 
- * if possible. If the end of the sequence is reached, does nothing.
- * Takes a symbol table oSymTable.
+ * Gives pvMemory, an allocation of uSize bytes, back to the allocator
+ * of oSymTable, if that allocator releases memory at all.
  */
-static void SymTable_expand(SymTable_T oSymTable) {
-   struct Binding **newBuckets;
-   enum NumBuckets newCount;
-   int i;
-   struct Binding *current;
-   struct Binding *previous;
-   int index;
-   
+static void SymTable_release(SymTable_T oSymTable, void *pvMemory,
+                             size_t uSize) {
    assert(oSymTable != NULL);
 
-   /* /\* DEBUG *\/ */
-   /* printAsString(oSymTable); */
-   
-   /* find new count */
-   switch(oSymTable->bucketCount) {
-      case BUCKET_1:
-         newCount = BUCKET_2;
-         break;
-      case BUCKET_2:
-         newCount = BUCKET_3;
-         break;
-      case BUCKET_3:
-         newCount = BUCKET_4;
-         break;
-      case BUCKET_4:
-         newCount = BUCKET_5;
-         break;
-      case BUCKET_5:
-         newCount = BUCKET_6;
-         break;
-      case BUCKET_6:
-         newCount = BUCKET_7;
-         break;
-      case BUCKET_7:
-         newCount = BUCKET_8;
-         break;
-      default:
-         return;
-   }
-
-   /* allocate for buckets */
-   newBuckets =
-      (struct Binding**) calloc((size_t) newCount,
-                                sizeof(struct Binding *));
-   if (newBuckets == NULL) {
-      return;
-   }
-
-   /* rehash all bindings into new buckets */
-   for (i = 0; i < (int) oSymTable->bucketCount; i++) {
-      current = oSymTable->buckets[i];
-      while (current) {
-         /* rehash */
-         index = (int)(SymTable_hash(current->key, (size_t)newCount))
-            % (int)newCount;
-         /* erase next pointer */
-         previous = current;
-         current = current->next;
-         
-         previous->next = NULL;
-
-         /* put in list */
-         SymTable_listPut(newBuckets, index, previous);
-      }
+   if (oSymTable->allocator.pfFree != NULL) {
+      (*oSymTable->allocator.pfFree)(oSymTable->context, pvMemory,
+                                     uSize);
    }
-
-   free(oSymTable->buckets);
-   oSymTable->buckets = newBuckets;
-   oSymTable->bucketCount = newCount;
-
-   /* /\* DEBUG *\/ */
-   /* printAsString(oSymTable); */
 }
 
-/*********************************************************************/
-
 /*
- * Construct a new SymTable_T. Return NULL if memory is insufficient.
+ * Returns the bytes that the allocator of oSymTable spends beyond a
+ * request of uBytes, or 0 if the allocator does not say.
  */
-SymTable_T SymTable_new(void) {
-   SymTable_T oSymTable;
-   struct Binding **buckets;
+static size_t SymTable_allocSlack(SymTable_T oSymTable,
+                                  size_t uBytes) {
+   assert(oSymTable != NULL);
 
-   /* allocate for st */
-   oSymTable = (SymTable_T) malloc(sizeof(struct SymTable));
-   if (oSymTable == NULL) {
-      return NULL;
-   }
-   /* allocate for buckets */
-   buckets =
-      (struct Binding**) calloc((size_t)BUCKET_1,
-                                sizeof(struct Binding *));
-   if (buckets == NULL) {
-      free(oSymTable);
-      return NULL;
+   if (oSymTable->allocator.pfSlack == NULL) {
+      return 0;
    }
+   return (*oSymTable->allocator.pfSlack)(oSymTable->context, uBytes);
+}
 
-   oSymTable->buckets = buckets;
-   oSymTable->size = 0;
-   oSymTable->bucketCount = BUCKET_1;
-   
-   return oSymTable;
+/*
+ * Returns a well-mixed function of uHash (the MurmurHash3
+ * finalizer), so that the filter does not reuse the bits that chose
+ * the bucket.
+ */
+static size_t SymTable_mix(size_t uHash) {
+   uHash ^= uHash >> 33;
+   uHash *= (size_t)0xff51afd7ed558ccdUL;
+   uHash ^= uHash >> 33;
+   uHash *= (size_t)0xc4ceb9fe1a85ec53UL;
+   uHash ^= uHash >> 33;
+   return uHash;
 }
 
 /*
- * Frees all memory previously allocated for a SymTable_T
+ * Sets the bits of the key whose full hash is uHash in the filter
+ * aucBits of uBlockCount blocks, or, if iTest is 1, only tests them.
+ * Returns 1 if all of the bits are (now) set and 0 otherwise.
  */
-void SymTable_free(SymTable_T oSymTable) {
-   struct Binding *previous;
-   struct Binding *current;
-   int i = 0;
+static int SymTable_filterBits(unsigned char *aucBits,
+                               size_t uBlockCount, size_t uHash,
+                               int iTest) {
+   const size_t BLOCK_BITS = FILTER_BLOCK_BYTES * 8;
+
+   unsigned char *pucBlock;
+   size_t uMixed;
+   size_t uBit;
+   size_t uStep;
+   int i;
 
-   assert(oSymTable != NULL);
+   assert(aucBits != NULL);
 
-   for (; i < (int)oSymTable->bucketCount; i++) {
-      if ((previous = oSymTable->buckets[i]) == NULL) {
-         continue;
+   uMixed = SymTable_mix(uHash);
+   pucBlock = aucBits + (uMixed % uBlockCount) * FILTER_BLOCK_BYTES;
+
+   /* the bits of the block: uBit, uBit + uStep, uBit + 2 uStep... */
+   uMixed = SymTable_mix(uMixed);
+   uBit = uMixed % BLOCK_BITS;
+   uStep = (uMixed / BLOCK_BITS) % BLOCK_BITS | 1;
+   for (i = 0; i < FILTER_PROBES; i++) {
+      if (iTest) {
+         if ((pucBlock[uBit / 8] & (1 << (uBit % 8))) == 0) {
+            return 0;
+         }
       }
-      current = previous->next;
-      while (current != NULL) {
-         free(previous->key);
-         free(previous);
-         previous = current;
-         current = current->next;
+      else {
+         pucBlock[uBit / 8] |= (unsigned char)(1 << (uBit % 8));
       }
-      free(previous->key);
-      free(previous);
+      uBit = (uBit + uStep) % BLOCK_BITS;
    }
-   free(oSymTable->buckets);
-   free(oSymTable);
-}
-
-/*
- * Returns a size_t specifying the number of bindings contained within 
- * the specified SymTable_T.
- */
-size_t SymTable_getLength(SymTable_T oSymTable) {
-   assert(oSymTable != NULL);
-   
-   return oSymTable->size;
+   return 1;
 }
 
 /*
- * Tries to insert a new key-value binding with a String key and 
- * generic value into the specified SymTable_T. Returns 1 if successful
- * and 0 if binding is already present or memory is insufficient.
+ * Replaces the filter of oSymTable with one sized for uCapacity keys
+ * (at least as many as it holds) and holding exactly its keys.
+ * Returns 1 if successful and 0 if memory is insufficient, in which
+ * case the old filter, which still has no false negatives, is kept.
  */
-int SymTable_put(SymTable_T oSymTable,
-                 const char *pcKey, const void *pvValue) {
-   char *keyCopy;
-   int keyLen;
-   int bucketIdx;
-   struct Binding *newBind;
+static int SymTable_filterBuild(SymTable_T oSymTable,
+                                size_t uCapacity) {
+   unsigned char *aucBits;
+   size_t uBlockCount;
+   struct Binding *current;
+   size_t u;
+   int i;
 
    assert(oSymTable != NULL);
-   assert(pcKey != NULL);
-   
-   if (SymTable_contains(oSymTable, pcKey)) {
-      return 0;
-   }
 
-   newBind = (struct Binding*)calloc(1, sizeof(struct Binding));
-   if (newBind == NULL) {
-      return 0;
+   if (uCapacity < oSymTable->size) {
+      uCapacity = oSymTable->size;
+   }
+   uBlockCount = (uCapacity * FILTER_BITS_PER_KEY
+                  + FILTER_BLOCK_BYTES * 8 - 1)
+      / (FILTER_BLOCK_BYTES * 8);
+   if (uBlockCount == 0) {
+      uBlockCount = 1;
    }
 
-   /* Duplicate key */
-   keyLen = (int) strlen(pcKey);
-   keyCopy = (char *) malloc((size_t)(keyLen + 1));
-   if (keyCopy == NULL) {
+   aucBits = (unsigned char *)
+      SymTable_alloc(oSymTable, uBlockCount * FILTER_BLOCK_BYTES);
+   if (aucBits == NULL) {
       return 0;
    }
-   strcpy(keyCopy, pcKey);
-   
-   /* put key in */
-   newBind->key = keyCopy;
-   newBind->val = (void *) pvValue;
+   memset(aucBits, 0, uBlockCount * FILTER_BLOCK_BYTES);
 
-   bucketIdx = (int)(SymTable_hash(keyCopy, (size_t)oSymTable->bucketCount))
-      % (int)oSymTable->bucketCount;
-   SymTable_listPut(oSymTable->buckets, bucketIdx, newBind);
-   oSymTable->size++;
+   for (i = 0; i < (int)oSymTable->bucketCount; i++) {
+      for (current = oSymTable->buckets[i]; current != NULL;
+           current = current->next) {
+         SymTable_filterBits(aucBits, uBlockCount, current->hash, 0);
+      }
+   }
+   if (oSymTable->oldBuckets != NULL) {
+      for (u = oSymTable->rehashIndex;
+           u < (size_t)oSymTable->oldBucketCount; u++) {
+         for (current = oSymTable->oldBuckets[u]; current != NULL;
+              current = current->next) {
+            SymTable_filterBits(aucBits, uBlockCount, current->hash,
+                                0);
+         }
+      }
+   }
 
-   if ((int) oSymTable->size > (int) oSymTable->bucketCount) {
-      SymTable_expand(oSymTable);
+   if (oSymTable->filter.bits != NULL) {
+      SymTable_release(oSymTable, oSymTable->filter.bits,
+                       oSymTable->filter.blockCount
+                       * FILTER_BLOCK_BYTES);
    }
-   
+   oSymTable->filter.bits = aucBits;
+   oSymTable->filter.blockCount = uBlockCount;
+   oSymTable->filter.capacity =
+      uBlockCount * FILTER_BLOCK_BYTES * 8 / FILTER_BITS_PER_KEY;
+   oSymTable->filter.stale = 0;
    return 1;
 }
 
 /*
- * If *pcKey is present as a key, its value is changed to *pcValue and 
- * the old value is returned. Otherwise, NULL is returned.
+ * Returns 0 if the filter of oSymTable shows that the key whose full
+ * hash is uHash is absent, and 1 if it may be present or there is no
+ * filter.
  */
-void *SymTable_replace(SymTable_T oSymTable,
-                       const char *pcKey, const void *pvValue) {
-   struct Binding *current;
-   void *oldVal;
-   int index;
-   
+static int SymTable_filterMayContain(SymTable_T oSymTable,
+                                     size_t uHash) {
    assert(oSymTable != NULL);
-   assert(pcKey != NULL);
-
-   /* Find and replace binding */
-   index = (int)(SymTable_hash(pcKey, (size_t)oSymTable->bucketCount))
-      % (int)oSymTable->bucketCount;
-   
-   current = oSymTable->buckets[index];
-   while (current != NULL) {
-      if (strcmp(pcKey, current->key) == 0) {
-         /* change value */
-         oldVal = current->val;
-         current->val = (void *) pvValue;
 
-         return oldVal;
-      }
-      current = current->next;
+   if (oSymTable->filter.bits == NULL) {
+      return 1;
    }
-
-   return NULL;
+   if (!SymTable_filterBits(oSymTable->filter.bits,
+                            oSymTable->filter.blockCount, uHash, 1)) {
+      oSymTable->filter.rejects++;
+      return 0;
+   }
+   return 1;
 }
 
 /*
- * Returns 1 if pcKey is present and 0 otherwise.
+ * Records that a lookup that the filter of oSymTable let through
+ * found nothing.
  */
-int SymTable_contains(SymTable_T oSymTable, const char *pcKey) {
-   struct Binding *current;
-   int index;
-
+static void SymTable_filterMissed(SymTable_T oSymTable) {
    assert(oSymTable != NULL);
-   assert(pcKey != NULL);
-
-   index = (int)(SymTable_hash(pcKey, (size_t)oSymTable->bucketCount))
-      % (int)oSymTable->bucketCount;
 
-   current = oSymTable->buckets[index];
-   while (current != NULL) {
-      if (strcmp(pcKey, current->key) == 0) {
-         return 1;
-      }
-      current = current->next;
+   if (oSymTable->filter.bits != NULL) {
+      oSymTable->filter.falsePositives++;
    }
-
-   return 0;
 }
 
 /*
- * If pcKey is present, returns its associated value. Returns NULL 
- * otherwise.
+ * Adds the key whose full hash is uHash, just put into oSymTable, to
+ * its filter, growing the filter if it holds more keys than it was
+ * sized for.
  */
-void *SymTable_get(SymTable_T oSymTable, const char *pcKey) {
-   struct Binding *current;
-   int index;
-
+static void SymTable_filterAdded(SymTable_T oSymTable, size_t uHash) {
    assert(oSymTable != NULL);
-   assert(pcKey != NULL);
 
-   index = (int)(SymTable_hash(pcKey, (size_t)oSymTable->bucketCount))
-      % (int)oSymTable->bucketCount;
+   if (oSymTable->filter.bits == NULL) {
+      return;
+   }
+   if (oSymTable->size > oSymTable->filter.capacity
+       && SymTable_filterBuild(oSymTable,
+                               2 * oSymTable->filter.capacity)) {
+      return;
+   }
+   SymTable_filterBits(oSymTable->filter.bits,
+                       oSymTable->filter.blockCount, uHash, 0);
+}
+
+/*
+ * Notes that a key was removed from oSymTable. Once the bits of
+ * removed keys make up half of the filter's capacity, the filter is
+ * rebuilt, so each removal costs amortized constant time.
+ */
+static void SymTable_filterRemoved(SymTable_T oSymTable) {
+   assert(oSymTable != NULL);
+
+   if (oSymTable->filter.bits == NULL) {
+      return;
+   }
+   oSymTable->filter.stale++;
+   if (2 * oSymTable->filter.stale > oSymTable->filter.capacity) {
+      SymTable_filterBuild(oSymTable, oSymTable->filter.capacity);
+   }
+}
+
+/*
+ * Puts a new binding at the end of the linked list that *pHead
+ * begins.
+ */
+static void SymTable_listPut(struct Binding **pHead,
+                             struct Binding *b) {
+   struct Binding *current;
+
+   assert(pHead != NULL);
+   assert(b != NULL);
+   
+   if (*pHead == NULL) {
+      *pHead = b;
+      return;
+   }
+   
+   current = *pHead;
+   while (current->next != NULL) {
+      current = current->next;
+   }
+
+   current->next = b;
+}
+
+/*
+ * Moves the bindings of up to uSteps buckets of the old bucket array
+ * of oSymTable into its buckets, freeing the old array once it is
+ * empty.
+ */
+static void SymTable_rehashStep(SymTable_T oSymTable, size_t uSteps) {
+   struct Binding *current;
+   struct Binding *previous;
+
+   assert(oSymTable != NULL);
+
+   if (oSymTable->oldBuckets == NULL) {
+      return;
+   }
+
+   for (; uSteps > 0 && oSymTable->rehashIndex
+           < (size_t)oSymTable->oldBucketCount; uSteps--) {
+      current = oSymTable->oldBuckets[oSymTable->rehashIndex];
+      oSymTable->oldBuckets[oSymTable->rehashIndex] = NULL;
+      while (current) {
+         previous = current;
+         current = current->next;
+         previous->next = NULL;
+         SymTable_listPut(&oSymTable->buckets[previous->hash
+            % (size_t)oSymTable->bucketCount], previous);
+      }
+      oSymTable->rehashIndex++;
+   }
+
+   if (oSymTable->rehashIndex == (size_t)oSymTable->oldBucketCount) {
+      SymTable_release(oSymTable, oSymTable->oldBuckets,
+         (size_t)oSymTable->oldBucketCount * sizeof(struct Binding *));
+      oSymTable->oldBuckets = NULL;
+   }
+}
+
+/*
+ * Moves every binding left in the old bucket array of oSymTable, if
+ * any, into its buckets, before an operation that walks them all.
+ */
+static void SymTable_finishRehash(SymTable_T oSymTable) {
+   assert(oSymTable != NULL);
+
+   SymTable_rehashStep(oSymTable, (size_t)oSymTable->oldBucketCount);
+}
+
+/*
+ * Grows a hash table to the smallest size in the specified sequence
+ * that has at least uBindingCount buckets, or to the largest size if
+ * none does. If the table is already that large, does nothing. Takes
+ * a symbol table oSymTable.
+ *
+ * Only the new bucket array is made here. The bindings stay in the
+ * old one until SymTable_rehashStep moves them, a few buckets per
+ * put or remove, so that no single call pays for moving them all.
+ * Until then, a key is in its bucket of the old array if that bucket
+ * has yet to be moved, and in its bucket of the new array otherwise.
+ */
+static void SymTable_expand(SymTable_T oSymTable,
+                            size_t uBindingCount) {
+   struct Binding **newBuckets;
+   enum NumBuckets newCount;
+   size_t u;
+#ifdef SYMTABLE_STATS
+   struct timespec sStart;
+   struct timespec sEnd;
+#endif
+   
+   assert(oSymTable != NULL);
+
+   /* /\* DEBUG *\/ */
+   /* printAsString(oSymTable); */
+   
+   /* find new count */
+   u = 0;
+   while (u + 1 < sizeof(aeBucketCounts) / sizeof(aeBucketCounts[0])
+          && (size_t)aeBucketCounts[u] < uBindingCount) {
+      u++;
+   }
+   newCount = aeBucketCounts[u];
+   if (newCount <= oSymTable->bucketCount) {
+      return;
+   }
+
+#ifdef SYMTABLE_STATS
+   clock_gettime(CLOCK_MONOTONIC, &sStart);
+#endif
+
+   /* allocate for buckets */
+   newBuckets =
+      (struct Binding**) SymTable_alloc(oSymTable,
+         (size_t) newCount * sizeof(struct Binding *));
+   if (newBuckets == NULL) {
+      return;
+   }
+   memset(newBuckets, 0, (size_t) newCount * sizeof(struct Binding *));
+
+   /* growing again so soon is rare: the steps of the last growth
+      finish before the table doubles */
+   SymTable_finishRehash(oSymTable);
+
+   oSymTable->oldBuckets = oSymTable->buckets;
+   oSymTable->oldBucketCount = oSymTable->bucketCount;
+   oSymTable->rehashIndex = 0;
+   oSymTable->buckets = newBuckets;
+   oSymTable->bucketCount = newCount;
+
+   if (oSymTable->filter.bits != NULL) {
+      SymTable_filterBuild(oSymTable, (size_t)newCount);
+   }
+
+#ifdef SYMTABLE_STATS
+   clock_gettime(CLOCK_MONOTONIC, &sEnd);
+   oSymTable->counters.expansions++;
+   oSymTable->counters.expansionSeconds +=
+      (double)(sEnd.tv_sec - sStart.tv_sec)
+      + (double)(sEnd.tv_nsec - sStart.tv_nsec) / 1e9;
+#endif
+
+   /* /\* DEBUG *\/ */
+   /* printAsString(oSymTable); */
+}
+
+/*
+ * Returns the head of the chain of oSymTable that holds the key whose
+ * full hash code is uHash and whose bucket of the current bucket
+ * array is uBucket.
+ */
+static struct Binding **SymTable_chain(SymTable_T oSymTable,
+                                       size_t uHash, size_t uBucket) {
+   size_t uOld;
+
+   assert(oSymTable != NULL);
+
+   if (oSymTable->oldBuckets != NULL) {
+      uOld = uHash % (size_t)oSymTable->oldBucketCount;
+      if (uOld >= oSymTable->rehashIndex) {
+         return &oSymTable->oldBuckets[uOld];
+      }
+   }
+   return &oSymTable->buckets[uBucket];
+}
+
+/*
+ * Takes b, which is in oSymTable, off its chain.
+ */
+static void SymTable_unlink(SymTable_T oSymTable, struct Binding *b) {
+   struct Binding **pLink;
+
+   assert(oSymTable != NULL);
+   assert(b != NULL);
+
+   pLink = SymTable_chain(oSymTable, b->hash,
+                          b->hash % (size_t)oSymTable->bucketCount);
+   while (*pLink != b) {
+      assert(*pLink != NULL);
+      pLink = &(*pLink)->next;
+   }
+   *pLink = b->next;
+   b->next = NULL;
+}
+
+/*
+ * Returns the seconds since the epoch.
+ */
+static unsigned long SymTable_wallClock(void *pvContext) {
+   (void) pvContext;
+
+   return (unsigned long) time(NULL);
+}
+
+/*
+ * Returns 1 if b, a Binding of oSymTable, has expired and 0 otherwise.
+ */
+static int SymTable_isExpired(SymTable_T oSymTable, struct Binding *b) {
+   assert(oSymTable != NULL);
+   assert(b != NULL);
+
+   return b->timer != NULL
+      && (*oSymTable->clock)(oSymTable->clockContext)
+         >= b->timer->deadline;
+}
+
+/*
+ * Takes the Timer of b, a Binding of oSymTable, if any, off the wheel
+ * and frees it.
+ */
+static void SymTable_dropTimer(SymTable_T oSymTable,
+                               struct Binding *b) {
+   struct Timer *psTimer;
+
+   assert(oSymTable != NULL);
+   assert(b != NULL);
+
+   psTimer = b->timer;
+   if (psTimer == NULL) {
+      return;
+   }
+   *psTimer->link = psTimer->next;
+   if (psTimer->next != NULL) {
+      psTimer->next->link = psTimer->link;
+   }
+   b->timer = NULL;
+   oSymTable->timerCount--;
+   SymTable_release(oSymTable, psTimer, sizeof(struct Timer));
+}
+
+/*
+ * Puts psTimer, which is on no list, into the slot of the wheel of
+ * oSymTable for its deadline, or for wheelTime if the deadline has
+ * already been swept past, so that it does not wait a whole turn.
+ */
+static void SymTable_schedule(SymTable_T oSymTable,
+                              struct Timer *psTimer) {
+   struct Timer **ppsSlot;
+
+   assert(oSymTable != NULL);
+   assert(psTimer != NULL);
+
+   ppsSlot = &oSymTable->wheel[((psTimer->deadline
+                                 < oSymTable->wheelTime)
+                                ? oSymTable->wheelTime
+                                : psTimer->deadline) % WHEEL_SLOTS];
+   psTimer->next = *ppsSlot;
+   psTimer->link = ppsSlot;
+   if (*ppsSlot != NULL) {
+      (*ppsSlot)->link = &psTimer->next;
+   }
+   *ppsSlot = psTimer;
+}
+
+/*
+ * Removes b, an expired Binding of oSymTable, calling the evict
+ * handler of oSymTable on it, if there is one, before freeing it.
+ */
+static void SymTable_expireBinding(SymTable_T oSymTable,
+                                   struct Binding *b) {
+   assert(oSymTable != NULL);
+   assert(b != NULL);
+
+   SymTable_unlink(oSymTable, b);
+   SymTable_dropTimer(oSymTable, b);
+   oSymTable->size--;
+   SymTable_filterRemoved(oSymTable);
+
+   if (oSymTable->evictHandler != NULL) {
+      (*oSymTable->evictHandler)(b->key, b->val,
+                                 oSymTable->evictExtra);
+   }
+   SymTable_release(oSymTable, b->key, b->length + 1);
+   SymTable_release(oSymTable, b, sizeof(struct Binding));
+}
+
+/*
+ * Returns the bucket of oSymTable that *psKey belongs in, reducing its
+ * hash code again only if the bucket count has changed since it was
+ * last reduced.
+ */
+static size_t SymTable_bucketOf(SymTable_T oSymTable,
+                                struct SymTableKey *psKey) {
+   assert(oSymTable != NULL);
+   assert(psKey != NULL);
+
+   if (psKey->bucketCount != (size_t)oSymTable->bucketCount) {
+      psKey->bucketCount = (size_t)oSymTable->bucketCount;
+      psKey->bucket = psKey->hash % psKey->bucketCount;
+   }
+   return psKey->bucket;
+}
+
+/*
+ * Returns 1 if b is the Binding of the uLength characters at pcKey,
+ * whose hash code is uHash, and 0 otherwise. The hash code and the
+ * length reject almost every other Binding, so the characters are
+ * compared only for the match, and with memcmp, which need not look
+ * for the end of either key.
+ */
+static int SymTable_matches(const struct Binding *b, size_t uHash,
+                            const char *pcKey, size_t uLength) {
+   assert(b != NULL);
+   assert(pcKey != NULL);
+
+   return b->hash == uHash && b->length == uLength
+      && memcmp(b->key, pcKey, uLength) == 0;
+}
+
+/*
+ * Returns the Binding of *psKey in oSymTable, or NULL if the key is
+ * absent. A Binding that has expired is removed, and the key treated
+ * as absent.
+ */
+static struct Binding *SymTable_find(SymTable_T oSymTable,
+                                     struct SymTableKey *psKey) {
+   struct Binding *current;
+
+   assert(oSymTable != NULL);
+   assert(psKey != NULL);
+
+   if (!SymTable_filterMayContain(oSymTable, psKey->hash)) {
+      return NULL;
+   }
+   SYMTABLE_COUNT(oSymTable, probes);
+
+   current = *SymTable_chain(oSymTable, psKey->hash,
+                             SymTable_bucketOf(oSymTable, psKey));
+   while (current != NULL) {
+      SYMTABLE_COUNT(oSymTable, compares);
+      if (SymTable_matches(current, psKey->hash, psKey->key,
+                           psKey->length)) {
+         if (current->timer != NULL
+             && SymTable_isExpired(oSymTable, current)) {
+            SymTable_expireBinding(oSymTable, current);
+            return NULL;
+         }
+         if (oSymTable->capacity != 0) {
+            current->referenced = 1;
+         }
+         return current;
+      }
+      current = current->next;
+   }
+
+   SymTable_filterMissed(oSymTable);
+   return NULL;
+}
+
+/*
+ * Makes room for one more entry in the undo log of oSymTable,
+ * doubling it if it is full. Returns 1 if successful and 0 if memory
+ * is insufficient.
+ */
+static int SymTable_reserveUndoLog(SymTable_T oSymTable) {
+   struct UndoEntry *newLog;
+   size_t uNewCapacity;
+
+   assert(oSymTable != NULL);
+
+   if (oSymTable->undoLength < oSymTable->undoCapacity) {
+      return 1;
+   }
+
+   uNewCapacity = (oSymTable->undoCapacity == 0)
+      ? UNDO_LOG_INITIAL : 2 * oSymTable->undoCapacity;
+   newLog = (struct UndoEntry *) SymTable_alloc(oSymTable,
+      uNewCapacity * sizeof(struct UndoEntry));
+   if (newLog == NULL) {
+      return 0;
+   }
+   if (oSymTable->undoLog != NULL) {
+      memcpy(newLog, oSymTable->undoLog,
+             oSymTable->undoLength * sizeof(struct UndoEntry));
+      SymTable_release(oSymTable, oSymTable->undoLog,
+         oSymTable->undoCapacity * sizeof(struct UndoEntry));
+   }
+   oSymTable->undoLog = newLog;
+   oSymTable->undoCapacity = uNewCapacity;
+   return 1;
+}
+
+/*
+ * Appends an entry of kind eKind for b, as it is before the change,
+ * to the undo log of oSymTable, which must have room for it.
+ */
+static void SymTable_logUndo(SymTable_T oSymTable, struct Binding *b,
+                             enum UndoKind eKind) {
+   struct UndoEntry *psEntry;
+
+   assert(oSymTable != NULL);
+   assert(b != NULL);
+   assert(oSymTable->undoLength < oSymTable->undoCapacity);
+
+   psEntry = &oSymTable->undoLog[oSymTable->undoLength++];
+   psEntry->binding = b;
+   psEntry->val = b->val;
+   psEntry->scope = b->scope;
+   psEntry->kind = eKind;
+}
+
+/*
+ * Prepares b, which SymTable_remove is about to take out of
+ * oSymTable, to be put back by SymTable_rollback or by the exit of
+ * the innermost scope. Returns 1 if successful and 0 if memory is
+ * insufficient.
+ */
+static int SymTable_logRemove(SymTable_T oSymTable, struct Binding *b) {
+   assert(oSymTable != NULL);
+   assert(b != NULL);
+
+   if (oSymTable->checkpointCount != 0) {
+      if (!SymTable_reserveUndoLog(oSymTable)) {
+         return 0;
+      }
+      SymTable_logUndo(oSymTable, b, UNDO_REMOVE);
+      return 1;
+   }
+
+   if (oSymTable->scopeDepth == 0
+       || b->scope == oSymTable->scopeDepth) {
+      return 1;
+   }
+   if (!SymTable_reserveUndoLog(oSymTable)) {
+      return 0;
+   }
+   SymTable_logUndo(oSymTable, b, UNDO_CHANGE);
+   b->scope = oSymTable->scopeDepth;
+   return 1;
+}
+
+/*
+ * Undoes the change of oSymTable that *psEntry records.
+ */
+static void SymTable_undo(SymTable_T oSymTable,
+                          const struct UndoEntry *psEntry) {
+   struct Binding *b;
+
+   assert(oSymTable != NULL);
+   assert(psEntry != NULL);
+
+   b = psEntry->binding;
+   if (psEntry->kind == UNDO_PUT) {
+      if (!b->hidden) {
+         SymTable_unlink(oSymTable, b);
+         oSymTable->size--;
+         SymTable_filterRemoved(oSymTable);
+      }
+      SymTable_release(oSymTable, b->key, b->length + 1);
+      SymTable_release(oSymTable, b, sizeof(struct Binding));
+      return;
+   }
+
+   if (b->hidden) {
+      SymTable_listPut(SymTable_chain(oSymTable, b->hash,
+         b->hash % (size_t)oSymTable->bucketCount), b);
+      b->hidden = 0;
+      oSymTable->size++;
+      SymTable_filterAdded(oSymTable, b->hash);
+   }
+   b->val = psEntry->val;
+   b->scope = psEntry->scope;
+}
+
+/*********************************************************************/
+
+/*
+ * Construct a new SymTable_T. Return NULL if memory is insufficient.
+ */
+SymTable_T SymTable_new(void) {
+   struct SymTableAllocator sMalloc;
+
+   SymTableMalloc_getAllocator(&sMalloc);
+   return SymTable_newWithAllocator(&sMalloc, NULL);
+}
+
+/*
+ * Construct a new SymTable_T that gets its memory from *psAllocator.
+ * Return NULL if memory is insufficient.
+ */
+SymTable_T SymTable_newWithAllocator(
+     const struct SymTableAllocator *psAllocator, void *pvContext) {
+   SymTable_T oSymTable;
+   struct Binding **buckets;
+
+   assert(psAllocator != NULL);
+   assert(psAllocator->pfAlloc != NULL);
+
+   /* allocate for st */
+   oSymTable = (SymTable_T)
+      (*psAllocator->pfAlloc)(pvContext, sizeof(struct SymTable));
+   if (oSymTable == NULL) {
+      return NULL;
+   }
+   oSymTable->allocator = *psAllocator;
+   oSymTable->context = pvContext;
+
+   /* allocate for buckets */
+   buckets =
+      (struct Binding**) SymTable_alloc(oSymTable,
+         (size_t)BUCKET_1 * sizeof(struct Binding *));
+   if (buckets == NULL) {
+      SymTable_release(oSymTable, oSymTable, sizeof(struct SymTable));
+      return NULL;
+   }
+   memset(buckets, 0, (size_t)BUCKET_1 * sizeof(struct Binding *));
+
+   oSymTable->buckets = buckets;
+   oSymTable->size = 0;
+   oSymTable->bucketCount = BUCKET_1;
+   oSymTable->oldBuckets = NULL;
+   oSymTable->oldBucketCount = BUCKET_1;
+   oSymTable->rehashIndex = 0;
+   memset(&oSymTable->filter, 0, sizeof(struct SymTableFilter));
+   oSymTable->scopeDepth = 0;
+   oSymTable->undoLog = NULL;
+   oSymTable->undoLength = 0;
+   oSymTable->undoCapacity = 0;
+   oSymTable->checkpoints = NULL;
+   oSymTable->checkpointCount = 0;
+   oSymTable->checkpointCapacity = 0;
+   oSymTable->capacity = 0;
+   oSymTable->clockHand = 0;
+   oSymTable->evictHandler = NULL;
+   oSymTable->evictExtra = NULL;
+   oSymTable->wheel = NULL;
+   oSymTable->wheelTime = 0;
+   oSymTable->sweepList = NULL;
+   oSymTable->timerCount = 0;
+   oSymTable->clock = SymTable_wallClock;
+   oSymTable->clockContext = NULL;
+#ifdef SYMTABLE_STATS
+   memset(&oSymTable->counters, 0, sizeof(struct SymTableCounters));
+#endif
+   
+   return oSymTable;
+}
+
+/*
+ * Frees all memory previously allocated for a SymTable_T
+ */
+void SymTable_free(SymTable_T oSymTable) {
+   struct Binding *previous;
+   struct Binding *current;
+   int i = 0;
+
+   assert(oSymTable != NULL);
+
+   /* the client releases the memory of such a table all at once */
+   if (oSymTable->allocator.pfFree == NULL) {
+      return;
+   }
+
+   /* puts the hidden Bindings back on their chains */
+   while (SymTable_exitScope(oSymTable)) {
+   }
+   while (SymTable_rollback(oSymTable)) {
+   }
+   SymTable_finishRehash(oSymTable);
+   while (oSymTable->sweepList != NULL) {
+      SymTable_dropTimer(oSymTable, oSymTable->sweepList->binding);
+   }
+   if (oSymTable->wheel != NULL) {
+      for (i = 0; i < WHEEL_SLOTS; i++) {
+         while (oSymTable->wheel[i] != NULL) {
+            SymTable_dropTimer(oSymTable,
+                               oSymTable->wheel[i]->binding);
+         }
+      }
+      SymTable_release(oSymTable, oSymTable->wheel,
+                       WHEEL_SLOTS * sizeof(struct Timer *));
+   }
+   if (oSymTable->undoLog != NULL) {
+      SymTable_release(oSymTable, oSymTable->undoLog,
+         oSymTable->undoCapacity * sizeof(struct UndoEntry));
+   }
+   if (oSymTable->checkpoints != NULL) {
+      SymTable_release(oSymTable, oSymTable->checkpoints,
+         oSymTable->checkpointCapacity * sizeof(size_t));
+   }
+
+   for (i = 0; i < (int)oSymTable->bucketCount; i++) {
+      if ((previous = oSymTable->buckets[i]) == NULL) {
+         continue;
+      }
+      current = previous->next;
+      while (current != NULL) {
+         SymTable_release(oSymTable, previous->key,
+                          previous->length + 1);
+         SymTable_release(oSymTable, previous, sizeof(struct Binding));
+         previous = current;
+         current = current->next;
+      }
+      SymTable_release(oSymTable, previous->key,
+                       previous->length + 1);
+      SymTable_release(oSymTable, previous, sizeof(struct Binding));
+   }
+   if (oSymTable->filter.bits != NULL) {
+      SymTable_release(oSymTable, oSymTable->filter.bits,
+                       oSymTable->filter.blockCount
+                       * FILTER_BLOCK_BYTES);
+   }
+   SymTable_release(oSymTable, oSymTable->buckets,
+      (size_t)oSymTable->bucketCount * sizeof(struct Binding *));
+   SymTable_release(oSymTable, oSymTable, sizeof(struct SymTable));
+}
+
+/*
+ * Returns a size_t specifying the number of bindings contained within 
+ * the specified SymTable_T.
+ */
+size_t SymTable_getLength(SymTable_T oSymTable) {
+   assert(oSymTable != NULL);
+   
+   return oSymTable->size;
+}
+
+/*
+ * Tries to insert a new key-value binding with a String key and 
+ * generic value into the specified SymTable_T. Returns 1 if successful
+ * and 0 if binding is already present or memory is insufficient.
+ */
+int SymTable_put(SymTable_T oSymTable,
+                 const char *pcKey, const void *pvValue) {
+   struct SymTableKey sKey;
+
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   sKey = SymTable_prepareKey(pcKey);
+   return SymTable_put_h(oSymTable, &sKey, pvValue);
+}
+
+/*
+ * If *pcKey is present as a key, its value is changed to *pcValue and 
+ * the old value is returned. Otherwise, NULL is returned.
+ */
+void *SymTable_replace(SymTable_T oSymTable,
+                       const char *pcKey, const void *pvValue) {
+   struct SymTableKey sKey;
+
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   sKey = SymTable_prepareKey(pcKey);
+   return SymTable_replace_h(oSymTable, &sKey, pvValue);
+}
+
+/*
+ * Returns 1 if pcKey is present and 0 otherwise.
+ */
+int SymTable_contains(SymTable_T oSymTable, const char *pcKey) {
+   struct SymTableKey sKey;
+
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   sKey = SymTable_prepareKey(pcKey);
+   return SymTable_contains_h(oSymTable, &sKey);
+}
+
+/*
+ * If pcKey is present, returns its associated value. Returns NULL 
+ * otherwise.
+ */
+void *SymTable_get(SymTable_T oSymTable, const char *pcKey) {
+   struct SymTableKey sKey;
+
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   sKey = SymTable_prepareKey(pcKey);
+   return SymTable_get_h(oSymTable, &sKey);
+}
+
+/*
+ * If pcKey is present, removes its binding and returns the associated 
+ * value. Returns NULL otherwise.
+ */
+void *SymTable_remove(SymTable_T oSymTable, const char *pcKey) {
+   struct SymTableKey sKey;
+
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   sKey = SymTable_prepareKey(pcKey);
+   return SymTable_remove_h(oSymTable, &sKey);
+}
+
+/*********************************************************************/
+
+/*
+ * Returns a SymTableKey for pcKey, hashing and measuring it once.
+ */
+struct SymTableKey SymTable_prepareKey(const char *pcKey) {
+   struct SymTableKey sKey;
+
+   assert(pcKey != NULL);
+
+   sKey.key = pcKey;
+   sKey.hash = SymTable_hashKey(pcKey, &sKey.length);
+   sKey.bucketCount = 0;
+   sKey.bucket = 0;
+   return sKey;
+}
+
+/*
+ * Removes one binding of oSymTable, which must not be empty, chosen
+ * by the CLOCK algorithm: the hand sweeps the buckets, giving each
+ * referenced binding it passes a second chance by clearing its bit,
+ * and evicts the first binding whose bit is already clear. Calls the
+ * evict handler of oSymTable, if any, on the binding before freeing
+ * it. Takes at most two sweeps of the buckets. Since the buckets
+ * never shrink, the hand passes about bucketCount / size of them per
+ * eviction: a constant while the table fills up to its capacity, but
+ * about bucketCount / capacity once SymTable_setCapacity lowers the
+ * capacity of a large table.
+ */
+static void SymTable_evict(SymTable_T oSymTable) {
+   struct Binding **pLink;
+   struct Binding *current;
+   size_t uHand;
+
+   assert(oSymTable != NULL);
+   assert(oSymTable->size != 0);
+   assert(oSymTable->scopeDepth == 0);
+   assert(oSymTable->checkpointCount == 0);
+
+   /* the hand sweeps only the current buckets */
+   SymTable_finishRehash(oSymTable);
+   uHand = oSymTable->clockHand % (size_t)oSymTable->bucketCount;
+   for (;;) {
+      pLink = &oSymTable->buckets[uHand];
+      while ((current = *pLink) != NULL) {
+         if (!current->referenced) {
+            *pLink = current->next;
+            oSymTable->size--;
+            SymTable_filterRemoved(oSymTable);
+            oSymTable->clockHand =
+               (uHand + 1) % (size_t)oSymTable->bucketCount;
+            SymTable_dropTimer(oSymTable, current);
+
+            if (oSymTable->evictHandler != NULL) {
+               (*oSymTable->evictHandler)(current->key, current->val,
+                                          oSymTable->evictExtra);
+            }
+            SymTable_release(oSymTable, current->key,
+                             current->length + 1);
+            SymTable_release(oSymTable, current,
+                             sizeof(struct Binding));
+            return;
+         }
+         current->referenced = 0;
+         pLink = &current->next;
+      }
+      uHand = (uHand + 1) % (size_t)oSymTable->bucketCount;
+   }
+}
+
+/*
+ * Evicts bindings of oSymTable until it holds no more than its
+ * capacity.
+ */
+static void SymTable_shrinkToCapacity(SymTable_T oSymTable) {
+   assert(oSymTable != NULL);
+
+   if (oSymTable->capacity == 0) {
+      return;
+   }
+   while (oSymTable->size > oSymTable->capacity) {
+      SymTable_evict(oSymTable);
+   }
+}
+
+/*
+ * Tries to insert a binding of *psKey and pvValue into oSymTable, or,
+ * in an open scope, to shadow the binding of an enclosing scope.
+ * Returns the Binding if successful and NULL if the key is already
+ * present or memory is insufficient.
+ */
+static struct Binding *SymTable_insert(SymTable_T oSymTable,
+                                       struct SymTableKey *psKey,
+                                       const void *pvValue) {
+   char *keyCopy;
+   struct Binding *newBind;
+
+   assert(oSymTable != NULL);
+   assert(psKey != NULL);
+   assert(psKey->key != NULL);
+   
+   SymTable_rehashStep(oSymTable, REHASH_STEP);
+   newBind = SymTable_find(oSymTable, psKey);
+   if (newBind != NULL) {
+      /* a key of an enclosing scope is shadowed */
+      if (oSymTable->scopeDepth == 0
+          || newBind->scope == oSymTable->scopeDepth
+          || !SymTable_reserveUndoLog(oSymTable)) {
+         return NULL;
+      }
+      SymTable_logUndo(oSymTable, newBind, UNDO_CHANGE);
+      newBind->val = (void *) pvValue;
+      newBind->scope = oSymTable->scopeDepth;
+      return newBind;
+   }
+   if ((oSymTable->scopeDepth != 0 || oSymTable->checkpointCount != 0)
+       && !SymTable_reserveUndoLog(oSymTable)) {
+      return NULL;
+   }
+   newBind = (struct Binding*)SymTable_alloc(oSymTable,
+                                             sizeof(struct Binding));
+   if (newBind == NULL) {
+      return NULL;
+   }
+   newBind->next = NULL;
+
+   /* Duplicate key */
+   keyCopy = (char *) SymTable_alloc(oSymTable, psKey->length + 1);
+   if (keyCopy == NULL) {
+      SymTable_release(oSymTable, newBind, sizeof(struct Binding));
+      return NULL;
+   }
+   memcpy(keyCopy, psKey->key, psKey->length + 1);
+
+   /* make room only once the insertion cannot fail */
+   if (oSymTable->capacity != 0
+       && oSymTable->size >= oSymTable->capacity) {
+      SymTable_evict(oSymTable);
+   }
+   
+   /* put key in */
+   newBind->key = keyCopy;
+   newBind->val = (void *) pvValue;
+   newBind->hash = psKey->hash;
+   newBind->length = psKey->length;
+   newBind->scope = oSymTable->scopeDepth;
+   newBind->hidden = 0;
+   newBind->referenced = 0;
+   newBind->timer = NULL;
+   if (oSymTable->scopeDepth != 0 || oSymTable->checkpointCount != 0) {
+      SymTable_logUndo(oSymTable, newBind, UNDO_PUT);
+   }
+
+   SymTable_listPut(SymTable_chain(oSymTable, psKey->hash,
+                       SymTable_bucketOf(oSymTable, psKey)), newBind);
+   oSymTable->size++;
+   SymTable_filterAdded(oSymTable, psKey->hash);
+
+   if ((int) oSymTable->size > (int) oSymTable->bucketCount) {
+      SymTable_expand(oSymTable, oSymTable->size);
+   }
    
-   current = oSymTable->buckets[index];
-   while (current != NULL) {
-      if (strcmp(pcKey, current->key) == 0) {
-         return current->val;
+   return newBind;
+}
+
+/*
+ * Tries to insert a binding of *psKey and pvValue into oSymTable.
+ * Returns 1 if successful and 0 if the key is already present or
+ * memory is insufficient.
+ */
+int SymTable_put_h(SymTable_T oSymTable, struct SymTableKey *psKey,
+                   const void *pvValue) {
+   assert(oSymTable != NULL);
+   assert(psKey != NULL);
+   assert(psKey->key != NULL);
+
+   return SymTable_insert(oSymTable, psKey, pvValue) != NULL;
+}
+
+/*
+ * If *psKey is present in oSymTable, changes its value to pvValue and
+ * returns the old value. Otherwise, returns NULL.
+ */
+void *SymTable_replace_h(SymTable_T oSymTable,
+                         struct SymTableKey *psKey,
+                         const void *pvValue) {
+   struct Binding *current;
+   void *oldVal;
+   
+   assert(oSymTable != NULL);
+   assert(psKey != NULL);
+   assert(psKey->key != NULL);
+
+   current = SymTable_find(oSymTable, psKey);
+   if (current == NULL) {
+      return NULL;
+   }
+   if (oSymTable->checkpointCount != 0) {
+      if (!SymTable_reserveUndoLog(oSymTable)) {
+         return NULL;
       }
-      current = current->next;
+      SymTable_logUndo(oSymTable, current, UNDO_CHANGE);
    }
 
-   return NULL;
+   /* change value */
+   oldVal = current->val;
+   current->val = (void *) pvValue;
+
+   return oldVal;
 }
 
 /*
- * If pcKey is present, removes its binding and returns the associated 
- * value. Returns NULL otherwise.
+ * Returns 1 if *psKey is present in oSymTable and 0 otherwise.
  */
-void *SymTable_remove(SymTable_T oSymTable, const char *pcKey) {
-   struct Binding *previous;
+int SymTable_contains_h(SymTable_T oSymTable,
+                        struct SymTableKey *psKey) {
+   assert(oSymTable != NULL);
+   assert(psKey != NULL);
+   assert(psKey->key != NULL);
+
+   return SymTable_find(oSymTable, psKey) != NULL;
+}
+
+/*
+ * If *psKey is present in oSymTable, returns its value. Returns NULL
+ * otherwise.
+ */
+void *SymTable_get_h(SymTable_T oSymTable, struct SymTableKey *psKey) {
    struct Binding *current;
-   void *removedValue;
-   int index;
 
    assert(oSymTable != NULL);
-   assert(pcKey != NULL);
-
-   index = (int)(SymTable_hash(pcKey, (size_t)oSymTable->bucketCount))
-      % (int)oSymTable->bucketCount;
+   assert(psKey != NULL);
+   assert(psKey->key != NULL);
 
-   current = oSymTable->buckets[index];
-   /* if not present */
-   if (!current) {
+   current = SymTable_find(oSymTable, psKey);
+   if (current == NULL) {
       return NULL;
    }
-   /* if first */
-   if (strcmp(current->key, pcKey) == 0) {
-      removedValue = current->val;
-      oSymTable->buckets[index] = current->next;
+   return current->val;
+}
+
+/*
+ * If *psKey is present in oSymTable, removes its binding and returns
+ * its value. Returns NULL otherwise.
+ */
+void *SymTable_remove_h(SymTable_T oSymTable,
+                        struct SymTableKey *psKey) {
+   struct Binding **pLink;
+   struct Binding *current;
+   void *removedValue;
 
-      free(current->key);
-      free(current);
-      current = NULL;
+   assert(oSymTable != NULL);
+   assert(psKey != NULL);
+   assert(psKey->key != NULL);
 
-      oSymTable->size--;
-      return removedValue;
+   SymTable_rehashStep(oSymTable, REHASH_STEP);
+   if (!SymTable_filterMayContain(oSymTable, psKey->hash)) {
+      return NULL;
    }
-   /* in a linked list of collided Bindings */
-   previous = current;
-   current = current->next;
-   while(current != NULL) {
-      if (strcmp(current->key, pcKey) == 0) {
+   SYMTABLE_COUNT(oSymTable, probes);
+
+   pLink = SymTable_chain(oSymTable, psKey->hash,
+                          SymTable_bucketOf(oSymTable, psKey));
+   while (*pLink != NULL) {
+      current = *pLink;
+      SYMTABLE_COUNT(oSymTable, compares);
+      if (SymTable_matches(current, psKey->hash, psKey->key,
+                           psKey->length)) {
+         if (current->timer != NULL
+             && SymTable_isExpired(oSymTable, current)) {
+            SymTable_expireBinding(oSymTable, current);
+            return NULL;
+         }
+         if (!SymTable_logRemove(oSymTable, current)) {
+            return NULL;
+         }
          removedValue = current->val;
-         previous->next = current->next;
-
-         free(current->key);
-         free(current);
-         current = NULL;
+         *pLink = current->next;
+
+         if (current->scope != 0
+             || oSymTable->checkpointCount != 0) {
+            /* the undo log refers to it */
+            current->next = NULL;
+            current->hidden = 1;
+         }
+         else {
+            SymTable_dropTimer(oSymTable, current);
+            SymTable_release(oSymTable, current->key,
+                             psKey->length + 1);
+            SymTable_release(oSymTable, current,
+                             sizeof(struct Binding));
+         }
 
          oSymTable->size--;
+         SymTable_filterRemoved(oSymTable);
          return removedValue;
       }
-
-      previous = current;
-      current = current->next;
+      pLink = &current->next;
    }
 
+   SymTable_filterMissed(oSymTable);
    return NULL;
 }
 
+/*
+ * Tries to insert a binding of pcKey and pvValue into oSymTable, as
+ * SymTable_put does. Returns a handle to the binding if successful
+ * and NULL if pcKey is already present or memory is insufficient.
+ */
+SymTableHandle_T SymTable_putHandle(SymTable_T oSymTable,
+                                    const char *pcKey,
+                                    const void *pvValue) {
+   struct SymTableKey sKey;
+
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   sKey = SymTable_prepareKey(pcKey);
+   return SymTable_insert(oSymTable, &sKey, pvValue);
+}
+
+/*
+ * Returns the value of the binding that oHandle refers to.
+ */
+void *SymTable_handleGet(SymTableHandle_T oHandle) {
+   assert(oHandle != NULL);
+   assert(! oHandle->hidden);
+
+   oHandle->referenced = 1;
+   return oHandle->val;
+}
+
+/*
+ * Changes the value of the binding of oSymTable that oHandle refers to
+ * to pvValue, and returns the old value. Returns NULL, leaving the
+ * value unchanged, if memory for the undo log is insufficient.
+ */
+void *SymTable_handleSet(SymTable_T oSymTable, SymTableHandle_T oHandle,
+                         const void *pvValue) {
+   void *oldVal;
+
+   assert(oSymTable != NULL);
+   assert(oHandle != NULL);
+   assert(! oHandle->hidden);
+
+   if (oSymTable->checkpointCount != 0) {
+      if (!SymTable_reserveUndoLog(oSymTable)) {
+         return NULL;
+      }
+      SymTable_logUndo(oSymTable, oHandle, UNDO_CHANGE);
+   }
+
+   oldVal = oHandle->val;
+   oHandle->val = (void *) pvValue;
+   oHandle->referenced = 1;
+   return oldVal;
+}
+
+/*********************************************************************/
+
 /*
  * Applies (*pfApply) to all bindings in the symbol table, passing 
  * *pvExtra as a parameter.
@@ -483,6 +1662,7 @@ void SymTable_map(SymTable_T oSymTable,
    assert(oSymTable != NULL);
    assert(pfApply != NULL);
 
+   SymTable_finishRehash(oSymTable);
    for (; i < (int)oSymTable->bucketCount; i++) {
       current = oSymTable->buckets[i];
 
@@ -493,6 +1673,540 @@ void SymTable_map(SymTable_T oSymTable,
    }
 }
 
+/*
+ * Moves the bindings of oSrc into oDst without copying them, settling
+ * each key present in both as ePolicy says. Tables with different
+ * allocators cannot share nodes, so their bindings are copied
+ * instead. Returns the number of bindings moved into oDst.
+ */
+size_t SymTable_merge(SymTable_T oDst, SymTable_T oSrc,
+                      enum SymTableMergePolicy ePolicy) {
+   struct Binding *current;
+   struct Binding *next;
+   struct Binding *match;
+   struct Binding **pLink;
+   struct Binding *kept;
+   void *oldVal;
+   struct SymTableKey sKey;
+   size_t uMoved = 0;
+   int index;
+   int i;
+
+   assert(oDst != NULL);
+   assert(oSrc != NULL);
+   assert(oDst != oSrc);
+   assert(oDst->scopeDepth == 0 && oDst->checkpointCount == 0);
+   assert(oSrc->scopeDepth == 0 && oSrc->checkpointCount == 0);
+   assert(oDst->timerCount == 0 && oSrc->timerCount == 0);
+   assert(ePolicy == SYMTABLE_MERGE_KEEP_DST
+          || ePolicy == SYMTABLE_MERGE_TAKE_SRC);
+
+   SymTable_finishRehash(oSrc);
+
+   /* grow once, rather than as each binding arrives */
+   SymTable_expand(oDst, oDst->size + oSrc->size);
+   SymTable_finishRehash(oDst);
+
+   if (oDst->allocator.pfAlloc != oSrc->allocator.pfAlloc
+       || oDst->allocator.pfFree != oSrc->allocator.pfFree
+       || oDst->context != oSrc->context) {
+      for (i = 0; i < (int)oSrc->bucketCount; i++) {
+         for (current = oSrc->buckets[i]; current != NULL;
+              current = next) {
+            next = current->next;
+            sKey = SymTable_prepareKey(current->key);
+            if (SymTable_put_h(oDst, &sKey, current->val)) {
+               SymTable_remove_h(oSrc, &sKey);
+               uMoved++;
+            }
+            else if (ePolicy == SYMTABLE_MERGE_TAKE_SRC
+                     && SymTable_contains_h(oDst, &sKey)) {
+               oldVal = SymTable_replace_h(oDst, &sKey,
+                                           current->val);
+               current->val = oldVal;
+               uMoved++;
+            }
+         }
+      }
+      return uMoved;
+   }
+
+   for (i = 0; i < (int)oSrc->bucketCount; i++) {
+      kept = NULL;
+      for (current = oSrc->buckets[i]; current != NULL;
+           current = next) {
+         next = current->next;
+         current->next = NULL;
+
+         /* find the key in oDst, or the end of its chain */
+         index = (int)(current->hash % (size_t)oDst->bucketCount);
+         for (pLink = &oDst->buckets[index]; (match = *pLink) != NULL;
+              pLink = &match->next) {
+            if (SymTable_matches(match, current->hash, current->key,
+                                 current->length)) {
+               break;
+            }
+         }
+
+         if (match == NULL) {
+            *pLink = current;
+            oDst->size++;
+            oSrc->size--;
+            SymTable_filterAdded(oDst, current->hash);
+            uMoved++;
+         }
+         else if (ePolicy == SYMTABLE_MERGE_TAKE_SRC) {
+            /* the nodes trade places */
+            current->next = match->next;
+            *pLink = current;
+            match->next = kept;
+            kept = match;
+            uMoved++;
+         }
+         else {
+            current->next = kept;
+            kept = current;
+         }
+      }
+      oSrc->buckets[i] = kept;
+   }
+
+   /* rebuilt only now that the chains of oSrc are whole again */
+   if (oSrc->filter.bits != NULL && uMoved > 0) {
+      SymTable_filterBuild(oSrc, oSrc->filter.capacity);
+   }
+   SymTable_shrinkToCapacity(oDst);
+   return uMoved;
+}
+
+/*
+ * Gives oSymTable a filter for fast negative lookups. Returns 1 if
+ * successful and 0 if memory is insufficient.
+ */
+int SymTable_enableFilter(SymTable_T oSymTable) {
+   assert(oSymTable != NULL);
+
+   if (oSymTable->filter.bits != NULL) {
+      return 1;
+   }
+   return SymTable_filterBuild(oSymTable,
+                               (size_t)oSymTable->bucketCount);
+}
+
+/*
+ * Frees the filter of oSymTable, if any.
+ */
+void SymTable_disableFilter(SymTable_T oSymTable) {
+   assert(oSymTable != NULL);
+
+   if (oSymTable->filter.bits == NULL) {
+      return;
+   }
+   SymTable_release(oSymTable, oSymTable->filter.bits,
+                    oSymTable->filter.blockCount * FILTER_BLOCK_BYTES);
+   memset(&oSymTable->filter, 0, sizeof(struct SymTableFilter));
+}
+
+/*
+ * Limits oSymTable to uCapacity bindings, or lifts the limit if
+ * uCapacity is 0, evicting bindings at once if it holds more.
+ */
+void SymTable_setCapacity(SymTable_T oSymTable, size_t uCapacity) {
+   assert(oSymTable != NULL);
+   assert(oSymTable->scopeDepth == 0);
+   assert(oSymTable->checkpointCount == 0);
+
+   oSymTable->capacity = uCapacity;
+   SymTable_shrinkToCapacity(oSymTable);
+}
+
+/*
+ * Makes oSymTable call (*pfEvict) on each binding it evicts, passing
+ * pvExtra as a parameter, or call nothing if pfEvict is NULL.
+ */
+void SymTable_setEvictHandler(SymTable_T oSymTable,
+     void (*pfEvict)(const char *pcKey, void *pvValue, void *pvExtra),
+     const void *pvExtra) {
+   assert(oSymTable != NULL);
+
+   oSymTable->evictHandler = pfEvict;
+   oSymTable->evictExtra = (void *) pvExtra;
+}
+
+/*
+ * Makes oSymTable tell time by (*pfNow), passing pvContext as a
+ * parameter, or by the wall clock if pfNow is NULL.
+ */
+void SymTable_setClock(SymTable_T oSymTable,
+                       unsigned long (*pfNow)(void *pvContext),
+                       void *pvContext) {
+   assert(oSymTable != NULL);
+   assert(oSymTable->timerCount == 0);
+
+   oSymTable->clock = (pfNow == NULL) ? SymTable_wallClock : pfNow;
+   oSymTable->clockContext = pvContext;
+}
+
+/*
+ * Tries to insert a binding of pcKey and pvValue into oSymTable that
+ * expires ulSeconds from now. Returns 1 if successful and 0 if pcKey
+ * is already present or memory is insufficient.
+ */
+int SymTable_putWithTTL(SymTable_T oSymTable, const char *pcKey,
+                        const void *pvValue, unsigned long ulSeconds) {
+   struct SymTableKey sKey;
+   struct Timer *psTimer;
+   struct Binding *newBind;
+   unsigned long ulNow;
+   int i;
+
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+   assert(oSymTable->scopeDepth == 0);
+   assert(oSymTable->checkpointCount == 0);
+
+   ulNow = (*oSymTable->clock)(oSymTable->clockContext);
+   if (oSymTable->wheel == NULL) {
+      oSymTable->wheel = (struct Timer **) SymTable_alloc(oSymTable,
+         WHEEL_SLOTS * sizeof(struct Timer *));
+      if (oSymTable->wheel == NULL) {
+         return 0;
+      }
+      for (i = 0; i < WHEEL_SLOTS; i++) {
+         oSymTable->wheel[i] = NULL;
+      }
+      oSymTable->wheelTime = ulNow;
+   }
+
+   psTimer = (struct Timer *) SymTable_alloc(oSymTable,
+                                             sizeof(struct Timer));
+   if (psTimer == NULL) {
+      return 0;
+   }
+   sKey = SymTable_prepareKey(pcKey);
+   newBind = SymTable_insert(oSymTable, &sKey, pvValue);
+   if (newBind == NULL) {
+      SymTable_release(oSymTable, psTimer, sizeof(struct Timer));
+      return 0;
+   }
+
+   psTimer->binding = newBind;
+   psTimer->deadline = ulNow + ulSeconds;
+   SymTable_schedule(oSymTable, psTimer);
+   newBind->timer = psTimer;
+   oSymTable->timerCount++;
+   return 1;
+}
+
+/*
+ * Sweeps the slots of the timer wheel of oSymTable up to the present,
+ * removing the bindings that have expired, until it has done
+ * uMaxWork units of work. Returns the number of bindings removed.
+ */
+size_t SymTable_expire(SymTable_T oSymTable, size_t uMaxWork) {
+   struct Timer *psTimer;
+   struct Timer **ppsSlot;
+   unsigned long ulNow;
+   size_t uExpired = 0;
+   size_t uWork = 0;
+
+   assert(oSymTable != NULL);
+
+   if (oSymTable->timerCount == 0) {
+      return 0;
+   }
+
+   /* one turn of the wheel visits every slot */
+   ulNow = (*oSymTable->clock)(oSymTable->clockContext);
+   if (ulNow >= oSymTable->wheelTime
+       && ulNow - oSymTable->wheelTime >= WHEEL_SLOTS) {
+      oSymTable->wheelTime = ulNow - (WHEEL_SLOTS - 1);
+   }
+
+   while (uWork < uMaxWork) {
+      uWork++;
+      psTimer = oSymTable->sweepList;
+      if (psTimer == NULL) {
+         if (oSymTable->wheelTime > ulNow) {
+            break;
+         }
+         /* take all of the next slot, so that a call that runs out
+            of work leaves its remaining Timers where the next call
+            resumes */
+         ppsSlot =
+            &oSymTable->wheel[oSymTable->wheelTime % WHEEL_SLOTS];
+         oSymTable->sweepList = *ppsSlot;
+         if (*ppsSlot != NULL) {
+            (*ppsSlot)->link = &oSymTable->sweepList;
+            *ppsSlot = NULL;
+         }
+         oSymTable->wheelTime++;
+      }
+      else if (psTimer->deadline <= ulNow) {
+         SymTable_expireBinding(oSymTable, psTimer->binding);
+         uExpired++;
+      }
+      else {
+         /* due on a later turn of the wheel */
+         oSymTable->sweepList = psTimer->next;
+         if (psTimer->next != NULL) {
+            psTimer->next->link = &oSymTable->sweepList;
+         }
+         SymTable_schedule(oSymTable, psTimer);
+      }
+   }
+
+   return uExpired;
+}
+
+/*
+ * Opens a new innermost scope of oSymTable.
+ */
+void SymTable_enterScope(SymTable_T oSymTable) {
+   assert(oSymTable != NULL);
+   assert(oSymTable->scopeDepth < UINT_MAX);
+   assert(oSymTable->checkpointCount == 0);
+   assert(oSymTable->capacity == 0);
+   assert(oSymTable->timerCount == 0);
+
+   oSymTable->scopeDepth++;
+}
+
+/*
+ * Closes the innermost scope of oSymTable, undoing its puts and
+ * removes. Returns 1 if successful and 0 if no scope is open.
+ */
+int SymTable_exitScope(SymTable_T oSymTable) {
+   struct UndoEntry *psEntry;
+
+   assert(oSymTable != NULL);
+
+   if (oSymTable->scopeDepth == 0) {
+      return 0;
+   }
+
+   /* the entries of the innermost scope are the ones on top whose
+      Bindings it still owns */
+   while (oSymTable->undoLength > 0) {
+      psEntry = &oSymTable->undoLog[oSymTable->undoLength - 1];
+      if (psEntry->binding->scope != oSymTable->scopeDepth) {
+         break;
+      }
+      oSymTable->undoLength--;
+      SymTable_undo(oSymTable, psEntry);
+   }
+
+   oSymTable->scopeDepth--;
+   return 1;
+}
+
+/*
+ * Returns the number of scopes of oSymTable that are open.
+ */
+size_t SymTable_getScopeDepth(SymTable_T oSymTable) {
+   assert(oSymTable != NULL);
+
+   return (size_t)oSymTable->scopeDepth;
+}
+
+/*
+ * Begins a transaction of oSymTable, nested in any that are open.
+ * Returns 1 if successful and 0 if memory is insufficient.
+ */
+int SymTable_begin(SymTable_T oSymTable) {
+   size_t *newCheckpoints;
+   size_t uNewCapacity;
+
+   assert(oSymTable != NULL);
+   assert(oSymTable->scopeDepth == 0);
+   assert(oSymTable->capacity == 0);
+   assert(oSymTable->timerCount == 0);
+
+   if (oSymTable->checkpointCount == oSymTable->checkpointCapacity) {
+      uNewCapacity = (oSymTable->checkpointCapacity == 0)
+         ? CHECKPOINTS_INITIAL : 2 * oSymTable->checkpointCapacity;
+      newCheckpoints = (size_t *) SymTable_alloc(oSymTable,
+         uNewCapacity * sizeof(size_t));
+      if (newCheckpoints == NULL) {
+         return 0;
+      }
+      if (oSymTable->checkpoints != NULL) {
+         memcpy(newCheckpoints, oSymTable->checkpoints,
+                oSymTable->checkpointCount * sizeof(size_t));
+         SymTable_release(oSymTable, oSymTable->checkpoints,
+            oSymTable->checkpointCapacity * sizeof(size_t));
+      }
+      oSymTable->checkpoints = newCheckpoints;
+      oSymTable->checkpointCapacity = uNewCapacity;
+   }
+
+   oSymTable->checkpoints[oSymTable->checkpointCount++] =
+      oSymTable->undoLength;
+   return 1;
+}
+
+/*
+ * Undoes the changes of the innermost transaction of oSymTable and
+ * ends it. Returns 1 if successful and 0 if no transaction is open.
+ */
+int SymTable_rollback(SymTable_T oSymTable) {
+   size_t uCheckpoint;
+
+   assert(oSymTable != NULL);
+
+   if (oSymTable->checkpointCount == 0) {
+      return 0;
+   }
+
+   uCheckpoint = oSymTable->checkpoints[--oSymTable->checkpointCount];
+   while (oSymTable->undoLength > uCheckpoint) {
+      oSymTable->undoLength--;
+      SymTable_undo(oSymTable,
+                    &oSymTable->undoLog[oSymTable->undoLength]);
+   }
+   return 1;
+}
+
+/*
+ * Keeps the changes of the innermost transaction of oSymTable and
+ * ends it. Returns 1 if successful and 0 if no transaction is open.
+ */
+int SymTable_commit(SymTable_T oSymTable) {
+   struct UndoEntry *psEntry;
+   size_t u;
+
+   assert(oSymTable != NULL);
+
+   if (oSymTable->checkpointCount == 0) {
+      return 0;
+   }
+
+   /* an enclosing transaction may still undo the changes */
+   if (--oSymTable->checkpointCount != 0) {
+      return 1;
+   }
+
+   for (u = 0; u < oSymTable->undoLength; u++) {
+      psEntry = &oSymTable->undoLog[u];
+      if (psEntry->kind == UNDO_REMOVE) {
+         SymTable_release(oSymTable, psEntry->binding->key,
+                          psEntry->binding->length + 1);
+         SymTable_release(oSymTable, psEntry->binding,
+                          sizeof(struct Binding));
+      }
+   }
+   oSymTable->undoLength = 0;
+   return 1;
+}
+
+/*
+ * Fills in *psMemory with the memory that oSymTable holds. The
+ * filter, if any, is counted with the bucket array, and the undo
+ * log and checkpoints with the table.
+ */
+void SymTable_memoryUsage(SymTable_T oSymTable,
+                          struct SymTableMemory *psMemory) {
+   struct Binding *current;
+   size_t uKeyBytes;
+   int i = 0;
+
+   assert(oSymTable != NULL);
+   assert(psMemory != NULL);
+
+   SymTable_finishRehash(oSymTable);
+
+   psMemory->table = sizeof(struct SymTable)
+      + oSymTable->undoCapacity * sizeof(struct UndoEntry)
+      + oSymTable->checkpointCapacity * sizeof(size_t)
+      + ((oSymTable->wheel == NULL)
+         ? 0 : WHEEL_SLOTS * sizeof(struct Timer *));
+   psMemory->buckets =
+      (size_t)oSymTable->bucketCount * sizeof(struct Binding *)
+      + oSymTable->filter.blockCount * FILTER_BLOCK_BYTES;
+   psMemory->nodes = oSymTable->size * sizeof(struct Binding)
+      + oSymTable->timerCount * sizeof(struct Timer);
+   psMemory->keys = 0;
+   psMemory->slack =
+      SymTable_allocSlack(oSymTable, sizeof(struct SymTable))
+      + ((oSymTable->undoLog == NULL) ? 0 : SymTable_allocSlack(
+            oSymTable,
+            oSymTable->undoCapacity * sizeof(struct UndoEntry)))
+      + ((oSymTable->checkpoints == NULL) ? 0 : SymTable_allocSlack(
+            oSymTable,
+            oSymTable->checkpointCapacity * sizeof(size_t)))
+      + SymTable_allocSlack(oSymTable,
+         (size_t)oSymTable->bucketCount * sizeof(struct Binding *))
+      + ((oSymTable->filter.bits == NULL) ? 0 : SymTable_allocSlack(
+            oSymTable,
+            oSymTable->filter.blockCount * FILTER_BLOCK_BYTES))
+      + ((oSymTable->wheel == NULL) ? 0 : SymTable_allocSlack(
+            oSymTable, WHEEL_SLOTS * sizeof(struct Timer *)))
+      + oSymTable->size
+         * SymTable_allocSlack(oSymTable, sizeof(struct Binding))
+      + oSymTable->timerCount
+         * SymTable_allocSlack(oSymTable, sizeof(struct Timer));
+
+   for (; i < (int)oSymTable->bucketCount; i++) {
+      for (current = oSymTable->buckets[i]; current != NULL;
+           current = current->next) {
+         uKeyBytes = current->length + 1;
+         psMemory->keys += uKeyBytes;
+         psMemory->slack += SymTable_allocSlack(oSymTable, uKeyBytes);
+      }
+   }
+   psMemory->total = psMemory->table + psMemory->buckets
+      + psMemory->nodes + psMemory->keys + psMemory->slack;
+}
+
+/*
+ * Fills in *psStats for oSymTable.
+ */
+void SymTable_getStats(SymTable_T oSymTable,
+                       struct SymTableStats *psStats) {
+   struct Binding *current;
+   size_t uChainLength;
+   int i = 0;
+
+   assert(oSymTable != NULL);
+   assert(psStats != NULL);
+
+   SymTable_finishRehash(oSymTable);
+
+   memset(psStats, 0, sizeof(struct SymTableStats));
+   psStats->bucketCount = (size_t)oSymTable->bucketCount;
+   psStats->loadFactor =
+      (double)oSymTable->size / (double)oSymTable->bucketCount;
+
+   for (; i < (int)oSymTable->bucketCount; i++) {
+      uChainLength = 0;
+      for (current = oSymTable->buckets[i]; current != NULL;
+           current = current->next) {
+         uChainLength++;
+      }
+      if (uChainLength > psStats->longestChain) {
+         psStats->longestChain = uChainLength;
+      }
+      if (uChainLength >= SYMTABLE_CHAIN_HISTOGRAM_SIZE) {
+         uChainLength = SYMTABLE_CHAIN_HISTOGRAM_SIZE - 1;
+      }
+      psStats->chainHistogram[uChainLength]++;
+   }
+
+   psStats->filterEnabled = (oSymTable->filter.bits != NULL);
+   psStats->filterBytes =
+      oSymTable->filter.blockCount * FILTER_BLOCK_BYTES;
+   psStats->filterRejects = oSymTable->filter.rejects;
+   psStats->filterFalsePositives = oSymTable->filter.falsePositives;
+
+#ifdef SYMTABLE_STATS
+   psStats->countersEnabled = 1;
+   psStats->probes = oSymTable->counters.probes;
+   psStats->compares = oSymTable->counters.compares;
+   psStats->expansions = oSymTable->counters.expansions;
+   psStats->expansionSeconds = oSymTable->counters.expansionSeconds;
+#endif
+}
+
 /*********************************************************************/
 
 #ifdef DEBUG
@@ -0,0 +1,341 @@
+/*********************************************************************/
+/* symtablehash.h                                                    */
+/* COS 217 Assignment 3: A Symbol Table ADT                          */
+/* Date: 10/31/2023                                                  */
+/* Author: Hugh Peterson                                             */
+/* Description: Operations that only the hash table implementation  */
+/*              of the symbol table module (symtablehash.c) provides */
+/*********************************************************************/
+
+/*********************************************************************/
+
+#ifndef SYMTABLEHASH_INCLUDED
+#define SYMTABLEHASH_INCLUDED
+
+#include <stddef.h>
+#include "symtable.h"
+
+/*********************************************************************/
+
+enum {
+   /* number of entries in a chain-length histogram; the last entry
+      counts every chain at least that long */
+   SYMTABLE_CHAIN_HISTOGRAM_SIZE = 16
+};
+
+/*
+ * A snapshot of the shape of a hash table and of the work it has
+ * done since it was created.
+ */
+struct SymTableStats {
+   /* number of buckets */
+   size_t bucketCount;
+
+   /* number of bindings per bucket */
+   double loadFactor;
+
+   /* chainHistogram[i] is the number of buckets holding i bindings */
+   size_t chainHistogram[SYMTABLE_CHAIN_HISTOGRAM_SIZE];
+
+   /* number of bindings in the longest chain */
+   size_t longestChain;
+
+   /* 1 if the counters below are maintained (the module was compiled
+      with -DSYMTABLE_STATS) and 0 if they are always 0 */
+   int countersEnabled;
+
+   /* number of buckets searched for a key */
+   size_t probes;
+
+   /* number of key comparisons made while searching */
+   size_t compares;
+
+   /* number of times the bucket array was grown */
+   size_t expansions;
+
+   /* total seconds spent growing the bucket array */
+   double expansionSeconds;
+
+   /* 1 if the table has a filter (see SymTable_enableFilter) and 0
+      if the filter fields below are 0 */
+   int filterEnabled;
+
+   /* bytes of the filter */
+   size_t filterBytes;
+
+   /* number of lookups of absent keys the filter answered alone */
+   size_t filterRejects;
+
+   /* number of lookups of absent keys the filter let through; with
+      filterRejects, gives the false-positive rate */
+   size_t filterFalsePositives;
+};
+
+/*
+ * A key whose hash code SymTable_prepareKey has computed, so that the
+ * _h operations below need not hash it again. Its bucket is also
+ * remembered for the bucket count it was last reduced to. The key
+ * string must not change while the SymTableKey is in use.
+ */
+struct SymTableKey {
+   /* the key */
+   const char *key;
+
+   /* number of characters of key, not counting the '\0' */
+   size_t length;
+
+   /* full hash code of key */
+   size_t hash;
+
+   /* bucket count that bucket was computed for, or 0 if none was */
+   size_t bucketCount;
+
+   /* hash % bucketCount */
+   size_t bucket;
+};
+
+/*
+ * A SymTableHandle_T refers to one binding of a hash table. It stays
+ * valid while the bucket array grows, since bindings never move, and
+ * until the binding is removed, whether by SymTable_remove, by
+ * SymTable_exitScope or SymTable_rollback, by SymTable_merge, which
+ * moves bindings out of oSrc, by eviction (see SymTable_setCapacity),
+ * by expiry (see SymTable_putWithTTL), or by SymTable_free. A handle
+ * follows its binding when SymTable_merge moves it without copying:
+ * a handle to a binding of oSrc then refers to a binding of oDst,
+ * and under SYMTABLE_MERGE_TAKE_SRC, a handle to a binding of oDst
+ * that a binding of oSrc displaces refers to a binding of oSrc.
+ */
+typedef struct Binding *SymTableHandle_T;
+
+/*********************************************************************/
+
+/*
+ * Fills in *psStats for oSymTable. The shape of the table is measured
+ * on every call, in time proportional to the number of buckets; the
+ * counters are only kept when compiled with -DSYMTABLE_STATS.
+ */
+void SymTable_getStats(SymTable_T oSymTable,
+     struct SymTableStats *psStats);
+
+/*
+ * How SymTable_merge settles a key present in both tables.
+ */
+enum SymTableMergePolicy {
+   /* the binding of the destination stays, and the binding of the
+      source stays in the source */
+   SYMTABLE_MERGE_KEEP_DST,
+
+   /* the binding of the source moves to the destination, and the
+      binding it displaces moves to the source */
+   SYMTABLE_MERGE_TAKE_SRC
+};
+
+/*
+ * Moves every binding of oSrc into oDst, except that a key present
+ * in both is settled as ePolicy says. Either way, oSrc is left
+ * holding exactly the bindings that oDst did not take, so the client
+ * can free the values that lost. oDst grows once, up front, to hold
+ * all of the bindings. If oDst and oSrc were made with the same
+ * allocator (and context), their nodes, key copies, and cached hash
+ * codes move as they are, with nothing allocated or copied;
+ * otherwise each binding is copied as by SymTable_put. Returns the
+ * number of bindings moved into oDst. oDst and oSrc must differ, and
+ * neither may have a scope or transaction open.
+ */
+size_t SymTable_merge(SymTable_T oDst, SymTable_T oSrc,
+     enum SymTableMergePolicy ePolicy);
+
+/*
+ * Gives oSymTable an approximate-membership filter: a blocked Bloom
+ * filter of about 10 bits per binding that lets SymTable_contains,
+ * SymTable_get, and SymTable_remove answer most lookups of absent
+ * keys from one cache line, without walking a chain. The filter is
+ * kept up to date by put and remove and rebuilt when the table
+ * expands. Returns 1 if successful (or if oSymTable already has a
+ * filter) and 0 if memory is insufficient.
+ */
+int SymTable_enableFilter(SymTable_T oSymTable);
+
+/*
+ * Frees the filter of oSymTable, if it has one.
+ */
+void SymTable_disableFilter(SymTable_T oSymTable);
+
+/*
+ * Opens a new innermost scope of oSymTable, in constant time. Until
+ * the matching SymTable_exitScope, SymTable_put of a key bound in an
+ * enclosing scope shadows that binding instead of failing, and
+ * SymTable_remove takes a key out only until the scope is exited.
+ * Every lookup sees only the innermost binding of a key and stays a
+ * single probe of the one hash index, however deep the nesting.
+ * Scopes cannot be opened while a transaction (see SymTable_begin) is
+ * open, nor transactions begun while a scope is.
+ */
+void SymTable_enterScope(SymTable_T oSymTable);
+
+/*
+ * Closes the innermost scope of oSymTable: removes the bindings it
+ * declared and restores the ones it shadowed or removed, in time
+ * proportional to the number of keys the scope put or removed.
+ * Bindings changed by SymTable_replace keep their new values unless
+ * the scope declared or shadowed them. Returns 1 if successful and 0
+ * if oSymTable has no scope open.
+ */
+int SymTable_exitScope(SymTable_T oSymTable);
+
+/*
+ * Returns the number of scopes of oSymTable that are open.
+ */
+size_t SymTable_getScopeDepth(SymTable_T oSymTable);
+
+/*
+ * Begins a transaction of oSymTable, nested within any that are
+ * already open. Beginning is a checkpoint that costs constant time:
+ * from then on, each put, replace, and remove appends what it
+ * changed to an undo log, and a removed binding is kept, off its
+ * chain, until the outermost transaction commits. Returns 1 if
+ * successful and 0 if memory is insufficient. While a transaction is
+ * open, SymTable_put, SymTable_replace, and SymTable_remove also fail
+ * if memory for the log is insufficient.
+ */
+int SymTable_begin(SymTable_T oSymTable);
+
+/*
+ * Undoes every put, replace, and remove of oSymTable since the
+ * innermost open transaction began, newest first, and ends that
+ * transaction, in time proportional to the number of changes undone.
+ * Returns 1 if successful and 0 if no transaction is open.
+ */
+int SymTable_rollback(SymTable_T oSymTable);
+
+/*
+ * Ends the innermost open transaction of oSymTable, keeping its
+ * changes. If it is nested, an enclosing rollback still undoes them;
+ * otherwise the log is emptied and the removed bindings are freed.
+ * Returns 1 if successful and 0 if no transaction is open.
+ */
+int SymTable_commit(SymTable_T oSymTable);
+
+/*
+ * Returns a SymTableKey for pcKey, hashing it once. Passing it to the
+ * _h operations below, which behave as the operations of symtable.h
+ * do, lets a caller that looks a key up several times in a row skip
+ * hashing and measuring it on each call. A SymTableKey may be used
+ * with any table of this module.
+ */
+struct SymTableKey SymTable_prepareKey(const char *pcKey);
+
+/* See SymTable_put. */
+int SymTable_put_h(SymTable_T oSymTable, struct SymTableKey *psKey,
+                   const void *pvValue);
+
+/* See SymTable_replace. */
+void *SymTable_replace_h(SymTable_T oSymTable,
+                         struct SymTableKey *psKey,
+                         const void *pvValue);
+
+/* See SymTable_contains. */
+int SymTable_contains_h(SymTable_T oSymTable,
+                        struct SymTableKey *psKey);
+
+/* See SymTable_get. */
+void *SymTable_get_h(SymTable_T oSymTable, struct SymTableKey *psKey);
+
+/* See SymTable_remove. */
+void *SymTable_remove_h(SymTable_T oSymTable,
+                        struct SymTableKey *psKey);
+
+/*
+ * Tries to insert a binding of pcKey and pvValue into oSymTable, as
+ * SymTable_put does. Returns a handle to the binding if successful
+ * and NULL if pcKey is already present or memory is insufficient.
+ */
+SymTableHandle_T SymTable_putHandle(SymTable_T oSymTable,
+                                    const char *pcKey,
+                                    const void *pvValue);
+
+/*
+ * Returns the value of the binding that oHandle refers to, without
+ * hashing or comparing its key.
+ */
+void *SymTable_handleGet(SymTableHandle_T oHandle);
+
+/*
+ * Changes the value of the binding of oSymTable that oHandle refers
+ * to to pvValue and returns the old value, without hashing or
+ * comparing its key. While a transaction is open, the change is
+ * logged as a replace would be, and NULL is returned, with the value
+ * unchanged, if memory for the log is insufficient.
+ */
+void *SymTable_handleSet(SymTable_T oSymTable, SymTableHandle_T oHandle,
+                         const void *pvValue);
+
+/*
+ * Limits oSymTable to uCapacity bindings, making it a cache, or lifts
+ * the limit if uCapacity is 0. A put into a full table first evicts
+ * a binding that has not been used recently, chosen by the CLOCK
+ * algorithm: each binding has a bit that a get, contains, replace,
+ * or handle operation sets, and the hand that looks for a binding to
+ * evict clears the bits it passes, so that only a binding unused for
+ * a whole sweep is evicted; a put that fails for lack of memory
+ * evicts nothing. If oSymTable already holds more than uCapacity
+ * bindings, the extra ones are evicted at once, as are any that
+ * SymTable_merge moves in beyond the capacity. A table with a
+ * capacity may not open a scope or a transaction, nor may a table
+ * with one open be given a capacity.
+ */
+void SymTable_setCapacity(SymTable_T oSymTable, size_t uCapacity);
+
+/*
+ * Makes oSymTable call (*pfEvict) on each binding it evicts or that
+ * expires (see SymTable_putWithTTL), passing pvExtra as a parameter,
+ * so that the client can free the value. The key is freed when
+ * pfEvict returns, and pfEvict must not call the functions of
+ * oSymTable. If pfEvict is NULL, evicted bindings are dropped
+ * silently. SymTable_free and SymTable_remove do not call pfEvict.
+ */
+void SymTable_setEvictHandler(SymTable_T oSymTable,
+     void (*pfEvict)(const char *pcKey, void *pvValue, void *pvExtra),
+     const void *pvExtra);
+
+/*
+ * Makes oSymTable tell time by (*pfNow), which returns a count of
+ * seconds, passing pvContext as a parameter. If pfNow is NULL, as it
+ * is for a new table, the wall clock is used. May only be called
+ * while no binding of oSymTable has a TTL.
+ */
+void SymTable_setClock(SymTable_T oSymTable,
+                       unsigned long (*pfNow)(void *pvContext),
+                       void *pvContext);
+
+/*
+ * Tries to insert a binding of pcKey and pvValue into oSymTable, as
+ * SymTable_put does, that expires ulSeconds from now. Returns 1 if
+ * successful and 0 if pcKey is already present or memory is
+ * insufficient.
+ *
+ * Expiry is lazy: once its time has come, a binding is absent to
+ * get, contains, replace, remove, and put, the first of which to
+ * find it also frees it. The bindings that no lookup finds are freed
+ * by SymTable_expire, and until then they still count in
+ * SymTable_getLength and are still passed by SymTable_map. A table
+ * with bindings that have a TTL may not open a scope or a
+ * transaction, nor take part in SymTable_merge.
+ */
+int SymTable_putWithTTL(SymTable_T oSymTable, const char *pcKey,
+                        const void *pvValue, unsigned long ulSeconds);
+
+/*
+ * Frees the bindings of oSymTable that have expired, doing at most
+ * uMaxWork units of work: one per second of the timer wheel swept
+ * and one per binding examined. The wheel has a slot per second, so
+ * a call finds the expired bindings without scanning the table; a
+ * call that runs out of work leaves the rest for the next. Returns
+ * the number of bindings freed.
+ */
+size_t SymTable_expire(SymTable_T oSymTable, size_t uMaxWork);
+
+/*********************************************************************/
+
+#endif
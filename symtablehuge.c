@@ -0,0 +1,401 @@
+/*********************************************************************/
+/* symtablehuge.c                                                    */
+/* COS 217 Assignment 3: A Symbol Table ADT                          */
+/* Date: 10/31/2023                                                  */
+/* Author: Hugh Peterson                                             */
+/* Description: An allocator for SymTable_T objects that backs their */
+/*              bucket arrays and nodes with huge pages              */
+/*********************************************************************/
+
+/*********************************************************************/
+
+#define _DEFAULT_SOURCE
+
+#include <assert.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include "symtablehuge.h"
+
+/*********************************************************************/
+
+enum {
+   /* bytes of a huge page, and of each chunk that small requests
+      are carved from */
+   HUGE_PAGE_BYTES = 2 * 1024 * 1024,
+
+   /* bytes at the start of each chunk that its header occupies; a
+      multiple of ALIGNMENT */
+   CHUNK_HEADER_BYTES = 64,
+
+   /* alignment of every block handed out */
+   ALIGNMENT = 16,
+
+   /* largest request rounded up to a multiple of ALIGNMENT; larger
+      ones are rounded up to a power of two */
+   SMALL_LIMIT = 256,
+
+   /* largest request carved from a shared chunk; larger ones, such
+      as symtablehash.c bucket arrays of 16381 buckets or more, get a
+      chunk of their own */
+   LARGE_LIMIT = HUGE_PAGE_BYTES / 32,
+
+   /* number of block sizes: SMALL_LIMIT / ALIGNMENT multiples of
+      ALIGNMENT, then the powers of two from 2 * SMALL_LIMIT through
+      LARGE_LIMIT */
+   CLASS_COUNT = SMALL_LIMIT / ALIGNMENT + 8
+};
+
+/*
+ * How the pages of a chunk are backed.
+ */
+enum Backing {
+   BACKING_HUGETLB,
+   BACKING_ADVISED,
+   BACKING_PLAIN
+};
+
+/*
+ * The header of a mapped chunk, in its first CHUNK_HEADER_BYTES.
+ */
+struct Chunk {
+   /* next chunk of the same SymTableHuge */
+   struct Chunk *next;
+
+   /* previous chunk of the same SymTableHuge, or NULL */
+   struct Chunk *prev;
+
+   /* bytes mapped, a multiple of HUGE_PAGE_BYTES */
+   size_t bytes;
+
+   /* how the pages of the chunk are backed */
+   enum Backing backing;
+};
+
+/*
+ * A source of memory for SymTable_T objects.
+ */
+struct SymTableHuge {
+   /* every chunk mapped, most recent first */
+   struct Chunk *chunks;
+
+   /* next free byte of the chunk small requests are carved from, or
+      NULL if there is no such chunk yet */
+   char *carve;
+
+   /* end of the chunk small requests are carved from */
+   char *carveEnd;
+
+   /* freeLists[c] is a list of released blocks of class c, linked
+      through their first bytes */
+   void *freeLists[CLASS_COUNT];
+
+   /* bytes mapped, by how they are backed */
+   struct SymTableHugeStats stats;
+};
+
+/*********************************************************************/
+
+/*
+ * Maps uBytes bytes, a multiple of HUGE_PAGE_BYTES, starting on a huge
+ * page boundary, with the best backing the system offers, and stores
+ * that backing in *peBacking. Returns NULL if no memory can be
+ * mapped.
+ */
+static char *SymTableHuge_map(size_t uBytes, enum Backing *peBacking) {
+   char *pcBase;
+   size_t uLead;
+
+   assert(uBytes % HUGE_PAGE_BYTES == 0);
+   assert(peBacking != NULL);
+
+#ifdef MAP_HUGETLB
+   /* fails unless huge pages were reserved (vm.nr_hugepages) */
+   pcBase = (char *) mmap(NULL, uBytes, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+                          -1, 0);
+   if (pcBase != (char *) MAP_FAILED) {
+      *peBacking = BACKING_HUGETLB;
+      return pcBase;
+   }
+#endif
+
+   /* map a huge page more than needed, and trim the ends so that
+      the rest starts on a huge page boundary, since transparent
+      huge pages only back whole aligned huge pages */
+   pcBase = (char *) mmap(NULL, uBytes + HUGE_PAGE_BYTES,
+                          PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+   if (pcBase == (char *) MAP_FAILED) {
+      return NULL;
+   }
+   uLead = (HUGE_PAGE_BYTES - (size_t) pcBase % HUGE_PAGE_BYTES)
+      % HUGE_PAGE_BYTES;
+   if (uLead > 0) {
+      munmap(pcBase, uLead);
+   }
+   munmap(pcBase + uLead + uBytes, HUGE_PAGE_BYTES - uLead);
+   pcBase += uLead;
+
+#ifdef MADV_HUGEPAGE
+   if (madvise(pcBase, uBytes, MADV_HUGEPAGE) == 0) {
+      *peBacking = BACKING_ADVISED;
+      return pcBase;
+   }
+#endif
+
+   *peBacking = BACKING_PLAIN;
+   return pcBase;
+}
+
+/*
+ * Returns the counter of the stats of oHuge for eBacking.
+ */
+static size_t *SymTableHuge_counter(SymTableHuge_T oHuge,
+                                    enum Backing eBacking) {
+   assert(oHuge != NULL);
+
+   switch (eBacking) {
+      case BACKING_HUGETLB:
+         return &oHuge->stats.hugetlbBytes;
+      case BACKING_ADVISED:
+         return &oHuge->stats.advisedBytes;
+      default:
+         return &oHuge->stats.plainBytes;
+   }
+}
+
+/*
+ * Maps a chunk of uBytes bytes, a multiple of HUGE_PAGE_BYTES, for
+ * oHuge and returns it, or NULL if no memory can be mapped.
+ */
+static struct Chunk *SymTableHuge_newChunk(SymTableHuge_T oHuge,
+                                           size_t uBytes) {
+   struct Chunk *psChunk;
+   enum Backing eBacking;
+
+   assert(oHuge != NULL);
+
+   psChunk = (struct Chunk *) SymTableHuge_map(uBytes, &eBacking);
+   if (psChunk == NULL) {
+      return NULL;
+   }
+   psChunk->bytes = uBytes;
+   psChunk->backing = eBacking;
+   psChunk->prev = NULL;
+   psChunk->next = oHuge->chunks;
+   if (oHuge->chunks != NULL) {
+      oHuge->chunks->prev = psChunk;
+   }
+   oHuge->chunks = psChunk;
+   *SymTableHuge_counter(oHuge, eBacking) += uBytes;
+   return psChunk;
+}
+
+/*
+ * Unmaps psChunk, a chunk of oHuge.
+ */
+static void SymTableHuge_dropChunk(SymTableHuge_T oHuge,
+                                   struct Chunk *psChunk) {
+   assert(oHuge != NULL);
+   assert(psChunk != NULL);
+
+   if (psChunk->prev != NULL) {
+      psChunk->prev->next = psChunk->next;
+   }
+   else {
+      oHuge->chunks = psChunk->next;
+   }
+   if (psChunk->next != NULL) {
+      psChunk->next->prev = psChunk->prev;
+   }
+   *SymTableHuge_counter(oHuge, psChunk->backing) -= psChunk->bytes;
+   munmap(psChunk, psChunk->bytes);
+}
+
+/*
+ * Returns the class of the blocks that requests of uSize bytes, at
+ * most LARGE_LIMIT, are served from, and stores the size of those
+ * blocks in *puBlock.
+ */
+static size_t SymTableHuge_class(size_t uSize, size_t *puBlock) {
+   size_t uClass;
+   size_t uBlock;
+
+   assert(uSize <= LARGE_LIMIT);
+   assert(puBlock != NULL);
+
+   if (uSize <= SMALL_LIMIT) {
+      uBlock = (uSize == 0) ? ALIGNMENT
+         : (uSize + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+      *puBlock = uBlock;
+      return uBlock / ALIGNMENT - 1;
+   }
+
+   uClass = SMALL_LIMIT / ALIGNMENT;
+   for (uBlock = 2 * SMALL_LIMIT; uBlock < uSize; uBlock *= 2) {
+      uClass++;
+   }
+   assert(uClass < CLASS_COUNT);
+   *puBlock = uBlock;
+   return uClass;
+}
+
+/*
+ * Returns the bytes of the chunk of its own that a request of uSize
+ * bytes, more than LARGE_LIMIT, gets: uSize and the chunk header,
+ * rounded up to whole huge pages.
+ */
+static size_t SymTableHuge_largeBytes(size_t uSize) {
+   assert(uSize > LARGE_LIMIT);
+
+   return (uSize + CHUNK_HEADER_BYTES + HUGE_PAGE_BYTES - 1)
+      / HUGE_PAGE_BYTES * HUGE_PAGE_BYTES;
+}
+
+/*
+ * Returns uSize bytes from the SymTableHuge that pvContext is, or
+ * NULL if memory is insufficient.
+ */
+static void *SymTableHuge_alloc(void *pvContext, size_t uSize) {
+   SymTableHuge_T oHuge = (SymTableHuge_T) pvContext;
+   struct Chunk *psChunk;
+   size_t uClass;
+   size_t uBlock;
+   void *pvBlock;
+
+   assert(oHuge != NULL);
+
+   if (uSize > LARGE_LIMIT) {
+      psChunk = SymTableHuge_newChunk(oHuge,
+                                      SymTableHuge_largeBytes(uSize));
+      if (psChunk == NULL) {
+         return NULL;
+      }
+      return (char *) psChunk + CHUNK_HEADER_BYTES;
+   }
+
+   uClass = SymTableHuge_class(uSize, &uBlock);
+   pvBlock = oHuge->freeLists[uClass];
+   if (pvBlock != NULL) {
+      oHuge->freeLists[uClass] = *(void **) pvBlock;
+      return pvBlock;
+   }
+
+   if (oHuge->carve == NULL
+       || (size_t)(oHuge->carveEnd - oHuge->carve) < uBlock) {
+      psChunk = SymTableHuge_newChunk(oHuge, HUGE_PAGE_BYTES);
+      if (psChunk == NULL) {
+         return NULL;
+      }
+      oHuge->carve = (char *) psChunk + CHUNK_HEADER_BYTES;
+      oHuge->carveEnd = (char *) psChunk + HUGE_PAGE_BYTES;
+   }
+   pvBlock = oHuge->carve;
+   oHuge->carve += uBlock;
+   return pvBlock;
+}
+
+/*
+ * Releases pvMemory, which SymTableHuge_alloc returned for a request
+ * of uSize bytes, to the SymTableHuge that pvContext is. A block of a
+ * shared chunk is kept for the next request of its class; a chunk of
+ * its own is unmapped.
+ */
+static void SymTableHuge_release(void *pvContext, void *pvMemory,
+                                 size_t uSize) {
+   SymTableHuge_T oHuge = (SymTableHuge_T) pvContext;
+   size_t uClass;
+   size_t uBlock;
+
+   assert(oHuge != NULL);
+   assert(pvMemory != NULL);
+
+   if (uSize > LARGE_LIMIT) {
+      SymTableHuge_dropChunk(oHuge, (struct Chunk *)
+         ((char *) pvMemory - CHUNK_HEADER_BYTES));
+      return;
+   }
+
+   uClass = SymTableHuge_class(uSize, &uBlock);
+   *(void **) pvMemory = oHuge->freeLists[uClass];
+   oHuge->freeLists[uClass] = pvMemory;
+}
+
+/*
+ * Returns the bytes that SymTableHuge_alloc spends beyond a request
+ * of uSize bytes: the rounding up to the size of its block, or, for
+ * a chunk of its own, the header and the rounding up to whole huge
+ * pages.
+ */
+static size_t SymTableHuge_slack(void *pvContext, size_t uSize) {
+   size_t uBlock;
+
+   (void) pvContext;
+
+   if (uSize > LARGE_LIMIT) {
+      return SymTableHuge_largeBytes(uSize) - uSize;
+   }
+   SymTableHuge_class(uSize, &uBlock);
+   return uBlock - uSize;
+}
+
+/*********************************************************************/
+
+/*
+ * Construct a new SymTableHuge_T. Return NULL if memory is
+ * insufficient.
+ */
+SymTableHuge_T SymTableHuge_new(void) {
+   SymTableHuge_T oHuge;
+   size_t u;
+
+   oHuge = (SymTableHuge_T) malloc(sizeof(struct SymTableHuge));
+   if (oHuge == NULL) {
+      return NULL;
+   }
+   oHuge->chunks = NULL;
+   oHuge->carve = NULL;
+   oHuge->carveEnd = NULL;
+   for (u = 0; u < CLASS_COUNT; u++) {
+      oHuge->freeLists[u] = NULL;
+   }
+   oHuge->stats.hugetlbBytes = 0;
+   oHuge->stats.advisedBytes = 0;
+   oHuge->stats.plainBytes = 0;
+   return oHuge;
+}
+
+/*
+ * Unmaps all of the memory of oHuge and frees it.
+ */
+void SymTableHuge_free(SymTableHuge_T oHuge) {
+   assert(oHuge != NULL);
+
+   while (oHuge->chunks != NULL) {
+      SymTableHuge_dropChunk(oHuge, oHuge->chunks);
+   }
+   free(oHuge);
+}
+
+/*
+ * Fills in *psAllocator with the functions that get memory from a
+ * SymTableHuge_T.
+ */
+void SymTableHuge_getAllocator(struct SymTableAllocator *psAllocator) {
+   assert(psAllocator != NULL);
+
+   psAllocator->pfAlloc = SymTableHuge_alloc;
+   psAllocator->pfFree = SymTableHuge_release;
+   psAllocator->pfSlack = SymTableHuge_slack;
+}
+
+/*
+ * Fills in *psStats for oHuge.
+ */
+void SymTableHuge_getStats(SymTableHuge_T oHuge,
+                           struct SymTableHugeStats *psStats) {
+   assert(oHuge != NULL);
+   assert(psStats != NULL);
+
+   *psStats = oHuge->stats;
+}
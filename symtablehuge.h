@@ -0,0 +1,78 @@
+/*********************************************************************/
+/* symtablehuge.h                                                    */
+/* COS 217 Assignment 3: A Symbol Table ADT                          */
+/* Date: 10/31/2023                                                  */
+/* Author: Hugh Peterson                                             */
+/* Description: An allocator for SymTable_T objects that backs their */
+/*              bucket arrays and nodes with huge pages              */
+/*********************************************************************/
+
+/*********************************************************************/
+
+#ifndef SYMTABLEHUGE_INCLUDED
+#define SYMTABLEHUGE_INCLUDED
+
+#include <stddef.h>
+#include "symtable.h"
+
+/*
+ * A SymTableHuge_T object is a source of memory for the SymTable_T
+ * objects made with it (see SymTableHuge_getAllocator). It maps its
+ * memory in chunks of huge pages, so that a large table spans few
+ * TLB entries: small requests, such as nodes and key copies, are
+ * carved from shared chunks, and large ones, such as the bucket
+ * arrays of large tables, get chunks of their own. Each chunk is
+ * mapped with MAP_HUGETLB if the system has huge pages reserved, and
+ * otherwise with ordinary pages and madvise(MADV_HUGEPAGE), so that
+ * transparent huge pages may back it; if neither is available,
+ * ordinary pages are used.
+ */
+typedef struct SymTableHuge *SymTableHuge_T;
+
+/*
+ * The bytes of memory a SymTableHuge_T has mapped, by how they are
+ * backed.
+ */
+struct SymTableHugeStats {
+   /* bytes mapped with MAP_HUGETLB */
+   size_t hugetlbBytes;
+
+   /* bytes mapped with ordinary pages and advised to be backed by
+      transparent huge pages */
+   size_t advisedBytes;
+
+   /* bytes mapped with ordinary pages only */
+   size_t plainBytes;
+};
+
+/*********************************************************************/
+
+/*
+ * Construct a new SymTableHuge_T, which maps no memory until the
+ * first request. Return NULL if memory is insufficient.
+ */
+SymTableHuge_T SymTableHuge_new(void);
+
+/*
+ * Unmaps all of the memory of oHuge and frees it. The tables made
+ * with oHuge must be freed first, or not used again.
+ */
+void SymTableHuge_free(SymTableHuge_T oHuge);
+
+/*
+ * Fills in *psAllocator with the functions that get memory from a
+ * SymTableHuge_T. A table gets its memory from oHuge if made by
+ * SymTable_newWithAllocator(psAllocator, oHuge). Any number of tables
+ * may share oHuge, but only one thread may use them at a time.
+ */
+void SymTableHuge_getAllocator(struct SymTableAllocator *psAllocator);
+
+/*
+ * Fills in *psStats for oHuge.
+ */
+void SymTableHuge_getStats(SymTableHuge_T oHuge,
+                           struct SymTableHugeStats *psStats);
+
+/*********************************************************************/
+
+#endif
@@ -0,0 +1,258 @@
+/*********************************************************************/
+/* symtablelatency.c                                                 */
+/* COS 217 Assignment 3: A Symbol Table ADT                          */
+/* Date: 10/31/2023                                                  */
+/* Author: Hugh Peterson                                             */
+/* Description: Latency histograms of the symbol table operations,   */
+/*              kept when the library is built with                  */
+/*              -DSYMTABLE_LATENCY                                   */
+/*********************************************************************/
+
+/*********************************************************************/
+
+#ifdef SYMTABLE_LATENCY
+#define _POSIX_C_SOURCE 199309L
+#include <time.h>
+#endif
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include "symtablelatency.h"
+
+/*********************************************************************/
+
+/* names of the operations, indexed by enum SymTableOperation */
+static const char *const apcOperationNames[SYMTABLE_OP_COUNT] = {
+   "put", "get", "remove", "map"
+};
+
+/* the histogram of each operation, indexed by enum SymTableOperation;
+   updated without locking (see symtablelatency.h) */
+static struct SymTableLatencyHistogram
+   asHistograms[SYMTABLE_OP_COUNT];
+
+/*********************************************************************/
+
+/*
+ * Returns the nanoseconds at which latency bucket iBucket ends.
+ */
+static double SymTable_bucketEnd(int iBucket) {
+   double dEnd = 2.0;
+
+   assert(iBucket >= 0 && iBucket < SYMTABLE_LATENCY_BUCKETS);
+
+   while (iBucket-- > 0) {
+      dEnd *= 2.0;
+   }
+   return dEnd;
+}
+
+/*********************************************************************/
+
+#ifdef SYMTABLE_LATENCY
+
+/*********************************************************************/
+
+/* 1 once the exit handler has been considered */
+static int iExitHandlerChecked = 0;
+
+/*
+ * Writes the histograms to stderr; registered with atexit.
+ */
+static void SymTable_dumpAtExit(void) {
+   SymTable_writeLatencyHistograms(stderr);
+}
+
+/*
+ * Returns the current time in nanoseconds.
+ */
+static double SymTable_now(void) {
+   struct timespec sTime;
+
+   clock_gettime(CLOCK_MONOTONIC, &sTime);
+   return (double)sTime.tv_sec * 1e9 + (double)sTime.tv_nsec;
+}
+
+/*
+ * Adds a call of operation eOperation that started at dStartNs and
+ * ended now to its histogram.
+ */
+static void SymTable_record(enum SymTableOperation eOperation,
+                            double dStartNs) {
+   struct SymTableLatencyHistogram *psHistogram;
+   double dNs = SymTable_now() - dStartNs;
+   double dEnd = 2.0;
+   int iBucket = 0;
+
+   if (!iExitHandlerChecked) {
+      iExitHandlerChecked = 1;
+      if (getenv("SYMTABLE_LATENCY_DUMP") != NULL) {
+         atexit(SymTable_dumpAtExit);
+      }
+   }
+
+   /* a few doublings at most for any call that is not a stall */
+   while (dNs >= dEnd && iBucket < SYMTABLE_LATENCY_BUCKETS - 1) {
+      dEnd *= 2.0;
+      iBucket++;
+   }
+
+   psHistogram = &asHistograms[eOperation];
+   psHistogram->count++;
+   psHistogram->buckets[iBucket]++;
+   psHistogram->totalNs += dNs;
+   if (dNs > psHistogram->maxNs) {
+      psHistogram->maxNs = dNs;
+   }
+}
+
+/*********************************************************************/
+
+/*
+ * Times SymTable_untimedPut.
+ */
+int SymTable_put(SymTable_T oSymTable,
+                 const char *pcKey, const void *pvValue) {
+   double dStart = SymTable_now();
+   int iResult = SymTable_untimedPut(oSymTable, pcKey, pvValue);
+
+   SymTable_record(SYMTABLE_OP_PUT, dStart);
+   return iResult;
+}
+
+/*
+ * Times SymTable_untimedGet.
+ */
+void *SymTable_get(SymTable_T oSymTable, const char *pcKey) {
+   double dStart = SymTable_now();
+   void *pvResult = SymTable_untimedGet(oSymTable, pcKey);
+
+   SymTable_record(SYMTABLE_OP_GET, dStart);
+   return pvResult;
+}
+
+/*
+ * Times SymTable_untimedRemove.
+ */
+void *SymTable_remove(SymTable_T oSymTable, const char *pcKey) {
+   double dStart = SymTable_now();
+   void *pvResult = SymTable_untimedRemove(oSymTable, pcKey);
+
+   SymTable_record(SYMTABLE_OP_REMOVE, dStart);
+   return pvResult;
+}
+
+/*
+ * Times SymTable_untimedMap, including the calls of pfApply.
+ */
+void SymTable_map(SymTable_T oSymTable,
+     void (*pfApply)(const char *pcKey, void *pvValue, void *pvExtra),
+                  const void *pvExtra) {
+   double dStart = SymTable_now();
+
+   SymTable_untimedMap(oSymTable, pfApply, pvExtra);
+   SymTable_record(SYMTABLE_OP_MAP, dStart);
+}
+
+/*********************************************************************/
+
+#endif
+
+/*********************************************************************/
+
+/*
+ * Fills in *psHistogram with the latencies recorded for eOperation.
+ */
+void SymTable_getLatencyHistogram(enum SymTableOperation eOperation,
+     struct SymTableLatencyHistogram *psHistogram) {
+   assert((int)eOperation >= 0 && eOperation < SYMTABLE_OP_COUNT);
+   assert(psHistogram != NULL);
+
+   *psHistogram = asHistograms[eOperation];
+#ifdef SYMTABLE_LATENCY
+   psHistogram->enabled = 1;
+#endif
+}
+
+/*
+ * Returns the end of the bucket holding the dPercent percentile of
+ * *psHistogram, or 0 if it is empty.
+ */
+double SymTable_latencyPercentile(
+     const struct SymTableLatencyHistogram *psHistogram,
+     double dPercent) {
+   double dRank;
+   size_t uSeen = 0;
+   int i;
+
+   assert(psHistogram != NULL);
+   assert(dPercent >= 0.0 && dPercent <= 100.0);
+
+   if (psHistogram->count == 0) {
+      return 0.0;
+   }
+
+   dRank = dPercent / 100.0 * (double)psHistogram->count;
+   for (i = 0; i < SYMTABLE_LATENCY_BUCKETS - 1; i++) {
+      uSeen += psHistogram->buckets[i];
+      if (uSeen > 0 && (double)uSeen >= dRank) {
+         break;
+      }
+   }
+   /* the last bucket has no end of its own */
+   if (i == SYMTABLE_LATENCY_BUCKETS - 1) {
+      return psHistogram->maxNs;
+   }
+   return SymTable_bucketEnd(i);
+}
+
+/*
+ * Discards every recorded latency.
+ */
+void SymTable_resetLatencyHistograms(void) {
+   memset(asHistograms, 0, sizeof(asHistograms));
+}
+
+/*
+ * Writes every histogram to psFile.
+ */
+void SymTable_writeLatencyHistograms(FILE *psFile) {
+   struct SymTableLatencyHistogram sHistogram;
+   int e;
+   int i;
+
+   assert(psFile != NULL);
+
+   for (e = 0; e < SYMTABLE_OP_COUNT; e++) {
+      SymTable_getLatencyHistogram((enum SymTableOperation)e,
+                                   &sHistogram);
+      if (sHistogram.count == 0) {
+         continue;
+      }
+      fprintf(psFile,
+              "SymTable_%s: %lu calls, mean %.0f ns, p50 < %.0f ns, "
+              "p99 < %.0f ns, max %.0f ns\n",
+              apcOperationNames[e], (unsigned long)sHistogram.count,
+              sHistogram.totalNs / (double)sHistogram.count,
+              SymTable_latencyPercentile(&sHistogram, 50.0),
+              SymTable_latencyPercentile(&sHistogram, 99.0),
+              sHistogram.maxNs);
+      for (i = 0; i < SYMTABLE_LATENCY_BUCKETS; i++) {
+         if (sHistogram.buckets[i] == 0) {
+            continue;
+         }
+         if (i < SYMTABLE_LATENCY_BUCKETS - 1) {
+            fprintf(psFile, "   <  %14.0f ns: %lu\n",
+                    SymTable_bucketEnd(i),
+                    (unsigned long)sHistogram.buckets[i]);
+         }
+         else {
+            fprintf(psFile, "   >= %14.0f ns: %lu\n",
+                    SymTable_bucketEnd(i - 1),
+                    (unsigned long)sHistogram.buckets[i]);
+         }
+      }
+   }
+   fflush(psFile);
+}
@@ -0,0 +1,129 @@
+/*********************************************************************/
+/* symtablelatency.h                                                 */
+/* COS 217 Assignment 3: A Symbol Table ADT                          */
+/* Date: 10/31/2023                                                  */
+/* Author: Hugh Peterson                                             */
+/* Description: Latency histograms of the symbol table operations,   */
+/*              kept when the library is built with                  */
+/*              -DSYMTABLE_LATENCY                                   */
+/*********************************************************************/
+
+/*********************************************************************/
+
+#ifndef SYMTABLELATENCY_INCLUDED
+#define SYMTABLELATENCY_INCLUDED
+
+#include <stddef.h>
+#include <stdio.h>
+#include "symtable.h"
+
+/*
+ * Only SymTable_put, SymTable_get, SymTable_remove, and SymTable_map
+ * are timed. Every other function, including the _h and handle
+ * variants of symtablehash.h that bypass them, runs untimed. The
+ * histograms are shared by the whole process and updated without
+ * locking, so a library built with -DSYMTABLE_LATENCY may be used by
+ * only one thread at a time; symtablesharded.c refuses to compile
+ * with it.
+ */
+
+/*********************************************************************/
+
+enum {
+   /* number of buckets in a latency histogram; bucket 0 counts calls
+      that took less than 2 ns, bucket i > 0 those that took from 2^i
+      up to 2^(i+1) ns, and the last bucket every longer call too */
+   SYMTABLE_LATENCY_BUCKETS = 40
+};
+
+/*
+ * The operations whose latencies are recorded.
+ */
+enum SymTableOperation {
+   SYMTABLE_OP_PUT,
+   SYMTABLE_OP_GET,
+   SYMTABLE_OP_REMOVE,
+   SYMTABLE_OP_MAP,
+   SYMTABLE_OP_COUNT
+};
+
+/*
+ * The latencies of every call of one operation, over all tables,
+ * since the program started or the histograms were last reset.
+ */
+struct SymTableLatencyHistogram {
+   /* 1 if latencies are recorded (the library was compiled with
+      -DSYMTABLE_LATENCY) and 0 if everything below is always 0 */
+   int enabled;
+
+   /* number of calls recorded */
+   size_t count;
+
+   /* buckets[i] is the number of calls in latency bucket i */
+   size_t buckets[SYMTABLE_LATENCY_BUCKETS];
+
+   /* total nanoseconds of all recorded calls */
+   double totalNs;
+
+   /* nanoseconds of the slowest recorded call */
+   double maxNs;
+};
+
+/*********************************************************************/
+
+/*
+ * Fills in *psHistogram with the latencies recorded for operation
+ * eOperation.
+ */
+void SymTable_getLatencyHistogram(enum SymTableOperation eOperation,
+     struct SymTableLatencyHistogram *psHistogram);
+
+/*
+ * Returns an upper bound, in nanoseconds, on the dPercent percentile
+ * (0 to 100) of the latencies in *psHistogram: the end of the bucket
+ * that holds it. Returns 0 if the histogram is empty.
+ */
+double SymTable_latencyPercentile(
+     const struct SymTableLatencyHistogram *psHistogram,
+     double dPercent);
+
+/*
+ * Discards every recorded latency.
+ */
+void SymTable_resetLatencyHistograms(void);
+
+/*
+ * Writes a summary and the non-empty buckets of every histogram to
+ * psFile. If the environment variable SYMTABLE_LATENCY_DUMP is set
+ * when the first latency is recorded, this is also done to stderr
+ * when the program exits.
+ */
+void SymTable_writeLatencyHistograms(FILE *psFile);
+
+/*********************************************************************/
+
+/*
+ * The interface between the latency module and the implementations
+ * of symtable.h. When compiled with -DSYMTABLE_LATENCY, an
+ * implementation defines its put, get, remove, and map under the
+ * names below, and symtablelatency.c defines the SymTable_ functions
+ * as timed calls of them.
+ */
+#ifdef SYMTABLE_LATENCY
+
+int SymTable_untimedPut(SymTable_T oSymTable,
+     const char *pcKey, const void *pvValue);
+
+void *SymTable_untimedGet(SymTable_T oSymTable, const char *pcKey);
+
+void *SymTable_untimedRemove(SymTable_T oSymTable, const char *pcKey);
+
+void SymTable_untimedMap(SymTable_T oSymTable,
+     void (*pfApply)(const char *pcKey, void *pvValue, void *pvExtra),
+     const void *pvExtra);
+
+#endif
+
+/*********************************************************************/
+
+#endif
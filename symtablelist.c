@@ -10,9 +10,21 @@
 /*********************************************************************/
 
 #include <assert.h>
-#include <stdlib.h>
 #include <string.h>
 #include "symtable.h"
+#include "symtablemalloc.h"
+
+/*
+ * With -DSYMTABLE_LATENCY, put, get, remove, and map are compiled
+ * under other names and timed by symtablelatency.c.
+ */
+#ifdef SYMTABLE_LATENCY
+#include "symtablelatency.h"
+#define SymTable_put SymTable_untimedPut
+#define SymTable_get SymTable_untimedGet
+#define SymTable_remove SymTable_untimedRemove
+#define SymTable_map SymTable_untimedMap
+#endif
 
 /*********************************************************************/
 
@@ -39,22 +51,87 @@ struct SymTable {
 
    /* number of bindings stored in the SymTable */
    size_t size;
+
+   /* source of all the memory of the SymTable */
+   struct SymTableAllocator allocator;
+
+   /* context pointer passed to the allocator's functions */
+   void *context;
 };
       
 
+/*********************************************************************/
+
+/*
+ * Returns uSize bytes from the allocator of oSymTable, or NULL if
+ * memory is insufficient.
+ */
+static void *SymTable_alloc(SymTable_T oSymTable, size_t uSize) {
+   assert(oSymTable != NULL);
+
+   return (*oSymTable->allocator.pfAlloc)(oSymTable->context, uSize);
+}
+
+/*
+ * Gives pvMemory, an allocation of uSize bytes, back to the allocator
+ * of oSymTable, if that allocator releases memory at all.
+ */
+static void SymTable_release(SymTable_T oSymTable, void *pvMemory,
+                             size_t uSize) {
+   assert(oSymTable != NULL);
+
+   if (oSymTable->allocator.pfFree != NULL) {
+      (*oSymTable->allocator.pfFree)(oSymTable->context, pvMemory,
+                                     uSize);
+   }
+}
+
+/*
+ * Returns the bytes that the allocator of oSymTable spends beyond a
+ * request of uBytes, or 0 if the allocator does not say.
+ */
+static size_t SymTable_allocSlack(SymTable_T oSymTable,
+                                  size_t uBytes) {
+   assert(oSymTable != NULL);
+
+   if (oSymTable->allocator.pfSlack == NULL) {
+      return 0;
+   }
+   return (*oSymTable->allocator.pfSlack)(oSymTable->context, uBytes);
+}
+
 /*********************************************************************/
 
 /*
  * Construct a new SymTable_T. Return NULL if memory is insufficient.
  */
 SymTable_T SymTable_new(void) {
+   struct SymTableAllocator sMalloc;
+
+   SymTableMalloc_getAllocator(&sMalloc);
+   return SymTable_newWithAllocator(&sMalloc, NULL);
+}
+
+/*
+ * Construct a new SymTable_T that gets its memory from *psAllocator.
+ * Return NULL if memory is insufficient.
+ */
+SymTable_T SymTable_newWithAllocator(
+     const struct SymTableAllocator *psAllocator, void *pvContext) {
    SymTable_T oSymTable;
 
-   oSymTable = (SymTable_T) malloc(sizeof(struct SymTable));
+   assert(psAllocator != NULL);
+   assert(psAllocator->pfAlloc != NULL);
+
+   oSymTable = (SymTable_T)
+      (*psAllocator->pfAlloc)(pvContext, sizeof(struct SymTable));
    if (oSymTable == NULL) {
       return NULL;
    }
 
+   oSymTable->allocator = *psAllocator;
+   oSymTable->context = pvContext;
+
    oSymTable -> first = NULL;
    oSymTable -> size = 0;
    
@@ -71,16 +148,22 @@ void SymTable_free(SymTable_T oSymTable) {
 
    assert(oSymTable != NULL);
 
+   /* the client releases the memory of such a table all at once */
+   if (oSymTable->allocator.pfFree == NULL) {
+      return;
+   }
+
    current = oSymTable->first;
    while (current != NULL) {
       previous = current;
       current = current->next;
 
-      free(previous->key);
-      free(previous);
+      SymTable_release(oSymTable, previous->key,
+                       strlen(previous->key) + 1);
+      SymTable_release(oSymTable, previous, sizeof(struct Binding));
    }
 
-   free(oSymTable);
+   SymTable_release(oSymTable, oSymTable, sizeof(struct SymTable));
 }
 
 /*
@@ -112,15 +195,17 @@ int SymTable_put(SymTable_T oSymTable,
       return 0;
    }
 
-   newBind = (struct Binding*)malloc(sizeof(struct Binding));
+   newBind = (struct Binding*)SymTable_alloc(oSymTable,
+                                             sizeof(struct Binding));
    if (newBind == NULL) {
       return 0;
    }
 
    /* Duplicate key */
    keyLen = (int) strlen(pcKey);
-   keyCopy = (char *) malloc((size_t)(keyLen + 1));
+   keyCopy = (char *) SymTable_alloc(oSymTable, (size_t)(keyLen + 1));
    if (keyCopy == NULL) {
+      SymTable_release(oSymTable, newBind, sizeof(struct Binding));
       return 0;
    }
    strcpy(keyCopy, pcKey);
@@ -226,9 +311,6 @@ void *SymTable_remove(SymTable_T oSymTable, const char *pcKey) {
    
    /* Handle empty */
    if (!oSymTable->first) {
-      /*DEBUG*/
-      #include <stdio.h>
-      printf("empty rm\n");
       return NULL;
    }
    /* Handle removal of first */
@@ -239,8 +321,10 @@ void *SymTable_remove(SymTable_T oSymTable, const char *pcKey) {
       current = oSymTable->first->next;
       
       oSymTable->size--;
-      free(oSymTable->first->key);
-      free(oSymTable->first);
+      SymTable_release(oSymTable, oSymTable->first->key,
+                       strlen(oSymTable->first->key) + 1);
+      SymTable_release(oSymTable, oSymTable->first,
+                       sizeof(struct Binding));
       
       oSymTable->first = current;
 
@@ -256,8 +340,9 @@ void *SymTable_remove(SymTable_T oSymTable, const char *pcKey) {
 
          oSymTable->size--;
          previous->next = current->next;
-         free(current->key);
-         free(current);
+         SymTable_release(oSymTable, current->key,
+                          strlen(current->key) + 1);
+         SymTable_release(oSymTable, current, sizeof(struct Binding));
          current = NULL;
 
          return removedValue;
@@ -291,6 +376,35 @@ void SymTable_map(SymTable_T oSymTable,
    }
 }
 
+/*
+ * Fills in *psMemory with the memory that oSymTable holds.
+ */
+void SymTable_memoryUsage(SymTable_T oSymTable,
+                          struct SymTableMemory *psMemory) {
+   struct Binding *current;
+   size_t uKeyBytes;
+
+   assert(oSymTable != NULL);
+   assert(psMemory != NULL);
+
+   psMemory->table = sizeof(struct SymTable);
+   psMemory->buckets = 0;
+   psMemory->nodes = oSymTable->size * sizeof(struct Binding);
+   psMemory->keys = 0;
+   psMemory->slack = SymTable_allocSlack(oSymTable, psMemory->table)
+      + oSymTable->size
+         * SymTable_allocSlack(oSymTable, sizeof(struct Binding));
+
+   for (current = oSymTable->first; current != NULL;
+        current = current->next) {
+      uKeyBytes = strlen(current->key) + 1;
+      psMemory->keys += uKeyBytes;
+      psMemory->slack += SymTable_allocSlack(oSymTable, uKeyBytes);
+   }
+   psMemory->total = psMemory->table + psMemory->nodes
+      + psMemory->keys + psMemory->slack;
+}
+
 /*********************************************************************/
 
 #ifdef DEBUG
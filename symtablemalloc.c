@@ -0,0 +1,78 @@
+/*********************************************************************/
+/* symtablemalloc.c                                                  */
+/* COS 217 Assignment 3: A Symbol Table ADT                          */
+/* Date: 10/31/2023                                                  */
+/* Author: Hugh Peterson                                             */
+/* Description: The allocator of the SymTable_T objects made by      */
+/*              SymTable_new, which gets memory from malloc          */
+/*********************************************************************/
+
+/*********************************************************************/
+
+#include <assert.h>
+#include <stdlib.h>
+#include "symtablemalloc.h"
+
+/*********************************************************************/
+
+/*
+ * Returns uSize bytes from malloc, or NULL if memory is insufficient.
+ */
+static void *SymTableMalloc_alloc(void *pvContext, size_t uSize) {
+   (void) pvContext;
+   return malloc(uSize);
+}
+
+/*
+ * Gives pvMemory back to malloc.
+ */
+static void SymTableMalloc_free(void *pvContext, void *pvMemory,
+                                size_t uSize) {
+   (void) pvContext;
+   (void) uSize;
+   free(pvMemory);
+}
+
+/*
+ * Returns the bytes that SymTableMalloc_alloc spends beyond a request
+ * of uSize bytes.
+ */
+static size_t SymTableMalloc_allocSlack(void *pvContext,
+                                        size_t uSize) {
+   (void) pvContext;
+   return SymTableMalloc_slack(uSize);
+}
+
+/*********************************************************************/
+
+/*
+ * Fills in *psAllocator with the functions that get memory from
+ * malloc.
+ */
+void SymTableMalloc_getAllocator(
+     struct SymTableAllocator *psAllocator) {
+   assert(psAllocator != NULL);
+
+   psAllocator->pfAlloc = SymTableMalloc_alloc;
+   psAllocator->pfFree = SymTableMalloc_free;
+   psAllocator->pfSlack = SymTableMalloc_allocSlack;
+}
+
+/*
+ * Returns an estimate of the bytes that malloc spends beyond a
+ * request of uBytes: a one-word header, rounding up to two words,
+ * and a four-word minimum, as in glibc.
+ */
+size_t SymTableMalloc_slack(size_t uBytes) {
+   const size_t HEADER = sizeof(size_t);
+   const size_t ALIGNMENT = 2 * sizeof(size_t);
+   const size_t MIN_CHUNK = 4 * sizeof(size_t);
+
+   size_t uChunk;
+
+   uChunk = (uBytes + HEADER + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+   if (uChunk < MIN_CHUNK) {
+      uChunk = MIN_CHUNK;
+   }
+   return uChunk - uBytes;
+}
@@ -0,0 +1,35 @@
+/*********************************************************************/
+/* symtablemalloc.h                                                  */
+/* COS 217 Assignment 3: A Symbol Table ADT                          */
+/* Date: 10/31/2023                                                  */
+/* Author: Hugh Peterson                                             */
+/* Description: The allocator of the SymTable_T objects made by      */
+/*              SymTable_new, which gets memory from malloc          */
+/*********************************************************************/
+
+/*********************************************************************/
+
+#ifndef SYMTABLEMALLOC_INCLUDED
+#define SYMTABLEMALLOC_INCLUDED
+
+#include <stddef.h>
+#include "symtable.h"
+
+/*********************************************************************/
+
+/*
+ * Fills in *psAllocator with the functions that get memory from
+ * malloc, for SymTable_newWithAllocator(psAllocator, NULL). Every
+ * implementation of SymTable_new uses them.
+ */
+void SymTableMalloc_getAllocator(struct SymTableAllocator *psAllocator);
+
+/*
+ * Returns an estimate of the bytes that malloc spends beyond a
+ * request of uBytes, for SymTable_memoryUsage.
+ */
+size_t SymTableMalloc_slack(size_t uBytes);
+
+/*********************************************************************/
+
+#endif
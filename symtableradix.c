@@ -0,0 +1,800 @@
+/*********************************************************************/
+/* symtableradix.c                                                   */
+/* COS 217 Assignment 3: A Symbol Table ADT                          */
+/* Date: 10/31/2023                                                  */
+/* Author: Hugh Peterson                                             */
+/* Description: A symbol table module to associate string keys with  */
+/*              generic values (compressed radix tree                */
+/*              implementation)                                      */
+/*********************************************************************/
+
+/*********************************************************************/
+
+#include <assert.h>
+#include <string.h>
+#include "symtableradix.h"
+#include "symtablemalloc.h"
+
+/*
+ * With -DSYMTABLE_LATENCY, put, get, remove, and map are compiled
+ * under other names and timed by symtablelatency.c.
+ */
+#ifdef SYMTABLE_LATENCY
+#include "symtablelatency.h"
+#define SymTable_put SymTable_untimedPut
+#define SymTable_get SymTable_untimedGet
+#define SymTable_remove SymTable_untimedRemove
+#define SymTable_map SymTable_untimedMap
+#endif
+
+/*********************************************************************/
+
+/*
+ * A node of the tree. The key a node stands for is the concatenation
+ * of the labels from the root down to it. Every node but the root
+ * is either a key or has at least two children, so that no chain of
+ * single children wastes nodes.
+ */
+struct Node {
+   /* first child, the children being in order of the first
+      character of their labels */
+   struct Node *children;
+
+   /* next child of the same parent */
+   struct Node *sibling;
+
+   /* the value, if the node is a key */
+   void *value;
+
+   /* number of keys in the subtree of the node, itself included */
+   size_t count;
+
+   /* number of characters in label */
+   size_t labelLength;
+
+   /* 1 if the node stands for a key and 0 otherwise */
+   int isKey;
+
+   /* the characters that the node adds to the key of its parent,
+      and a '\0'; really labelLength + 1 long */
+   char label[1];
+};
+
+/*
+ * A radix tree and the buffer in which keys are spelled out for
+ * SymTable_map.
+ */
+struct SymTable {
+   /* the root, whose label is empty; never NULL */
+   struct Node *root;
+
+   /* a buffer longer than every key, or NULL if the table is
+      empty */
+   char *keyBuffer;
+
+   /* bytes of keyBuffer */
+   size_t keyBufferSize;
+
+   /* the source of all memory of the table */
+   struct SymTableAllocator allocator;
+
+   /* the context pointer passed to the allocator */
+   void *context;
+};
+
+/*
+ * The signature of the functions that SymTable_map applies.
+ */
+typedef void (*SymTable_Apply)(const char *pcKey, void *pvValue,
+                               void *pvExtra);
+
+/*********************************************************************/
+
+/*
+ * Returns uSize bytes from the allocator of oSymTable, or NULL if
+ * memory is insufficient.
+ */
+static void *SymTable_alloc(SymTable_T oSymTable, size_t uSize) {
+   assert(oSymTable != NULL);
+
+   return (*oSymTable->allocator.pfAlloc)(oSymTable->context, uSize);
+}
+
+/*
+ * Gives pvMemory, an allocation of uSize bytes, back to the allocator
+ * of oSymTable, if that allocator releases memory at all.
+ */
+static void SymTable_release(SymTable_T oSymTable, void *pvMemory,
+                             size_t uSize) {
+   assert(oSymTable != NULL);
+
+   if (oSymTable->allocator.pfFree != NULL) {
+      (*oSymTable->allocator.pfFree)(oSymTable->context, pvMemory,
+                                     uSize);
+   }
+}
+
+/*
+ * Returns the bytes that the allocator of oSymTable spends beyond a
+ * request of uBytes, or 0 if the allocator does not say.
+ */
+static size_t SymTable_allocSlack(SymTable_T oSymTable,
+                                  size_t uBytes) {
+   assert(oSymTable != NULL);
+
+   if (oSymTable->allocator.pfSlack == NULL) {
+      return 0;
+   }
+   return (*oSymTable->allocator.pfSlack)(oSymTable->context, uBytes);
+}
+
+/*
+ * Returns the bytes of a node whose label is uLength characters long.
+ */
+static size_t SymTable_nodeBytes(size_t uLength) {
+   return sizeof(struct Node) + uLength;
+}
+
+/*
+ * Returns a new node, with no children, no sibling, and no key,
+ * whose label is the uFirst characters of pcFirst followed by the
+ * uSecond characters of pcSecond, or NULL if memory is
+ * insufficient.
+ */
+static struct Node *SymTable_newNode(SymTable_T oSymTable,
+                                     const char *pcFirst,
+                                     size_t uFirst,
+                                     const char *pcSecond,
+                                     size_t uSecond) {
+   struct Node *psNode;
+
+   assert(oSymTable != NULL);
+   assert(pcFirst != NULL || uFirst == 0);
+   assert(pcSecond != NULL || uSecond == 0);
+
+   psNode = (struct Node *) SymTable_alloc(oSymTable,
+      SymTable_nodeBytes(uFirst + uSecond));
+   if (psNode == NULL) {
+      return NULL;
+   }
+   psNode->children = NULL;
+   psNode->sibling = NULL;
+   psNode->value = NULL;
+   psNode->count = 0;
+   psNode->labelLength = uFirst + uSecond;
+   psNode->isKey = 0;
+   if (uFirst > 0) {
+      memcpy(psNode->label, pcFirst, uFirst);
+   }
+   if (uSecond > 0) {
+      memcpy(psNode->label + uFirst, pcSecond, uSecond);
+   }
+   psNode->label[uFirst + uSecond] = '\0';
+   return psNode;
+}
+
+/*
+ * Gives psNode back to the allocator of oSymTable.
+ */
+static void SymTable_releaseNode(SymTable_T oSymTable,
+                                 struct Node *psNode) {
+   assert(oSymTable != NULL);
+   assert(psNode != NULL);
+
+   SymTable_release(oSymTable, psNode,
+                    SymTable_nodeBytes(psNode->labelLength));
+}
+
+/*
+ * Returns the link (the children field of psNode or the sibling
+ * field of one of its children) that points to the child of psNode
+ * whose label begins with c, or to where such a child would go.
+ */
+static struct Node **SymTable_childLink(struct Node *psNode, char c) {
+   struct Node **ppsLink;
+
+   assert(psNode != NULL);
+
+   ppsLink = &psNode->children;
+   while (*ppsLink != NULL
+          && (unsigned char)(*ppsLink)->label[0] < (unsigned char)c) {
+      ppsLink = &(*ppsLink)->sibling;
+   }
+   return ppsLink;
+}
+
+/*
+ * Returns the node that stands for pcKey, which may or may not be a
+ * key, or NULL if there is none.
+ */
+static struct Node *SymTable_find(SymTable_T oSymTable,
+                                  const char *pcKey) {
+   struct Node *psNode;
+   struct Node *psChild;
+
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   psNode = oSymTable->root;
+   while (*pcKey != '\0') {
+      psChild = *SymTable_childLink(psNode, *pcKey);
+      if (psChild == NULL || psChild->label[0] != *pcKey
+          || strncmp(psChild->label, pcKey, psChild->labelLength)
+             != 0) {
+         return NULL;
+      }
+      pcKey += psChild->labelLength;
+      psNode = psChild;
+   }
+   return psNode;
+}
+
+/*
+ * Returns the highest node whose key begins with pcPrefix, or NULL
+ * if no key does. If pcBuffer is not NULL, spells out the key of
+ * that node in it, without a '\0', and stores its length in
+ * *puLength.
+ */
+static struct Node *SymTable_locatePrefix(SymTable_T oSymTable,
+                                          const char *pcPrefix,
+                                          char *pcBuffer,
+                                          size_t *puLength) {
+   struct Node *psNode;
+   struct Node *psChild;
+   size_t uLength = 0;
+   size_t u;
+
+   assert(oSymTable != NULL);
+   assert(pcPrefix != NULL);
+
+   psNode = oSymTable->root;
+   while (*pcPrefix != '\0') {
+      psChild = *SymTable_childLink(psNode, *pcPrefix);
+      if (psChild == NULL || psChild->label[0] != *pcPrefix) {
+         return NULL;
+      }
+      /* the prefix may end partway through the label */
+      for (u = 0; u < psChild->labelLength && pcPrefix[u] != '\0';
+           u++) {
+         if (psChild->label[u] != pcPrefix[u]) {
+            return NULL;
+         }
+      }
+      if (pcBuffer != NULL) {
+         memcpy(pcBuffer + uLength, psChild->label,
+                psChild->labelLength);
+      }
+      uLength += psChild->labelLength;
+      pcPrefix += u;
+      psNode = psChild;
+   }
+
+   if (puLength != NULL) {
+      *puLength = uLength;
+   }
+   return psNode;
+}
+
+/*
+ * Adds one to the count of each node from the root down to the node
+ * of pcKey, which must exist.
+ */
+static void SymTable_countKey(SymTable_T oSymTable,
+                              const char *pcKey) {
+   struct Node *psNode;
+
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   psNode = oSymTable->root;
+   for (;;) {
+      psNode->count++;
+      if (*pcKey == '\0') {
+         return;
+      }
+      psNode = *SymTable_childLink(psNode, *pcKey);
+      assert(psNode != NULL);
+      pcKey += psNode->labelLength;
+   }
+}
+
+/*
+ * Restores the shape of the tree at the node that *ppsLink points
+ * to, if it is not the root and has just stopped being a key or lost
+ * a child: a node with neither a key nor children goes, and a node
+ * without a key but with one child is merged with it. A merge that
+ * lacks memory is skipped, which leaves the tree correct.
+ */
+static void SymTable_tidy(SymTable_T oSymTable,
+                          struct Node **ppsLink) {
+   struct Node *psNode;
+   struct Node *psChild;
+   struct Node *psMerged;
+
+   assert(oSymTable != NULL);
+   assert(ppsLink != NULL);
+
+   psNode = *ppsLink;
+   if (psNode == oSymTable->root || psNode->isKey) {
+      return;
+   }
+
+   if (psNode->children == NULL) {
+      *ppsLink = psNode->sibling;
+      SymTable_releaseNode(oSymTable, psNode);
+      return;
+   }
+
+   psChild = psNode->children;
+   if (psChild->sibling != NULL) {
+      return;
+   }
+   psMerged = SymTable_newNode(oSymTable,
+                               psNode->label, psNode->labelLength,
+                               psChild->label, psChild->labelLength);
+   if (psMerged == NULL) {
+      return;
+   }
+   psMerged->children = psChild->children;
+   psMerged->sibling = psNode->sibling;
+   psMerged->value = psChild->value;
+   psMerged->count = psChild->count;
+   psMerged->isKey = psChild->isKey;
+   *ppsLink = psMerged;
+   SymTable_releaseNode(oSymTable, psChild);
+   SymTable_releaseNode(oSymTable, psNode);
+}
+
+/*
+ * Removes pcKey, the rest of a key after the node that *ppsLink
+ * points to, from the subtree of that node, storing its value in
+ * *ppvValue. Returns 1 if successful and 0 if pcKey is absent.
+ */
+static int SymTable_removeAt(SymTable_T oSymTable,
+                             struct Node **ppsLink, const char *pcKey,
+                             void **ppvValue) {
+   struct Node *psNode;
+   struct Node **ppsChildLink;
+   struct Node *psChild;
+
+   assert(oSymTable != NULL);
+   assert(ppsLink != NULL);
+   assert(pcKey != NULL);
+   assert(ppvValue != NULL);
+
+   psNode = *ppsLink;
+   if (*pcKey == '\0') {
+      if (!psNode->isKey) {
+         return 0;
+      }
+      *ppvValue = psNode->value;
+      psNode->isKey = 0;
+      psNode->value = NULL;
+   }
+   else {
+      ppsChildLink = SymTable_childLink(psNode, *pcKey);
+      psChild = *ppsChildLink;
+      if (psChild == NULL || psChild->label[0] != *pcKey
+          || strncmp(psChild->label, pcKey, psChild->labelLength)
+             != 0) {
+         return 0;
+      }
+      if (!SymTable_removeAt(oSymTable, ppsChildLink,
+                             pcKey + psChild->labelLength,
+                             ppvValue)) {
+         return 0;
+      }
+   }
+
+   psNode->count--;
+   SymTable_tidy(oSymTable, ppsLink);
+   return 1;
+}
+
+/*
+ * Applies (*pfApply) to the bindings of the subtree of psNode,
+ * passing pvExtra. The key of psNode is spelled out in the first
+ * uLength bytes of pcBuffer, which every later key overwrites (see
+ * SymTable_map in symtable.h).
+ */
+static void SymTable_mapNode(const struct Node *psNode, char *pcBuffer,
+                             size_t uLength, SymTable_Apply pfApply,
+                             void *pvExtra) {
+   const struct Node *psChild;
+
+   assert(psNode != NULL);
+   assert(pfApply != NULL);
+
+   if (psNode->isKey) {
+      pcBuffer[uLength] = '\0';
+      (*pfApply)(pcBuffer, psNode->value, pvExtra);
+   }
+   for (psChild = psNode->children; psChild != NULL;
+        psChild = psChild->sibling) {
+      memcpy(pcBuffer + uLength, psChild->label, psChild->labelLength);
+      SymTable_mapNode(psChild, pcBuffer,
+                       uLength + psChild->labelLength, pfApply,
+                       pvExtra);
+   }
+}
+
+/*
+ * Gives the subtree of psNode back to the allocator of oSymTable.
+ */
+static void SymTable_freeNode(SymTable_T oSymTable,
+                              struct Node *psNode) {
+   struct Node *psChild;
+   struct Node *psNext;
+
+   assert(oSymTable != NULL);
+   assert(psNode != NULL);
+
+   for (psChild = psNode->children; psChild != NULL;
+        psChild = psNext) {
+      psNext = psChild->sibling;
+      SymTable_freeNode(oSymTable, psChild);
+   }
+   SymTable_releaseNode(oSymTable, psNode);
+}
+
+/*
+ * Adds the memory of the subtree of psNode to *psMemory: the labels,
+ * and a '\0' for each key, as keys, and the rest of the nodes as
+ * nodes.
+ */
+static void SymTable_measure(SymTable_T oSymTable,
+                             const struct Node *psNode,
+                             struct SymTableMemory *psMemory) {
+   const struct Node *psChild;
+   size_t uKeyBytes;
+
+   assert(psNode != NULL);
+   assert(psMemory != NULL);
+
+   for (psChild = psNode->children; psChild != NULL;
+        psChild = psChild->sibling) {
+      uKeyBytes = psChild->labelLength + (psChild->isKey ? 1 : 0);
+      psMemory->keys += uKeyBytes;
+      psMemory->nodes +=
+         SymTable_nodeBytes(psChild->labelLength) - uKeyBytes;
+      psMemory->slack += SymTable_allocSlack(
+         oSymTable, SymTable_nodeBytes(psChild->labelLength));
+      SymTable_measure(oSymTable, psChild, psMemory);
+   }
+}
+
+/*********************************************************************/
+
+/*
+ * Construct a new SymTable_T. Return NULL if memory is insufficient.
+ */
+SymTable_T SymTable_new(void) {
+   struct SymTableAllocator sMalloc;
+
+   SymTableMalloc_getAllocator(&sMalloc);
+   return SymTable_newWithAllocator(&sMalloc, NULL);
+}
+
+/*
+ * Construct a new SymTable_T that gets its memory from *psAllocator.
+ * Return NULL if memory is insufficient.
+ */
+SymTable_T SymTable_newWithAllocator(
+     const struct SymTableAllocator *psAllocator, void *pvContext) {
+   SymTable_T oSymTable;
+
+   assert(psAllocator != NULL);
+   assert(psAllocator->pfAlloc != NULL);
+
+   oSymTable = (SymTable_T)
+      (*psAllocator->pfAlloc)(pvContext, sizeof(struct SymTable));
+   if (oSymTable == NULL) {
+      return NULL;
+   }
+   oSymTable->allocator = *psAllocator;
+   oSymTable->context = pvContext;
+   oSymTable->keyBuffer = NULL;
+   oSymTable->keyBufferSize = 0;
+
+   oSymTable->root = SymTable_newNode(oSymTable, NULL, 0, NULL, 0);
+   if (oSymTable->root == NULL) {
+      SymTable_release(oSymTable, oSymTable, sizeof(struct SymTable));
+      return NULL;
+   }
+   return oSymTable;
+}
+
+/*
+ * Frees all memory previously allocated for a SymTable_T.
+ */
+void SymTable_free(SymTable_T oSymTable) {
+   assert(oSymTable != NULL);
+
+   /* the client releases the memory of such a table all at once */
+   if (oSymTable->allocator.pfFree == NULL) {
+      return;
+   }
+
+   SymTable_freeNode(oSymTable, oSymTable->root);
+   if (oSymTable->keyBuffer != NULL) {
+      SymTable_release(oSymTable, oSymTable->keyBuffer,
+                       oSymTable->keyBufferSize);
+   }
+   SymTable_release(oSymTable, oSymTable, sizeof(struct SymTable));
+}
+
+/*
+ * Returns a size_t specifying the number of bindings contained within
+ * the specified SymTable_T.
+ */
+size_t SymTable_getLength(SymTable_T oSymTable) {
+   assert(oSymTable != NULL);
+
+   return oSymTable->root->count;
+}
+
+/*
+ * Tries to insert a new key-value binding with a String key and
+ * generic value into the specified SymTable_T. Returns 1 if successful
+ * and 0 if binding is already present or memory is insufficient.
+ */
+int SymTable_put(SymTable_T oSymTable,
+                 const char *pcKey, const void *pvValue) {
+   struct Node *psNode;
+   struct Node **ppsLink;
+   struct Node *psChild;
+   struct Node *psUpper;
+   struct Node *psLower;
+   char *pcBuffer;
+   const char *pc;
+   size_t uKeyLength;
+   size_t u;
+
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   psNode = SymTable_find(oSymTable, pcKey);
+   if (psNode != NULL && psNode->isKey) {
+      return 0;
+   }
+
+   /* the buffer of SymTable_map must hold the new key */
+   uKeyLength = strlen(pcKey);
+   if (uKeyLength >= oSymTable->keyBufferSize) {
+      pcBuffer = (char *) SymTable_alloc(oSymTable, uKeyLength + 1);
+      if (pcBuffer == NULL) {
+         return 0;
+      }
+      if (oSymTable->keyBuffer != NULL) {
+         SymTable_release(oSymTable, oSymTable->keyBuffer,
+                          oSymTable->keyBufferSize);
+      }
+      oSymTable->keyBuffer = pcBuffer;
+      oSymTable->keyBufferSize = uKeyLength + 1;
+   }
+
+   psNode = oSymTable->root;
+   pc = pcKey;
+   while (*pc != '\0') {
+      ppsLink = SymTable_childLink(psNode, *pc);
+      psChild = *ppsLink;
+
+      /* no child shares a character with the rest of the key */
+      if (psChild == NULL || psChild->label[0] != *pc) {
+         psNode = SymTable_newNode(oSymTable, pc, strlen(pc), NULL, 0);
+         if (psNode == NULL) {
+            return 0;
+         }
+         psNode->sibling = psChild;
+         *ppsLink = psNode;
+         break;
+      }
+
+      u = 1;
+      while (u < psChild->labelLength && psChild->label[u] == pc[u]) {
+         u++;
+      }
+
+      /* the rest of the key ends or differs partway through the
+         label, which is split there */
+      if (u < psChild->labelLength) {
+         psUpper = SymTable_newNode(oSymTable, psChild->label, u,
+                                    NULL, 0);
+         psLower = SymTable_newNode(oSymTable, psChild->label + u,
+                                    psChild->labelLength - u, NULL, 0);
+         if (psUpper == NULL || psLower == NULL) {
+            if (psUpper != NULL) {
+               SymTable_releaseNode(oSymTable, psUpper);
+            }
+            if (psLower != NULL) {
+               SymTable_releaseNode(oSymTable, psLower);
+            }
+            return 0;
+         }
+         psLower->children = psChild->children;
+         psLower->value = psChild->value;
+         psLower->count = psChild->count;
+         psLower->isKey = psChild->isKey;
+         psUpper->children = psLower;
+         psUpper->sibling = psChild->sibling;
+         psUpper->count = psChild->count;
+         *ppsLink = psUpper;
+         SymTable_releaseNode(oSymTable, psChild);
+         psChild = psUpper;
+      }
+
+      psNode = psChild;
+      pc += u;
+   }
+
+   psNode->isKey = 1;
+   psNode->value = (void *) pvValue;
+   SymTable_countKey(oSymTable, pcKey);
+   return 1;
+}
+
+/*
+ * If pcKey is present in oSymTable, its value is changed to pvValue
+ * and the old value is returned. Otherwise, NULL is returned.
+ */
+void *SymTable_replace(SymTable_T oSymTable,
+     const char *pcKey, const void *pvValue) {
+   struct Node *psNode;
+   void *pvOldValue;
+
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   psNode = SymTable_find(oSymTable, pcKey);
+   if (psNode == NULL || !psNode->isKey) {
+      return NULL;
+   }
+   pvOldValue = psNode->value;
+   psNode->value = (void *) pvValue;
+   return pvOldValue;
+}
+
+/*
+ * Returns 1 if pcKey is present in oSymTable and 0 otherwise.
+ */
+int SymTable_contains(SymTable_T oSymTable, const char *pcKey) {
+   struct Node *psNode;
+
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   psNode = SymTable_find(oSymTable, pcKey);
+   return psNode != NULL && psNode->isKey;
+}
+
+/*
+ * If pcKey is present in oSymTable, returns its associated value.
+ * Returns NULL otherwise.
+ */
+void *SymTable_get(SymTable_T oSymTable, const char *pcKey) {
+   struct Node *psNode;
+
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   psNode = SymTable_find(oSymTable, pcKey);
+   if (psNode == NULL || !psNode->isKey) {
+      return NULL;
+   }
+   return psNode->value;
+}
+
+/*
+ * If pcKey is present in oSymTable, removes its binding and returns
+ * the associated value. Returns NULL otherwise.
+ */
+void *SymTable_remove(SymTable_T oSymTable, const char *pcKey) {
+   void *pvValue = NULL;
+
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   if (!SymTable_removeAt(oSymTable, &oSymTable->root, pcKey,
+                          &pvValue)) {
+      return NULL;
+   }
+
+   /* an empty table holds no more than a new one */
+   if (oSymTable->root->count == 0 && oSymTable->keyBuffer != NULL) {
+      SymTable_release(oSymTable, oSymTable->keyBuffer,
+                       oSymTable->keyBufferSize);
+      oSymTable->keyBuffer = NULL;
+      oSymTable->keyBufferSize = 0;
+   }
+   return pvValue;
+}
+
+/*
+ * Applies (*pfApply) to all bindings in the symbol table, in order of
+ * key, passing *pvExtra as a parameter.
+ */
+void SymTable_map(SymTable_T oSymTable,
+     void (*pfApply)(const char *pcKey, void *pvValue, void *pvExtra),
+                  const void *pvExtra) {
+   assert(oSymTable != NULL);
+   assert(pfApply != NULL);
+
+   if (oSymTable->root->count == 0) {
+      return;
+   }
+   SymTable_mapNode(oSymTable->root, oSymTable->keyBuffer, 0, pfApply,
+                    (void *) pvExtra);
+}
+
+/*
+ * Applies (*pfApply) to each binding of oSymTable whose key begins
+ * with pcPrefix, in order of key, passing pvExtra as a parameter.
+ */
+void SymTable_mapPrefix(SymTable_T oSymTable, const char *pcPrefix,
+     void (*pfApply)(const char *pcKey, void *pvValue, void *pvExtra),
+     const void *pvExtra) {
+   struct Node *psNode;
+   size_t uLength;
+
+   assert(oSymTable != NULL);
+   assert(pcPrefix != NULL);
+   assert(pfApply != NULL);
+
+   if (oSymTable->root->count == 0) {
+      return;
+   }
+   psNode = SymTable_locatePrefix(oSymTable, pcPrefix,
+                                  oSymTable->keyBuffer, &uLength);
+   if (psNode == NULL) {
+      return;
+   }
+   SymTable_mapNode(psNode, oSymTable->keyBuffer, uLength, pfApply,
+                    (void *) pvExtra);
+}
+
+/*
+ * Returns the number of bindings of oSymTable whose keys begin with
+ * pcPrefix.
+ */
+size_t SymTable_countPrefix(SymTable_T oSymTable,
+                            const char *pcPrefix) {
+   struct Node *psNode;
+
+   assert(oSymTable != NULL);
+   assert(pcPrefix != NULL);
+
+   psNode = SymTable_locatePrefix(oSymTable, pcPrefix, NULL, NULL);
+   if (psNode == NULL) {
+      return 0;
+   }
+   return psNode->count;
+}
+
+/*
+ * Fills in *psMemory with the memory that oSymTable holds. The root
+ * and the buffer of SymTable_map are counted with the table; there
+ * are no buckets.
+ */
+void SymTable_memoryUsage(SymTable_T oSymTable,
+                          struct SymTableMemory *psMemory) {
+   size_t uRootBytes;
+
+   assert(oSymTable != NULL);
+   assert(psMemory != NULL);
+
+   /* the '\0' of the root is the key "", if that is present */
+   uRootBytes = SymTable_nodeBytes(0);
+   psMemory->keys = oSymTable->root->isKey ? 1 : 0;
+   psMemory->table = sizeof(struct SymTable) + uRootBytes
+      - psMemory->keys + oSymTable->keyBufferSize;
+   psMemory->buckets = 0;
+   psMemory->nodes = 0;
+   psMemory->slack =
+      SymTable_allocSlack(oSymTable, sizeof(struct SymTable))
+      + SymTable_allocSlack(oSymTable, uRootBytes)
+      + ((oSymTable->keyBuffer == NULL) ? 0
+         : SymTable_allocSlack(oSymTable, oSymTable->keyBufferSize));
+   SymTable_measure(oSymTable, oSymTable->root, psMemory);
+   psMemory->total = psMemory->table + psMemory->buckets
+      + psMemory->nodes + psMemory->keys + psMemory->slack;
+}
@@ -0,0 +1,49 @@
+/*********************************************************************/
+/* symtableradix.h                                                   */
+/* COS 217 Assignment 3: A Symbol Table ADT                          */
+/* Date: 10/31/2023                                                  */
+/* Author: Hugh Peterson                                             */
+/* Description: Operations that only the radix tree implementation   */
+/*              of the symbol table module (symtableradix.c)         */
+/*              provides                                             */
+/*********************************************************************/
+
+/*********************************************************************/
+
+#ifndef SYMTABLERADIX_INCLUDED
+#define SYMTABLERADIX_INCLUDED
+
+#include <stddef.h>
+#include "symtable.h"
+
+/*
+ * In symtableradix.c, keys that share a prefix share the nodes that
+ * spell it, and the bindings are kept in order of key (comparing
+ * characters as unsigned char). SymTable_map visits them in that
+ * order. The key that SymTable_map and SymTable_mapPrefix pass to
+ * pfApply is spelled out in a buffer of the table, so it is valid
+ * only until pfApply returns, and pfApply must not call the
+ * functions of the table.
+ */
+
+/*********************************************************************/
+
+/*
+ * Applies (*pfApply) to each binding of oSymTable whose key begins
+ * with pcPrefix, in order of key, passing pvExtra as a parameter.
+ * Takes time proportional to the length of pcPrefix plus the number
+ * of such bindings, not to the size of the table.
+ */
+void SymTable_mapPrefix(SymTable_T oSymTable, const char *pcPrefix,
+     void (*pfApply)(const char *pcKey, void *pvValue, void *pvExtra),
+     const void *pvExtra);
+
+/*
+ * Returns the number of bindings of oSymTable whose keys begin with
+ * pcPrefix, in time proportional to the length of pcPrefix.
+ */
+size_t SymTable_countPrefix(SymTable_T oSymTable, const char *pcPrefix);
+
+/*********************************************************************/
+
+#endif
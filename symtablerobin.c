@@ -0,0 +1,496 @@
+/*********************************************************************/
+/* symtablerobin.c                                                   */
+/* COS 217 Assignment 3: A Symbol Table ADT                          */
+/* Date: 10/31/2023                                                  */
+/* Author: Hugh Peterson                                             */
+/* Description: A symbol table module to associate string keys with  */
+/*              generic values (Robin Hood linear probing            */
+/*              implementation)                                      */
+/*********************************************************************/
+
+/*********************************************************************/
+
+#include <assert.h>
+#include <string.h>
+#include "symtable.h"
+#include "symtablemalloc.h"
+
+/*
+ * With -DSYMTABLE_LATENCY, put, get, remove, and map are compiled
+ * under other names and timed by symtablelatency.c.
+ */
+#ifdef SYMTABLE_LATENCY
+#include "symtablelatency.h"
+#define SymTable_put SymTable_untimedPut
+#define SymTable_get SymTable_untimedGet
+#define SymTable_remove SymTable_untimedRemove
+#define SymTable_map SymTable_untimedMap
+#endif
+
+/*********************************************************************/
+
+enum {
+   /* number of slots of a new table; always a power of two */
+   INITIAL_CAPACITY = 512,
+
+   /* the table doubles before more than MAX_LOAD_NUMERATOR /
+      MAX_LOAD_DENOMINATOR of its slots would be in use */
+   MAX_LOAD_NUMERATOR = 9,
+   MAX_LOAD_DENOMINATOR = 10
+};
+
+/*********************************************************************/
+
+/*
+ * A binding, or an empty slot if key is NULL.
+ */
+struct Slot {
+   /* the key, which the table owns */
+   char *key;
+
+   /* the value */
+   void *value;
+
+   /* the low bits of the hash of the key: compared before the key,
+      and enough to find the key's home slot in any table of up to
+      2^32 slots */
+   unsigned int hash;
+
+   /* the distance of the slot from the key's home slot */
+   unsigned int distance;
+};
+
+/*
+ * An open-addressing table with linear probing and Robin Hood
+ * insertion: a key being inserted takes the slot of any key closer
+ * to its home slot than the key is to its own, and that key moves on
+ * instead. Probe distances therefore stay short and even at high
+ * load, and a lookup can stop at the first key closer to home than
+ * it would be. Removal shifts the rest of the probe run back, so no
+ * tombstones are left to slow later lookups.
+ */
+struct SymTable {
+   /* the slots */
+   struct Slot *slots;
+
+   /* number of slots; always a power of two */
+   size_t capacity;
+
+   /* number of bindings */
+   size_t size;
+
+   /* the source of all memory of the table */
+   struct SymTableAllocator allocator;
+
+   /* the context pointer passed to the allocator */
+   void *context;
+};
+
+/*********************************************************************/
+
+/*
+ * Returns the hash code of pcKey: the hash of symtablehash.c, mixed
+ * (by the MurmurHash3 finalizer) so that the low bits that pick the
+ * home slot depend on every byte of the key.
+ */
+static unsigned int SymTable_hash(const char *pcKey) {
+   const size_t HASH_MULTIPLIER = 65599;
+
+   size_t u;
+   size_t uHash = 0;
+
+   assert(pcKey != NULL);
+
+   for (u = 0; pcKey[u] != '\0'; u++) {
+      uHash = uHash * HASH_MULTIPLIER + (size_t)pcKey[u];
+   }
+
+   uHash ^= uHash >> 33;
+   uHash *= (size_t)0xff51afd7ed558ccdUL;
+   uHash ^= uHash >> 33;
+   uHash *= (size_t)0xc4ceb9fe1a85ec53UL;
+   uHash ^= uHash >> 33;
+   return (unsigned int)uHash;
+}
+
+/*
+ * Returns uSize bytes from the allocator of oSymTable, or NULL if
+ * memory is insufficient.
+ */
+static void *SymTable_alloc(SymTable_T oSymTable, size_t uSize) {
+   assert(oSymTable != NULL);
+
+   return (*oSymTable->allocator.pfAlloc)(oSymTable->context, uSize);
+}
+
+/*
+ * Gives pvMemory, an allocation of uSize bytes, back to the allocator
+ * of oSymTable, if that allocator releases memory at all.
+ */
+static void SymTable_release(SymTable_T oSymTable, void *pvMemory,
+                             size_t uSize) {
+   assert(oSymTable != NULL);
+
+   if (oSymTable->allocator.pfFree != NULL) {
+      (*oSymTable->allocator.pfFree)(oSymTable->context, pvMemory,
+                                     uSize);
+   }
+}
+
+/*
+ * Returns the bytes that the allocator of oSymTable spends beyond a
+ * request of uBytes, or 0 if the allocator does not say.
+ */
+static size_t SymTable_allocSlack(SymTable_T oSymTable,
+                                  size_t uBytes) {
+   assert(oSymTable != NULL);
+
+   if (oSymTable->allocator.pfSlack == NULL) {
+      return 0;
+   }
+   return (*oSymTable->allocator.pfSlack)(oSymTable->context, uBytes);
+}
+
+/*
+ * Returns the slot of oSymTable holding pcKey, whose hash code is
+ * uHash, or NULL if pcKey is absent.
+ */
+static struct Slot *SymTable_find(SymTable_T oSymTable,
+                                  const char *pcKey,
+                                  unsigned int uHash) {
+   struct Slot *psSlot;
+   size_t uMask;
+   size_t u;
+   unsigned int uDistance;
+
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   uMask = oSymTable->capacity - 1;
+   for (u = uHash & uMask, uDistance = 0; ;
+        u = (u + 1) & uMask, uDistance++) {
+      psSlot = &oSymTable->slots[u];
+      /* pcKey would have taken the slot of a key closer to home */
+      if (psSlot->key == NULL || psSlot->distance < uDistance) {
+         return NULL;
+      }
+      if (psSlot->hash == uHash && strcmp(psSlot->key, pcKey) == 0) {
+         return psSlot;
+      }
+   }
+}
+
+/*
+ * Inserts sSlot, whose distance is ignored, into the uCapacity slots
+ * asSlots, which have room for it.
+ */
+static void SymTable_insert(struct Slot *asSlots, size_t uCapacity,
+                            struct Slot sSlot) {
+   struct Slot sDisplaced;
+   size_t uMask;
+   size_t u;
+
+   assert(asSlots != NULL);
+
+   uMask = uCapacity - 1;
+   sSlot.distance = 0;
+   for (u = sSlot.hash & uMask; ; u = (u + 1) & uMask) {
+      if (asSlots[u].key == NULL) {
+         asSlots[u] = sSlot;
+         return;
+      }
+      /* take from the rich: the closer key moves on instead */
+      if (asSlots[u].distance < sSlot.distance) {
+         sDisplaced = asSlots[u];
+         asSlots[u] = sSlot;
+         sSlot = sDisplaced;
+      }
+      sSlot.distance++;
+   }
+}
+
+/*
+ * Doubles the capacity of oSymTable. Returns 1 if successful and 0 if
+ * memory is insufficient, in which case oSymTable is unchanged.
+ */
+static int SymTable_grow(SymTable_T oSymTable) {
+   struct Slot *asNewSlots;
+   size_t uNewCapacity;
+   size_t u;
+
+   assert(oSymTable != NULL);
+
+   uNewCapacity = 2 * oSymTable->capacity;
+   asNewSlots = (struct Slot *)
+      SymTable_alloc(oSymTable, uNewCapacity * sizeof(struct Slot));
+   if (asNewSlots == NULL) {
+      return 0;
+   }
+   memset(asNewSlots, 0, uNewCapacity * sizeof(struct Slot));
+
+   for (u = 0; u < oSymTable->capacity; u++) {
+      if (oSymTable->slots[u].key != NULL) {
+         SymTable_insert(asNewSlots, uNewCapacity,
+                         oSymTable->slots[u]);
+      }
+   }
+
+   SymTable_release(oSymTable, oSymTable->slots,
+                    oSymTable->capacity * sizeof(struct Slot));
+   oSymTable->slots = asNewSlots;
+   oSymTable->capacity = uNewCapacity;
+   return 1;
+}
+
+/*********************************************************************/
+
+/*
+ * Construct a new SymTable_T. Return NULL if memory is insufficient.
+ */
+SymTable_T SymTable_new(void) {
+   struct SymTableAllocator sMalloc;
+
+   SymTableMalloc_getAllocator(&sMalloc);
+   return SymTable_newWithAllocator(&sMalloc, NULL);
+}
+
+/*
+ * Construct a new SymTable_T that gets its memory from *psAllocator.
+ * Return NULL if memory is insufficient.
+ */
+SymTable_T SymTable_newWithAllocator(
+     const struct SymTableAllocator *psAllocator, void *pvContext) {
+   SymTable_T oSymTable;
+   size_t uBytes;
+
+   assert(psAllocator != NULL);
+   assert(psAllocator->pfAlloc != NULL);
+
+   oSymTable = (SymTable_T)
+      (*psAllocator->pfAlloc)(pvContext, sizeof(struct SymTable));
+   if (oSymTable == NULL) {
+      return NULL;
+   }
+   oSymTable->allocator = *psAllocator;
+   oSymTable->context = pvContext;
+
+   uBytes = (size_t)INITIAL_CAPACITY * sizeof(struct Slot);
+   oSymTable->slots = (struct Slot *) SymTable_alloc(oSymTable, uBytes);
+   if (oSymTable->slots == NULL) {
+      SymTable_release(oSymTable, oSymTable, sizeof(struct SymTable));
+      return NULL;
+   }
+   memset(oSymTable->slots, 0, uBytes);
+   oSymTable->capacity = INITIAL_CAPACITY;
+   oSymTable->size = 0;
+   return oSymTable;
+}
+
+/*
+ * Frees all memory previously allocated for a SymTable_T
+ */
+void SymTable_free(SymTable_T oSymTable) {
+   size_t u;
+
+   assert(oSymTable != NULL);
+
+   /* the client releases the memory of such a table all at once */
+   if (oSymTable->allocator.pfFree == NULL) {
+      return;
+   }
+
+   for (u = 0; u < oSymTable->capacity; u++) {
+      if (oSymTable->slots[u].key != NULL) {
+         SymTable_release(oSymTable, oSymTable->slots[u].key,
+                          strlen(oSymTable->slots[u].key) + 1);
+      }
+   }
+   SymTable_release(oSymTable, oSymTable->slots,
+                    oSymTable->capacity * sizeof(struct Slot));
+   SymTable_release(oSymTable, oSymTable, sizeof(struct SymTable));
+}
+
+/*
+ * Returns a size_t specifying the number of bindings contained within
+ * the specified SymTable_T.
+ */
+size_t SymTable_getLength(SymTable_T oSymTable) {
+   assert(oSymTable != NULL);
+
+   return oSymTable->size;
+}
+
+/*
+ * Tries to insert a new key-value binding with a String key and
+ * generic value into the specified SymTable_T. Returns 1 if successful
+ * and 0 if binding is already present or memory is insufficient.
+ */
+int SymTable_put(SymTable_T oSymTable,
+                 const char *pcKey, const void *pvValue) {
+   struct Slot sSlot;
+   size_t uKeyBytes;
+
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   sSlot.hash = SymTable_hash(pcKey);
+   if (SymTable_find(oSymTable, pcKey, sSlot.hash) != NULL) {
+      return 0;
+   }
+   if ((oSymTable->size + 1) * MAX_LOAD_DENOMINATOR
+       > oSymTable->capacity * MAX_LOAD_NUMERATOR
+       && !SymTable_grow(oSymTable)) {
+      return 0;
+   }
+
+   uKeyBytes = strlen(pcKey) + 1;
+   sSlot.key = (char *) SymTable_alloc(oSymTable, uKeyBytes);
+   if (sSlot.key == NULL) {
+      return 0;
+   }
+   memcpy(sSlot.key, pcKey, uKeyBytes);
+   sSlot.value = (void *) pvValue;
+
+   SymTable_insert(oSymTable->slots, oSymTable->capacity, sSlot);
+   oSymTable->size++;
+   return 1;
+}
+
+/*
+ * If pcKey is present in oSymTable, its value is changed to pvValue
+ * and the old value is returned. Otherwise, NULL is returned.
+ */
+void *SymTable_replace(SymTable_T oSymTable,
+     const char *pcKey, const void *pvValue) {
+   struct Slot *psSlot;
+   void *pvOldValue;
+
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   psSlot = SymTable_find(oSymTable, pcKey, SymTable_hash(pcKey));
+   if (psSlot == NULL) {
+      return NULL;
+   }
+   pvOldValue = psSlot->value;
+   psSlot->value = (void *) pvValue;
+   return pvOldValue;
+}
+
+/*
+ * Returns 1 if pcKey is present in oSymTable and 0 otherwise.
+ */
+int SymTable_contains(SymTable_T oSymTable, const char *pcKey) {
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   return SymTable_find(oSymTable, pcKey, SymTable_hash(pcKey))
+      != NULL;
+}
+
+/*
+ * If pcKey is present in oSymTable, returns its associated value.
+ * Returns NULL otherwise.
+ */
+void *SymTable_get(SymTable_T oSymTable, const char *pcKey) {
+   struct Slot *psSlot;
+
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   psSlot = SymTable_find(oSymTable, pcKey, SymTable_hash(pcKey));
+   if (psSlot == NULL) {
+      return NULL;
+   }
+   return psSlot->value;
+}
+
+/*
+ * If pcKey is present in oSymTable, removes its binding and returns
+ * the associated value. Returns NULL otherwise.
+ */
+void *SymTable_remove(SymTable_T oSymTable, const char *pcKey) {
+   struct Slot *psSlot;
+   void *pvOldValue;
+   size_t uMask;
+   size_t uHole;
+   size_t u;
+
+   assert(oSymTable != NULL);
+   assert(pcKey != NULL);
+
+   psSlot = SymTable_find(oSymTable, pcKey, SymTable_hash(pcKey));
+   if (psSlot == NULL) {
+      return NULL;
+   }
+   pvOldValue = psSlot->value;
+   SymTable_release(oSymTable, psSlot->key, strlen(psSlot->key) + 1);
+
+   /* shift the rest of the probe run back, one slot closer to home */
+   uMask = oSymTable->capacity - 1;
+   uHole = (size_t)(psSlot - oSymTable->slots);
+   for (u = (uHole + 1) & uMask;
+        oSymTable->slots[u].key != NULL
+           && oSymTable->slots[u].distance > 0;
+        u = (u + 1) & uMask) {
+      oSymTable->slots[uHole] = oSymTable->slots[u];
+      oSymTable->slots[uHole].distance--;
+      uHole = u;
+   }
+   oSymTable->slots[uHole].key = NULL;
+   oSymTable->size--;
+   return pvOldValue;
+}
+
+/*
+ * Applies (*pfApply) to all bindings in the symbol table, passing
+ * *pvExtra as a parameter.
+ */
+void SymTable_map(SymTable_T oSymTable,
+     void (*pfApply)(const char *pcKey, void *pvValue, void *pvExtra),
+                  const void *pvExtra) {
+   size_t u;
+
+   assert(oSymTable != NULL);
+   assert(pfApply != NULL);
+
+   for (u = 0; u < oSymTable->capacity; u++) {
+      if (oSymTable->slots[u].key != NULL) {
+         (*pfApply)(oSymTable->slots[u].key, oSymTable->slots[u].value,
+                    (void *) pvExtra);
+      }
+   }
+}
+
+/*
+ * Fills in *psMemory with the memory that oSymTable holds. The slots
+ * that hold bindings are reported as nodes, and the empty ones as
+ * buckets.
+ */
+void SymTable_memoryUsage(SymTable_T oSymTable,
+                          struct SymTableMemory *psMemory) {
+   size_t uArrayBytes;
+   size_t uKeyBytes;
+   size_t u;
+
+   assert(oSymTable != NULL);
+   assert(psMemory != NULL);
+
+   uArrayBytes = oSymTable->capacity * sizeof(struct Slot);
+   psMemory->table = sizeof(struct SymTable);
+   psMemory->nodes = oSymTable->size * sizeof(struct Slot);
+   psMemory->buckets = uArrayBytes - psMemory->nodes;
+   psMemory->keys = 0;
+   psMemory->slack = SymTable_allocSlack(oSymTable, psMemory->table)
+      + SymTable_allocSlack(oSymTable, uArrayBytes);
+
+   for (u = 0; u < oSymTable->capacity; u++) {
+      if (oSymTable->slots[u].key != NULL) {
+         uKeyBytes = strlen(oSymTable->slots[u].key) + 1;
+         psMemory->keys += uKeyBytes;
+         psMemory->slack += SymTable_allocSlack(oSymTable, uKeyBytes);
+      }
+   }
+   psMemory->total = psMemory->table + psMemory->buckets
+      + psMemory->nodes + psMemory->keys + psMemory->slack;
+}
@@ -0,0 +1,308 @@
+/*********************************************************************/
+/* symtablesharded.c                                                 */
+/* COS 217 Assignment 3: A Symbol Table ADT                          */
+/* Date: 10/31/2023                                                  */
+/* Author: Hugh Peterson                                             */
+/* Description: A symbol table that many threads may use at once,    */
+/*              split into independently locked SymTable_T shards    */
+/*********************************************************************/
+
+/*********************************************************************/
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include "symtablesharded.h"
+
+/* the latency histograms are not safe for use by many threads at
+   once (see symtablelatency.h) */
+#ifdef SYMTABLE_LATENCY
+#error "symtablesharded.c cannot be built with -DSYMTABLE_LATENCY"
+#endif
+
+/*********************************************************************/
+
+enum {
+   /* bytes of a cache line, which no two shards share */
+   CACHE_LINE_BYTES = 64
+};
+
+/*
+ * A SymTable_T and the mutex that guards it.
+ */
+struct Shard {
+   /* held during every operation on table */
+   pthread_mutex_t lock;
+
+   /* the bindings of the shard */
+   SymTable_T table;
+
+   /* keeps the locks of neighbouring shards off each other's cache
+      lines, so that threads on different shards do not contend */
+   char padding[CACHE_LINE_BYTES];
+};
+
+/*
+ * The shards of a SymTableSharded_T.
+ */
+struct SymTableSharded {
+   /* the shards */
+   struct Shard *shards;
+
+   /* number of shards; always a power of two */
+   size_t shardCount;
+
+   /* log2(shardCount): the number of high bits of the hash that
+      select a shard */
+   int shardBits;
+};
+
+/*********************************************************************/
+
+/*
+ * Returns the shard of oSharded that holds pcKey. The hash of
+ * symtablehash.c is mixed (by the MurmurHash3 finalizer) and its
+ * high bits used, since the low bits of the unmixed hash choose the
+ * bucket within the shard.
+ */
+static struct Shard *SymTableSharded_shard(SymTableSharded_T oSharded,
+                                           const char *pcKey) {
+   const size_t HASH_MULTIPLIER = 65599;
+
+   size_t u;
+   size_t uHash = 0;
+
+   assert(oSharded != NULL);
+   assert(pcKey != NULL);
+
+   if (oSharded->shardBits == 0) {
+      return &oSharded->shards[0];
+   }
+
+   for (u = 0; pcKey[u] != '\0'; u++) {
+      uHash = uHash * HASH_MULTIPLIER + (size_t)pcKey[u];
+   }
+   uHash ^= uHash >> 33;
+   uHash *= (size_t)0xff51afd7ed558ccdUL;
+   uHash ^= uHash >> 33;
+   uHash *= (size_t)0xc4ceb9fe1a85ec53UL;
+   uHash ^= uHash >> 33;
+
+   return &oSharded->shards[
+      uHash >> (8 * sizeof(size_t) - (size_t)oSharded->shardBits)];
+}
+
+/*********************************************************************/
+
+/*
+ * Construct a new SymTableSharded_T of at least uShardCount shards.
+ * Return NULL if uShardCount is 0 or memory is insufficient.
+ */
+SymTableSharded_T SymTableSharded_new(size_t uShardCount) {
+   SymTableSharded_T oSharded;
+   size_t u;
+
+   if (uShardCount == 0) {
+      return NULL;
+   }
+
+   oSharded = (SymTableSharded_T)
+      malloc(sizeof(struct SymTableSharded));
+   if (oSharded == NULL) {
+      return NULL;
+   }
+   oSharded->shardCount = 1;
+   oSharded->shardBits = 0;
+   while (oSharded->shardCount < uShardCount) {
+      oSharded->shardCount *= 2;
+      oSharded->shardBits++;
+   }
+
+   oSharded->shards = (struct Shard *)
+      malloc(oSharded->shardCount * sizeof(struct Shard));
+   if (oSharded->shards == NULL) {
+      free(oSharded);
+      return NULL;
+   }
+
+   for (u = 0; u < oSharded->shardCount; u++) {
+      oSharded->shards[u].table = SymTable_new();
+      if (oSharded->shards[u].table == NULL) {
+         break;
+      }
+      if (pthread_mutex_init(&oSharded->shards[u].lock, NULL) != 0) {
+         SymTable_free(oSharded->shards[u].table);
+         break;
+      }
+   }
+
+   /* undo the shards made before a failure */
+   if (u < oSharded->shardCount) {
+      while (u-- > 0) {
+         pthread_mutex_destroy(&oSharded->shards[u].lock);
+         SymTable_free(oSharded->shards[u].table);
+      }
+      free(oSharded->shards);
+      free(oSharded);
+      return NULL;
+   }
+   return oSharded;
+}
+
+/*
+ * Frees all memory previously allocated for a SymTableSharded_T.
+ */
+void SymTableSharded_free(SymTableSharded_T oSharded) {
+   size_t u;
+
+   assert(oSharded != NULL);
+
+   for (u = 0; u < oSharded->shardCount; u++) {
+      pthread_mutex_destroy(&oSharded->shards[u].lock);
+      SymTable_free(oSharded->shards[u].table);
+   }
+   free(oSharded->shards);
+   free(oSharded);
+}
+
+/*
+ * Returns the number of shards of oSharded.
+ */
+size_t SymTableSharded_getShardCount(SymTableSharded_T oSharded) {
+   assert(oSharded != NULL);
+
+   return oSharded->shardCount;
+}
+
+/*
+ * Returns the number of bindings contained within oSharded.
+ */
+size_t SymTableSharded_getLength(SymTableSharded_T oSharded) {
+   size_t uLength = 0;
+   size_t u;
+
+   assert(oSharded != NULL);
+
+   for (u = 0; u < oSharded->shardCount; u++) {
+      pthread_mutex_lock(&oSharded->shards[u].lock);
+      uLength += SymTable_getLength(oSharded->shards[u].table);
+      pthread_mutex_unlock(&oSharded->shards[u].lock);
+   }
+   return uLength;
+}
+
+/*
+ * Tries to insert a binding of key pcKey to value pvValue into
+ * oSharded. Returns 1 if successful and 0 if pcKey is already present
+ * or memory is insufficient.
+ */
+int SymTableSharded_put(SymTableSharded_T oSharded,
+     const char *pcKey, const void *pvValue) {
+   struct Shard *psShard;
+   int iSuccessful;
+
+   assert(oSharded != NULL);
+   assert(pcKey != NULL);
+
+   psShard = SymTableSharded_shard(oSharded, pcKey);
+   pthread_mutex_lock(&psShard->lock);
+   iSuccessful = SymTable_put(psShard->table, pcKey, pvValue);
+   pthread_mutex_unlock(&psShard->lock);
+   return iSuccessful;
+}
+
+/*
+ * If pcKey is present in oSharded, its value is changed to pvValue
+ * and the old value is returned. Otherwise, NULL is returned.
+ */
+void *SymTableSharded_replace(SymTableSharded_T oSharded,
+     const char *pcKey, const void *pvValue) {
+   struct Shard *psShard;
+   void *pvOldValue;
+
+   assert(oSharded != NULL);
+   assert(pcKey != NULL);
+
+   psShard = SymTableSharded_shard(oSharded, pcKey);
+   pthread_mutex_lock(&psShard->lock);
+   pvOldValue = SymTable_replace(psShard->table, pcKey, pvValue);
+   pthread_mutex_unlock(&psShard->lock);
+   return pvOldValue;
+}
+
+/*
+ * Returns 1 if pcKey is present in oSharded and 0 otherwise.
+ */
+int SymTableSharded_contains(SymTableSharded_T oSharded,
+     const char *pcKey) {
+   struct Shard *psShard;
+   int iFound;
+
+   assert(oSharded != NULL);
+   assert(pcKey != NULL);
+
+   psShard = SymTableSharded_shard(oSharded, pcKey);
+   pthread_mutex_lock(&psShard->lock);
+   iFound = SymTable_contains(psShard->table, pcKey);
+   pthread_mutex_unlock(&psShard->lock);
+   return iFound;
+}
+
+/*
+ * If pcKey is present in oSharded, returns its associated value.
+ * Returns NULL otherwise.
+ */
+void *SymTableSharded_get(SymTableSharded_T oSharded,
+     const char *pcKey) {
+   struct Shard *psShard;
+   void *pvValue;
+
+   assert(oSharded != NULL);
+   assert(pcKey != NULL);
+
+   psShard = SymTableSharded_shard(oSharded, pcKey);
+   pthread_mutex_lock(&psShard->lock);
+   pvValue = SymTable_get(psShard->table, pcKey);
+   pthread_mutex_unlock(&psShard->lock);
+   return pvValue;
+}
+
+/*
+ * If pcKey is present in oSharded, removes its binding and returns
+ * the associated value. Returns NULL otherwise.
+ */
+void *SymTableSharded_remove(SymTableSharded_T oSharded,
+     const char *pcKey) {
+   struct Shard *psShard;
+   void *pvOldValue;
+
+   assert(oSharded != NULL);
+   assert(pcKey != NULL);
+
+   psShard = SymTableSharded_shard(oSharded, pcKey);
+   pthread_mutex_lock(&psShard->lock);
+   pvOldValue = SymTable_remove(psShard->table, pcKey);
+   pthread_mutex_unlock(&psShard->lock);
+   return pvOldValue;
+}
+
+/*
+ * Applies (*pfApply) to all bindings in oSharded, passing pvExtra as
+ * a parameter, one shard at a time.
+ */
+void SymTableSharded_map(SymTableSharded_T oSharded,
+     void (*pfApply)(const char *pcKey, void *pvValue, void *pvExtra),
+     const void *pvExtra) {
+   size_t u;
+
+   assert(oSharded != NULL);
+   assert(pfApply != NULL);
+
+   for (u = 0; u < oSharded->shardCount; u++) {
+      pthread_mutex_lock(&oSharded->shards[u].lock);
+      SymTable_map(oSharded->shards[u].table, pfApply, pvExtra);
+      pthread_mutex_unlock(&oSharded->shards[u].lock);
+   }
+}
@@ -0,0 +1,101 @@
+/*********************************************************************/
+/* symtablesharded.h                                                 */
+/* COS 217 Assignment 3: A Symbol Table ADT                          */
+/* Date: 10/31/2023                                                  */
+/* Author: Hugh Peterson                                             */
+/* Description: A symbol table that many threads may use at once,    */
+/*              split into independently locked SymTable_T shards    */
+/*********************************************************************/
+
+/*********************************************************************/
+
+#ifndef SYMTABLESHARDED_INCLUDED
+#define SYMTABLESHARDED_INCLUDED
+
+#include <stddef.h>
+#include "symtable.h"
+
+/*
+ * A SymTableSharded_T object stores bindings in a number of SymTable_T
+ * shards, each with its own mutex. Each key belongs to the shard that
+ * the high bits of its hash select, so operations on keys of
+ * different shards run in parallel, and a shard that grows rehashes
+ * only its own bindings. All functions may be called from any number
+ * of threads at once, except SymTableSharded_free.
+ */
+typedef struct SymTableSharded *SymTableSharded_T;
+
+/*********************************************************************/
+
+/*
+ * Construct a new SymTableSharded_T of at least uShardCount shards
+ * (rounded up to a power of two). Return NULL if uShardCount is 0 or
+ * memory is insufficient.
+ */
+SymTableSharded_T SymTableSharded_new(size_t uShardCount);
+
+/*
+ * Frees all memory previously allocated for a SymTableSharded_T.
+ * No other thread may be using oSharded.
+ */
+void SymTableSharded_free(SymTableSharded_T oSharded);
+
+/*
+ * Returns the number of shards of oSharded.
+ */
+size_t SymTableSharded_getShardCount(SymTableSharded_T oSharded);
+
+/*
+ * Returns the number of bindings contained within oSharded: the sum
+ * over the shards, each counted under its lock, so a put or remove
+ * that runs at the same time may or may not be counted.
+ */
+size_t SymTableSharded_getLength(SymTableSharded_T oSharded);
+
+/*
+ * Tries to insert a binding of key pcKey to value pvValue into
+ * oSharded. Returns 1 if successful and 0 if pcKey is already present
+ * or memory is insufficient.
+ */
+int SymTableSharded_put(SymTableSharded_T oSharded,
+     const char *pcKey, const void *pvValue);
+
+/*
+ * If pcKey is present in oSharded, its value is changed to pvValue
+ * and the old value is returned. Otherwise, NULL is returned.
+ */
+void *SymTableSharded_replace(SymTableSharded_T oSharded,
+     const char *pcKey, const void *pvValue);
+
+/*
+ * Returns 1 if pcKey is present in oSharded and 0 otherwise.
+ */
+int SymTableSharded_contains(SymTableSharded_T oSharded,
+     const char *pcKey);
+
+/*
+ * If pcKey is present in oSharded, returns its associated value.
+ * Returns NULL otherwise.
+ */
+void *SymTableSharded_get(SymTableSharded_T oSharded,
+     const char *pcKey);
+
+/*
+ * If pcKey is present in oSharded, removes its binding and returns
+ * the associated value. Returns NULL otherwise.
+ */
+void *SymTableSharded_remove(SymTableSharded_T oSharded,
+     const char *pcKey);
+
+/*
+ * Applies (*pfApply) to all bindings in oSharded, passing pvExtra as
+ * a parameter, one shard at a time under that shard's lock. pfApply
+ * must not call the functions of oSharded.
+ */
+void SymTableSharded_map(SymTableSharded_T oSharded,
+     void (*pfApply)(const char *pcKey, void *pvValue, void *pvExtra),
+     const void *pvExtra);
+
+/*********************************************************************/
+
+#endif
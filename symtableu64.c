@@ -0,0 +1,391 @@
+/*********************************************************************/
+/* symtableu64.c                                                     */
+/* COS 217 Assignment 3: A Symbol Table ADT                          */
+/* Date: 10/31/2023                                                  */
+/* Author: Hugh Peterson                                             */
+/* Description: A symbol table module to associate integer keys with */
+/*              generic values (open addressing implementation)      */
+/*********************************************************************/
+
+/*********************************************************************/
+
+#include <assert.h>
+#include <stdlib.h>
+#include "symtableu64.h"
+#include "symtablemalloc.h"
+
+/*********************************************************************/
+
+enum {
+   /* number of slots of a new table; always a power of two */
+   INITIAL_CAPACITY = 16,
+
+   /* the table doubles before more than MAX_LOAD_NUMERATOR /
+      MAX_LOAD_DENOMINATOR of its slots would be in use */
+   MAX_LOAD_NUMERATOR = 2,
+   MAX_LOAD_DENOMINATOR = 3
+};
+
+/*********************************************************************/
+
+/*
+ * Stores a key-value pair inline in the slot array. A key of 0 marks
+ * an empty slot; the binding of key 0, if any, is kept in the table.
+ */
+struct Slot {
+   /* key, or 0 if the slot is empty */
+   unsigned long key;
+
+   /* value */
+   void *val;
+};
+
+/*
+ * Structure storing the slot array and the binding of key 0.
+ */
+struct SymTableU64 {
+   /* array of slots, searched by linear probing */
+   struct Slot *slots;
+
+   /* number of slots; a power of two */
+   size_t capacity;
+
+   /* number of bindings stored in the SymTableU64, including the
+      binding of key 0 */
+   size_t size;
+
+   /* 1 if key 0 is present and 0 otherwise */
+   int hasZeroKey;
+
+   /* value of key 0, if present */
+   void *zeroVal;
+};
+
+/*********************************************************************/
+
+/*
+ * Returns a well-mixed hash code for ulKey (the MurmurHash3
+ * finalizer), so that keys in arithmetic progressions spread over
+ * the whole table.
+ */
+static size_t SymTableU64_hash(unsigned long ulKey) {
+   size_t uHash = (size_t)ulKey;
+
+   uHash ^= uHash >> 33;
+   uHash *= (size_t)0xff51afd7ed558ccdUL;
+   uHash ^= uHash >> 33;
+   uHash *= (size_t)0xc4ceb9fe1a85ec53UL;
+   uHash ^= uHash >> 33;
+   return uHash;
+}
+
+/*
+ * Returns the slot of oSymTable holding the nonzero key ulKey, or
+ * NULL if it is absent.
+ */
+static struct Slot *SymTableU64_find(SymTableU64_T oSymTable,
+                                     unsigned long ulKey) {
+   size_t uMask;
+   size_t u;
+
+   assert(oSymTable != NULL);
+   assert(ulKey != 0);
+
+   uMask = oSymTable->capacity - 1;
+   for (u = SymTableU64_hash(ulKey) & uMask;
+        oSymTable->slots[u].key != 0; u = (u + 1) & uMask) {
+      if (oSymTable->slots[u].key == ulKey) {
+         return &oSymTable->slots[u];
+      }
+   }
+   return NULL;
+}
+
+/*
+ * Stores the binding of the nonzero key ulKey, known to be absent,
+ * in the first empty slot of its probe sequence in the array aSlots
+ * of uCapacity slots.
+ */
+static void SymTableU64_place(struct Slot *aSlots, size_t uCapacity,
+                              unsigned long ulKey, void *pvValue) {
+   size_t uMask = uCapacity - 1;
+   size_t u;
+
+   assert(aSlots != NULL);
+
+   for (u = SymTableU64_hash(ulKey) & uMask; aSlots[u].key != 0;
+        u = (u + 1) & uMask) {
+   }
+   aSlots[u].key = ulKey;
+   aSlots[u].val = pvValue;
+}
+
+/*
+ * Doubles the number of slots of oSymTable. Returns 1 if successful
+ * and 0 if memory is insufficient, leaving oSymTable unchanged.
+ */
+static int SymTableU64_grow(SymTableU64_T oSymTable) {
+   struct Slot *aNewSlots;
+   size_t uNewCapacity;
+   size_t u;
+
+   assert(oSymTable != NULL);
+
+   uNewCapacity = 2 * oSymTable->capacity;
+   aNewSlots =
+      (struct Slot *) calloc(uNewCapacity, sizeof(struct Slot));
+   if (aNewSlots == NULL) {
+      return 0;
+   }
+
+   for (u = 0; u < oSymTable->capacity; u++) {
+      if (oSymTable->slots[u].key != 0) {
+         SymTableU64_place(aNewSlots, uNewCapacity,
+                           oSymTable->slots[u].key,
+                           oSymTable->slots[u].val);
+      }
+   }
+
+   free(oSymTable->slots);
+   oSymTable->slots = aNewSlots;
+   oSymTable->capacity = uNewCapacity;
+   return 1;
+}
+
+/*********************************************************************/
+
+/*
+ * Construct a new SymTableU64_T. Return NULL if memory is
+ * insufficient.
+ */
+SymTableU64_T SymTableU64_new(void) {
+   SymTableU64_T oSymTable;
+
+   oSymTable = (SymTableU64_T) malloc(sizeof(struct SymTableU64));
+   if (oSymTable == NULL) {
+      return NULL;
+   }
+   oSymTable->slots =
+      (struct Slot *) calloc((size_t)INITIAL_CAPACITY,
+                             sizeof(struct Slot));
+   if (oSymTable->slots == NULL) {
+      free(oSymTable);
+      return NULL;
+   }
+
+   oSymTable->capacity = INITIAL_CAPACITY;
+   oSymTable->size = 0;
+   oSymTable->hasZeroKey = 0;
+   oSymTable->zeroVal = NULL;
+   return oSymTable;
+}
+
+/*
+ * Frees all memory previously allocated for a SymTableU64_T.
+ */
+void SymTableU64_free(SymTableU64_T oSymTable) {
+   assert(oSymTable != NULL);
+
+   free(oSymTable->slots);
+   free(oSymTable);
+}
+
+/*
+ * Returns the number of bindings contained within oSymTable.
+ */
+size_t SymTableU64_getLength(SymTableU64_T oSymTable) {
+   assert(oSymTable != NULL);
+
+   return oSymTable->size;
+}
+
+/*
+ * Tries to insert a binding of ulKey to pvValue into oSymTable.
+ * Returns 1 if successful and 0 if ulKey is already present or
+ * memory is insufficient.
+ */
+int SymTableU64_put(SymTableU64_T oSymTable,
+                    unsigned long ulKey, const void *pvValue) {
+   size_t uSlotsInUse;
+
+   assert(oSymTable != NULL);
+
+   if (ulKey == 0) {
+      if (oSymTable->hasZeroKey) {
+         return 0;
+      }
+      oSymTable->hasZeroKey = 1;
+      oSymTable->zeroVal = (void *) pvValue;
+      oSymTable->size++;
+      return 1;
+   }
+
+   if (SymTableU64_find(oSymTable, ulKey) != NULL) {
+      return 0;
+   }
+
+   uSlotsInUse = oSymTable->size - (size_t)oSymTable->hasZeroKey;
+   if ((uSlotsInUse + 1) * MAX_LOAD_DENOMINATOR
+       > oSymTable->capacity * MAX_LOAD_NUMERATOR) {
+      if (!SymTableU64_grow(oSymTable)) {
+         return 0;
+      }
+   }
+
+   SymTableU64_place(oSymTable->slots, oSymTable->capacity, ulKey,
+                     (void *) pvValue);
+   oSymTable->size++;
+   return 1;
+}
+
+/*
+ * If ulKey is present, its value is changed to pvValue and the old
+ * value is returned. Otherwise, NULL is returned.
+ */
+void *SymTableU64_replace(SymTableU64_T oSymTable,
+                          unsigned long ulKey, const void *pvValue) {
+   struct Slot *psSlot;
+   void *oldVal;
+
+   assert(oSymTable != NULL);
+
+   if (ulKey == 0) {
+      if (!oSymTable->hasZeroKey) {
+         return NULL;
+      }
+      oldVal = oSymTable->zeroVal;
+      oSymTable->zeroVal = (void *) pvValue;
+      return oldVal;
+   }
+
+   psSlot = SymTableU64_find(oSymTable, ulKey);
+   if (psSlot == NULL) {
+      return NULL;
+   }
+   oldVal = psSlot->val;
+   psSlot->val = (void *) pvValue;
+   return oldVal;
+}
+
+/*
+ * Returns 1 if ulKey is present and 0 otherwise.
+ */
+int SymTableU64_contains(SymTableU64_T oSymTable, unsigned long ulKey) {
+   assert(oSymTable != NULL);
+
+   if (ulKey == 0) {
+      return oSymTable->hasZeroKey;
+   }
+   return SymTableU64_find(oSymTable, ulKey) != NULL;
+}
+
+/*
+ * If ulKey is present, returns its associated value. Returns NULL
+ * otherwise.
+ */
+void *SymTableU64_get(SymTableU64_T oSymTable, unsigned long ulKey) {
+   struct Slot *psSlot;
+
+   assert(oSymTable != NULL);
+
+   if (ulKey == 0) {
+      return oSymTable->hasZeroKey ? oSymTable->zeroVal : NULL;
+   }
+   psSlot = SymTableU64_find(oSymTable, ulKey);
+   return (psSlot == NULL) ? NULL : psSlot->val;
+}
+
+/*
+ * If ulKey is present, removes its binding and returns the
+ * associated value. Returns NULL otherwise. Later bindings of the
+ * probe sequence are shifted back into the hole, so that no slot is
+ * ever marked deleted.
+ */
+void *SymTableU64_remove(SymTableU64_T oSymTable, unsigned long ulKey) {
+   struct Slot *psSlot;
+   void *removedValue;
+   size_t uMask;
+   size_t uHole;
+   size_t u;
+   size_t uHome;
+
+   assert(oSymTable != NULL);
+
+   if (ulKey == 0) {
+      if (!oSymTable->hasZeroKey) {
+         return NULL;
+      }
+      removedValue = oSymTable->zeroVal;
+      oSymTable->hasZeroKey = 0;
+      oSymTable->zeroVal = NULL;
+      oSymTable->size--;
+      return removedValue;
+   }
+
+   psSlot = SymTableU64_find(oSymTable, ulKey);
+   if (psSlot == NULL) {
+      return NULL;
+   }
+   removedValue = psSlot->val;
+
+   uMask = oSymTable->capacity - 1;
+   uHole = (size_t)(psSlot - oSymTable->slots);
+   for (u = (uHole + 1) & uMask; oSymTable->slots[u].key != 0;
+        u = (u + 1) & uMask) {
+      uHome = SymTableU64_hash(oSymTable->slots[u].key) & uMask;
+
+      /* a binding whose home lies cyclically in (hole, u] stays */
+      if ((uHole <= u) ? (uHole < uHome && uHome <= u)
+          : (uHole < uHome || uHome <= u)) {
+         continue;
+      }
+      oSymTable->slots[uHole] = oSymTable->slots[u];
+      uHole = u;
+   }
+   oSymTable->slots[uHole].key = 0;
+   oSymTable->slots[uHole].val = NULL;
+
+   oSymTable->size--;
+   return removedValue;
+}
+
+/*
+ * Applies (*pfApply) to all bindings in oSymTable, passing pvExtra
+ * as a parameter.
+ */
+void SymTableU64_map(SymTableU64_T oSymTable,
+     void (*pfApply)(unsigned long ulKey, void *pvValue, void *pvExtra),
+                     const void *pvExtra) {
+   size_t u;
+
+   assert(oSymTable != NULL);
+   assert(pfApply != NULL);
+
+   if (oSymTable->hasZeroKey) {
+      (*pfApply)(0, oSymTable->zeroVal, (void *) pvExtra);
+   }
+   for (u = 0; u < oSymTable->capacity; u++) {
+      if (oSymTable->slots[u].key != 0) {
+         (*pfApply)(oSymTable->slots[u].key, oSymTable->slots[u].val,
+                    (void *) pvExtra);
+      }
+   }
+}
+
+/*
+ * Fills in *psMemory with the memory that oSymTable holds.
+ */
+void SymTableU64_memoryUsage(SymTableU64_T oSymTable,
+                             struct SymTableMemory *psMemory) {
+   assert(oSymTable != NULL);
+   assert(psMemory != NULL);
+
+   psMemory->table = sizeof(struct SymTableU64);
+   psMemory->buckets = oSymTable->capacity * sizeof(struct Slot);
+   psMemory->nodes = 0;
+   psMemory->keys = 0;
+   psMemory->slack = SymTableMalloc_slack(psMemory->table)
+      + SymTableMalloc_slack(psMemory->buckets);
+   psMemory->total = psMemory->table + psMemory->buckets
+      + psMemory->slack;
+}
@@ -0,0 +1,97 @@
+/*********************************************************************/
+/* symtableu64.h                                                     */
+/* COS 217 Assignment 3: A Symbol Table ADT                          */
+/* Date: 10/31/2023                                                  */
+/* Author: Hugh Peterson                                             */
+/* Description: A symbol table module to associate integer keys with */
+/*              generic values                                       */
+/*********************************************************************/
+
+/*********************************************************************/
+
+#ifndef SYMTABLEU64_INCLUDED
+#define SYMTABLEU64_INCLUDED
+
+#include <stddef.h>
+#include "symtable.h"
+
+/*
+ * A SymTableU64_T object stores bindings whose keys are unsigned
+ * integers (64 bits wide where unsigned long is, as on the LP64
+ * platforms we run on). It has the operations of a SymTable_T, but
+ * keeps its keys inline instead of copying strings, so no key is
+ * ever hashed byte by byte or compared with strcmp.
+ */
+typedef struct SymTableU64 *SymTableU64_T;
+
+/*********************************************************************/
+
+/*
+ * Construct a new SymTableU64_T. Return NULL if memory is
+ * insufficient.
+ */
+SymTableU64_T SymTableU64_new(void);
+
+/*
+ * Frees all memory previously allocated for a SymTableU64_T.
+ * Takes a symbol table oSymTable.
+ */
+void SymTableU64_free(SymTableU64_T oSymTable);
+
+/*
+ * Returns the number of bindings contained within oSymTable.
+ */
+size_t SymTableU64_getLength(SymTableU64_T oSymTable);
+
+/*
+ * Tries to insert a binding of key ulKey to value pvValue into
+ * oSymTable. Returns 1 if successful and 0 if ulKey is already
+ * present or memory is insufficient.
+ */
+int SymTableU64_put(SymTableU64_T oSymTable,
+     unsigned long ulKey, const void *pvValue);
+
+/*
+ * If ulKey is present in oSymTable, its value is changed to pvValue
+ * and the old value is returned. Otherwise, NULL is returned.
+ */
+void *SymTableU64_replace(SymTableU64_T oSymTable,
+     unsigned long ulKey, const void *pvValue);
+
+/*
+ * Returns 1 if ulKey is present in oSymTable and 0 otherwise.
+ */
+int SymTableU64_contains(SymTableU64_T oSymTable, unsigned long ulKey);
+
+/*
+ * If ulKey is present in oSymTable, returns its associated value.
+ * Returns NULL otherwise.
+ */
+void *SymTableU64_get(SymTableU64_T oSymTable, unsigned long ulKey);
+
+/*
+ * If ulKey is present in oSymTable, removes its binding and returns
+ * the associated value. Returns NULL otherwise.
+ */
+void *SymTableU64_remove(SymTableU64_T oSymTable, unsigned long ulKey);
+
+/*
+ * Applies (*pfApply) to all bindings in oSymTable, passing pvExtra
+ * as a parameter. pfApply takes a key ulKey, a value pvValue, and an
+ * extra parameter pvExtra.
+ */
+void SymTableU64_map(SymTableU64_T oSymTable,
+     void (*pfApply)(unsigned long ulKey, void *pvValue, void *pvExtra),
+     const void *pvExtra);
+
+/*
+ * Fills in *psMemory with the memory that oSymTable holds, as
+ * SymTable_memoryUsage does. The slot array is reported as buckets;
+ * the keys take no memory of their own.
+ */
+void SymTableU64_memoryUsage(SymTableU64_T oSymTable,
+     struct SymTableMemory *psMemory);
+
+/*********************************************************************/
+
+#endif
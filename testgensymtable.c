@@ -0,0 +1,122 @@
+/*--------------------------------------------------------------------*/
+/* testgensymtable.c                                                  */
+/* Author: Hugh Peterson                                              */
+/* Tests a constant table written by gensymtable from keywords.txt.   */
+/*--------------------------------------------------------------------*/
+
+#include "keywords.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/*--------------------------------------------------------------------*/
+
+#define ASSURE(i) assure(i, __LINE__)
+
+/*--------------------------------------------------------------------*/
+
+/* If !iSuccessful, print a message to stdout indicating that the
+   test at line iLineNum failed. */
+
+static void assure(int iSuccessful, int iLineNum)
+{
+   if (! iSuccessful)
+   {
+      printf("Test at line %d failed.\n", iLineNum);
+      fflush(stdout);
+   }
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test that the generated table holds exactly the bindings listed in
+   the file psFile. */
+
+static void testListedBindings(FILE *psFile)
+{
+   enum {MAX_LINE_LENGTH = 256};
+
+   char acLine[MAX_LINE_LENGTH];
+   char acKey[MAX_LINE_LENGTH];
+   char acValue[MAX_LINE_LENGTH];
+   char *pcValue;
+   size_t uCount = 0;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing the bindings listed in the input file.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   while (fgets(acLine, MAX_LINE_LENGTH, psFile) != NULL)
+   {
+      if (sscanf(acLine, "%s %s", acKey, acValue) != 2
+          || acKey[0] == '#')
+         continue;
+      uCount++;
+
+      ASSURE(Keywords_contains(acKey));
+      pcValue = (char*)Keywords_get(acKey);
+      ASSURE((pcValue != NULL) && (strcmp(pcValue, acValue) == 0));
+
+      /* Near misses must not be found. */
+      ASSURE(! Keywords_contains(acValue));
+      strcat(acKey, "x");
+      ASSURE(! Keywords_contains(acKey));
+      ASSURE(Keywords_get(acKey) == NULL);
+      acKey[strlen(acKey) - 2] = '\0';
+      ASSURE(! Keywords_contains(acKey));
+   }
+
+   ASSURE(Keywords_getLength() == uCount);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test lookups of keys that are not in the table. */
+
+static void testAbsentKeys(void)
+{
+   printf("------------------------------------------------------\n");
+   printf("Testing keys that are not in the table.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   ASSURE(! Keywords_contains(""));
+   ASSURE(Keywords_get("") == NULL);
+   ASSURE(! Keywords_contains("inline"));
+   ASSURE(! Keywords_contains("Jeter"));
+   ASSURE(Keywords_get("main") == NULL);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test the generated table. argv[1] is the file that the table was
+   generated from. Exit with EXIT_FAILURE if argv[1] is missing or
+   cannot be opened. Otherwise return 0. */
+
+int main(int argc, char *argv[])
+{
+   FILE *psFile;
+
+   if (argc != 2)
+   {
+      fprintf(stderr, "Usage: %s bindingsfile\n", argv[0]);
+      exit(EXIT_FAILURE);
+   }
+
+   psFile = fopen(argv[1], "r");
+   if (psFile == NULL)
+   {
+      fprintf(stderr, "%s: cannot open %s\n", argv[0], argv[1]);
+      exit(EXIT_FAILURE);
+   }
+
+   testListedBindings(psFile);
+   testAbsentKeys();
+   fclose(psFile);
+
+   printf("------------------------------------------------------\n");
+   printf("End of %s.\n", argv[0]);
+   return 0;
+}
@@ -619,6 +619,16 @@ static void testLongKey(void)
    iFound = SymTable_contains(oSymTable, acKeyB);
    ASSURE(iFound);
 
+   /* Keys that differ only in their last character, or only in
+      length, are different keys. */
+   acKeyA[KEY_SIZE - 2] = 'b';
+   iFound = SymTable_contains(oSymTable, acKeyA);
+   ASSURE(! iFound);
+   acKeyA[KEY_SIZE - 2] = '\0';
+   iFound = SymTable_contains(oSymTable, acKeyA);
+   ASSURE(! iFound);
+   acKeyA[KEY_SIZE - 2] = 'a';
+
    pcValue = (char*)SymTable_get(oSymTable, acKeyA);
    ASSURE(pcValue == acShortstop);
    pcValue = (char*)SymTable_get(oSymTable, acKeyB);
@@ -697,6 +707,191 @@ static void testTableOfTables(void)
 
 /*--------------------------------------------------------------------*/
 
+/* Test the SymTable_memoryUsage() function. */
+
+static void testMemoryUsage(void)
+{
+   SymTable_T oSymTable;
+   struct SymTableMemory sEmpty;
+   struct SymTableMemory sMemory;
+   char acShortstop[] = "Shortstop";
+   int iSuccessful;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing the SymTable_memoryUsage() function.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   oSymTable = SymTable_new();
+   ASSURE(oSymTable != NULL);
+
+   SymTable_memoryUsage(oSymTable, &sEmpty);
+   ASSURE(sEmpty.table > 0);
+   ASSURE(sEmpty.nodes == 0);
+   ASSURE(sEmpty.keys == 0);
+   ASSURE(sEmpty.total == sEmpty.table + sEmpty.buckets
+          + sEmpty.slack);
+
+   iSuccessful = SymTable_put(oSymTable, "Jeter", acShortstop);
+   ASSURE(iSuccessful);
+   iSuccessful = SymTable_put(oSymTable, "", acShortstop);
+   ASSURE(iSuccessful);
+
+   /* "Jeter" and "" take 6 and 1 bytes. */
+   SymTable_memoryUsage(oSymTable, &sMemory);
+   ASSURE(sMemory.keys == 7);
+   ASSURE(sMemory.nodes > 0);
+   ASSURE(sMemory.slack > sEmpty.slack);
+   ASSURE(sMemory.total == sMemory.table + sMemory.buckets
+          + sMemory.nodes + sMemory.keys + sMemory.slack);
+
+   SymTable_remove(oSymTable, "Jeter");
+   SymTable_remove(oSymTable, "");
+   SymTable_memoryUsage(oSymTable, &sMemory);
+   ASSURE(sMemory.total == sEmpty.total);
+
+   SymTable_free(oSymTable);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* The state of the allocator of testAllocator(). */
+
+struct Pool
+{
+   /* The number of bytes handed out and not yet released. */
+   size_t uBytesInUse;
+
+   /* The number of calls of poolAlloc(). */
+   size_t uAllocations;
+};
+
+/* Allocate uSize bytes with malloc, and count them in the Pool that
+   pvContext points to. */
+
+static void *poolAlloc(void *pvContext, size_t uSize)
+{
+   struct Pool *psPool = (struct Pool*)pvContext;
+
+   assert(psPool != NULL);
+
+   psPool->uBytesInUse += uSize;
+   psPool->uAllocations++;
+   return malloc(uSize);
+}
+
+/* Free pvMemory, an allocation of uSize bytes, and stop counting it
+   in the Pool that pvContext points to. */
+
+static void poolFree(void *pvContext, void *pvMemory, size_t uSize)
+{
+   struct Pool *psPool = (struct Pool*)pvContext;
+
+   assert(psPool != NULL);
+
+   psPool->uBytesInUse -= uSize;
+   free(pvMemory);
+}
+
+/* Allocate uSize bytes from the region that pvContext points to,
+   which starts with the number of bytes used so far. Return NULL
+   when the region is full. */
+
+static void *regionAlloc(void *pvContext, size_t uSize)
+{
+   enum {REGION_SIZE = 100000};
+   enum {ALIGNMENT = 16};
+
+   size_t *puUsed = (size_t*)pvContext;
+   char *pcMemory;
+
+   assert(puUsed != NULL);
+
+   uSize = (uSize + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+   if (*puUsed + uSize > REGION_SIZE - ALIGNMENT)
+      return NULL;
+   pcMemory = (char*)puUsed + ALIGNMENT + *puUsed;
+   *puUsed += uSize;
+   return pcMemory;
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test the SymTable_newWithAllocator() function. */
+
+static void testAllocator(void)
+{
+   enum {REGION_SIZE = 100000};
+
+   SymTable_T oSymTable;
+   struct SymTableAllocator sAllocator;
+   struct Pool sPool = {0, 0};
+   char acShortstop[] = "Shortstop";
+   char acCenterField[] = "Center Field";
+   char acKey[16];
+   size_t *puRegion;
+   int iSuccessful;
+   int i;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing the SymTable_newWithAllocator() function.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   /* Every byte the table gets must be given back. */
+   sAllocator.pfAlloc = poolAlloc;
+   sAllocator.pfFree = poolFree;
+   sAllocator.pfSlack = NULL;
+   oSymTable = SymTable_newWithAllocator(&sAllocator, &sPool);
+   ASSURE(oSymTable != NULL);
+   iSuccessful = SymTable_put(oSymTable, "Jeter", acShortstop);
+   ASSURE(iSuccessful);
+   iSuccessful = SymTable_put(oSymTable, "Mantle", acCenterField);
+   ASSURE(iSuccessful);
+   ASSURE(SymTable_get(oSymTable, "Jeter") == acShortstop);
+   /* At least the table, its array, and the two key copies. */
+   ASSURE(sPool.uAllocations >= 4);
+   ASSURE(SymTable_remove(oSymTable, "Mantle") == acCenterField);
+   for (i = 0; i < 1000; i++)
+   {
+      sprintf(acKey, "%d", i);
+      iSuccessful = SymTable_put(oSymTable, acKey, acShortstop);
+      ASSURE(iSuccessful);
+   }
+   SymTable_free(oSymTable);
+   ASSURE(sPool.uBytesInUse == 0);
+
+   /* A table in a region is discarded with the region. */
+   puRegion = (size_t*)malloc(REGION_SIZE);
+   ASSURE(puRegion != NULL);
+   *puRegion = 0;
+   sAllocator.pfAlloc = regionAlloc;
+   sAllocator.pfFree = NULL;
+   sAllocator.pfSlack = NULL;
+   oSymTable = SymTable_newWithAllocator(&sAllocator, puRegion);
+   ASSURE(oSymTable != NULL);
+   iSuccessful = SymTable_put(oSymTable, "Jeter", acShortstop);
+   ASSURE(iSuccessful);
+   ASSURE(SymTable_get(oSymTable, "Jeter") == acShortstop);
+   ASSURE(SymTable_remove(oSymTable, "Jeter") == acShortstop);
+   ASSURE(SymTable_getLength(oSymTable) == 0);
+
+   /* A full region makes puts fail without corrupting the table. */
+   for (i = 0; i < 10000; i++)
+   {
+      sprintf(acKey, "%d", i);
+      if (! SymTable_put(oSymTable, acKey, acShortstop))
+         break;
+   }
+   ASSURE(i < 10000);
+   ASSURE(SymTable_getLength(oSymTable) == (size_t)i);
+   ASSURE(! SymTable_contains(oSymTable, acKey));
+   SymTable_free(oSymTable);
+   free(puRegion);
+}
+
+/*--------------------------------------------------------------------*/
+
 /* Test the ability of a SymTable object to handle collisions.  This
    test assumes that a SymTable object is implemented as a hash table,
    that there are 509 buckets in the hash table, and that the
@@ -960,6 +1155,8 @@ int main(int argc, char *argv[])
    testNullValue();
    testLongKey();
    testTableOfTables();
+   testMemoryUsage();
+   testAllocator();
    testCollisions();
    testLargeTable(iBindingCount);
 
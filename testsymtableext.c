@@ -0,0 +1,1266 @@
+/*--------------------------------------------------------------------*/
+/* testsymtableext.c                                                  */
+/* Author: Hugh Peterson                                              */
+/* Tests for the modules built on top of the SymTable ADT.            */
+/*--------------------------------------------------------------------*/
+
+#include "symtable.h"
+#include "symtablehash.h"
+#include "symtablefrozen.h"
+#include "symtablelatency.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/*--------------------------------------------------------------------*/
+
+#define ASSURE(i) assure(i, __LINE__)
+
+/*--------------------------------------------------------------------*/
+
+/* If !iSuccessful, print a message to stdout indicating that the
+   test at line iLineNum failed. */
+
+static void assure(int iSuccessful, int iLineNum)
+{
+   if (! iSuccessful)
+   {
+      printf("Test at line %d failed.\n", iLineNum);
+      fflush(stdout);
+   }
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Count the binding whose key is pcKey in the size_t that pvExtra
+   points to, checking that pvValue is the binding's key. */
+
+static void countBinding(const char *pcKey, void *pvValue,
+   void *pvExtra)
+{
+   assert(pcKey != NULL);
+   assert(pvExtra != NULL);
+
+   ASSURE((pvValue != NULL) && (strcmp(pcKey, (char*)pvValue) == 0));
+   (*(size_t*)pvExtra)++;
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test the SymTable_freeze() function on a small table and on an
+   empty table. */
+
+static void testFreeze(void)
+{
+   SymTable_T oSymTable;
+   SymTableFrozen_T oFrozen;
+   char acJeter[] = "Jeter";
+   char acMantle[] = "Mantle";
+   char acGehrig[] = "Gehrig";
+   char acShortstop[] = "Shortstop";
+   char acCenterField[] = "Center Field";
+   char *pcValue;
+   int iSuccessful;
+   int iFound;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing the SymTable_freeze() function.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   oSymTable = SymTable_new();
+   ASSURE(oSymTable != NULL);
+
+   oFrozen = SymTable_freeze(oSymTable);
+   ASSURE(oFrozen != NULL);
+   ASSURE(SymTableFrozen_getLength(oFrozen) == 0);
+   iFound = SymTableFrozen_contains(oFrozen, acJeter);
+   ASSURE(! iFound);
+   pcValue = (char*)SymTableFrozen_get(oFrozen, acJeter);
+   ASSURE(pcValue == NULL);
+   SymTableFrozen_free(oFrozen);
+
+   iSuccessful = SymTable_put(oSymTable, acJeter, acShortstop);
+   ASSURE(iSuccessful);
+   iSuccessful = SymTable_put(oSymTable, acMantle, acCenterField);
+   ASSURE(iSuccessful);
+   iSuccessful = SymTable_put(oSymTable, acGehrig, NULL);
+   ASSURE(iSuccessful);
+   iSuccessful = SymTable_put(oSymTable, "", acCenterField);
+   ASSURE(iSuccessful);
+
+   oFrozen = SymTable_freeze(oSymTable);
+   ASSURE(oFrozen != NULL);
+
+   /* The frozen table must not depend on the original. */
+   SymTable_free(oSymTable);
+
+   ASSURE(SymTableFrozen_getLength(oFrozen) == 4);
+
+   pcValue = (char*)SymTableFrozen_get(oFrozen, "Jeter");
+   ASSURE(pcValue == acShortstop);
+   pcValue = (char*)SymTableFrozen_get(oFrozen, "Mantle");
+   ASSURE(pcValue == acCenterField);
+   pcValue = (char*)SymTableFrozen_get(oFrozen, "");
+   ASSURE(pcValue == acCenterField);
+   iFound = SymTableFrozen_contains(oFrozen, "Gehrig");
+   ASSURE(iFound);
+   pcValue = (char*)SymTableFrozen_get(oFrozen, "Gehrig");
+   ASSURE(pcValue == NULL);
+
+   iFound = SymTableFrozen_contains(oFrozen, "Ruth");
+   ASSURE(! iFound);
+   pcValue = (char*)SymTableFrozen_get(oFrozen, "Jete");
+   ASSURE(pcValue == NULL);
+
+   SymTableFrozen_free(oFrozen);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test a frozen table built from iBindingCount bindings. */
+
+static void testFreezeLarge(int iBindingCount)
+{
+   enum {MAX_KEY_LENGTH = 16};
+
+   SymTable_T oSymTable;
+   SymTableFrozen_T oFrozen;
+   char acKey[MAX_KEY_LENGTH];
+   char *pcValue;
+   int i;
+   int iSuccessful;
+   size_t uCount = 0;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing a potentially large frozen SymTable object.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   oSymTable = SymTable_new();
+   ASSURE(oSymTable != NULL);
+   for (i = 0; i < iBindingCount; i++)
+   {
+      sprintf(acKey, "%d", i);
+      pcValue = (char*)malloc(sizeof(char) * (strlen(acKey) + 1));
+      ASSURE(pcValue != NULL);
+      strcpy(pcValue, acKey);
+      iSuccessful = SymTable_put(oSymTable, acKey, pcValue);
+      ASSURE(iSuccessful);
+   }
+
+   oFrozen = SymTable_freeze(oSymTable);
+   ASSURE(oFrozen != NULL);
+   ASSURE(SymTableFrozen_getLength(oFrozen) == (size_t)iBindingCount);
+
+   for (i = 0; i < iBindingCount; i++)
+   {
+      sprintf(acKey, "%d", i);
+      pcValue = (char*)SymTableFrozen_get(oFrozen, acKey);
+      ASSURE((pcValue != NULL) && (strcmp(pcValue, acKey) == 0));
+      sprintf(acKey, "%d", -i - 1);
+      ASSURE(! SymTableFrozen_contains(oFrozen, acKey));
+   }
+
+   SymTableFrozen_map(oFrozen, countBinding, &uCount);
+   ASSURE(uCount == (size_t)iBindingCount);
+
+   SymTableFrozen_free(oFrozen);
+
+   for (i = 0; i < iBindingCount; i++)
+   {
+      sprintf(acKey, "%d", i);
+      free(SymTable_remove(oSymTable, acKey));
+   }
+   SymTable_free(oSymTable);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test the SymTable_getStats() function. This test assumes the hash
+   function and the bucket counts of symtablehash.c. */
+
+static void testStats(void)
+{
+   enum {MAX_KEY_LENGTH = 16};
+
+   SymTable_T oSymTable;
+   struct SymTableStats sStats;
+   struct SymTableStats sBefore;
+   char acKey[MAX_KEY_LENGTH];
+   char acPitcher[] = "pitcher";
+   int iSuccessful;
+   int i;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing the SymTable_getStats() function.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   oSymTable = SymTable_new();
+   ASSURE(oSymTable != NULL);
+
+   SymTable_getStats(oSymTable, &sStats);
+   ASSURE(sStats.bucketCount == 509);
+   ASSURE(sStats.loadFactor == 0.0);
+   ASSURE(sStats.chainHistogram[0] == 509);
+   ASSURE(sStats.longestChain == 0);
+
+   /* "250", "469", "947", "1303", and "2016" share bucket 123. */
+   iSuccessful = SymTable_put(oSymTable, "250", acPitcher);
+   ASSURE(iSuccessful);
+   iSuccessful = SymTable_put(oSymTable, "469", acPitcher);
+   ASSURE(iSuccessful);
+   iSuccessful = SymTable_put(oSymTable, "947", acPitcher);
+   ASSURE(iSuccessful);
+   iSuccessful = SymTable_put(oSymTable, "1303", acPitcher);
+   ASSURE(iSuccessful);
+   iSuccessful = SymTable_put(oSymTable, "2016", acPitcher);
+   ASSURE(iSuccessful);
+   iSuccessful = SymTable_put(oSymTable, "Jeter", acPitcher);
+   ASSURE(iSuccessful);
+
+   SymTable_getStats(oSymTable, &sBefore);
+   ASSURE(sBefore.longestChain == 5);
+   ASSURE(sBefore.chainHistogram[5] == 1);
+   ASSURE(sBefore.chainHistogram[1] == 1);
+   ASSURE(sBefore.chainHistogram[0] == 507);
+   ASSURE(sBefore.loadFactor == 6.0 / 509.0);
+
+   /* The last key of the chain takes one probe and five compares. */
+   ASSURE(SymTable_get(oSymTable, "2016") == acPitcher);
+   SymTable_getStats(oSymTable, &sStats);
+   if (sStats.countersEnabled)
+   {
+      ASSURE(sStats.probes == sBefore.probes + 1);
+      ASSURE(sStats.compares == sBefore.compares + 5);
+      ASSURE(sStats.expansions == 0);
+   }
+   else
+   {
+      ASSURE(sStats.probes == 0);
+      ASSURE(sStats.compares == 0);
+   }
+
+   /* Grow the table once. */
+   for (i = 0; i < 600; i++)
+   {
+      sprintf(acKey, "key%d", i);
+      iSuccessful = SymTable_put(oSymTable, acKey, acPitcher);
+      ASSURE(iSuccessful);
+   }
+   SymTable_getStats(oSymTable, &sStats);
+   ASSURE(sStats.bucketCount == 1021);
+   if (sStats.countersEnabled)
+   {
+      ASSURE(sStats.expansions == 1);
+      ASSURE(sStats.expansionSeconds >= 0.0);
+   }
+
+   SymTable_free(oSymTable);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test the latency histograms. They are only filled in when the
+   library is compiled with -DSYMTABLE_LATENCY. */
+
+static void testLatency(void)
+{
+   SymTable_T oSymTable;
+   struct SymTableLatencyHistogram sHistogram;
+   char acShortstop[] = "Shortstop";
+   size_t uCount = 0;
+   size_t uBucketTotal = 0;
+   int iSuccessful;
+   int i;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing the SymTable_getLatencyHistogram() function.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   SymTable_resetLatencyHistograms();
+
+   oSymTable = SymTable_new();
+   ASSURE(oSymTable != NULL);
+   iSuccessful = SymTable_put(oSymTable, "Jeter", acShortstop);
+   ASSURE(iSuccessful);
+   iSuccessful = SymTable_put(oSymTable, "Mantle", acShortstop);
+   ASSURE(iSuccessful);
+   iSuccessful = SymTable_put(oSymTable, "Jeter", acShortstop);
+   ASSURE(! iSuccessful);
+   ASSURE(SymTable_get(oSymTable, "Jeter") == acShortstop);
+   ASSURE(SymTable_get(oSymTable, "Ruth") == NULL);
+   ASSURE(SymTable_remove(oSymTable, "Mantle") == acShortstop);
+   ASSURE(SymTable_remove(oSymTable, "Jeter") == acShortstop);
+   SymTable_map(oSymTable, countBinding, &uCount);
+   ASSURE(uCount == 0);
+
+   SymTable_getLatencyHistogram(SYMTABLE_OP_PUT, &sHistogram);
+   if (sHistogram.enabled)
+   {
+      ASSURE(sHistogram.count == 3);
+      for (i = 0; i < SYMTABLE_LATENCY_BUCKETS; i++)
+         uBucketTotal += sHistogram.buckets[i];
+      ASSURE(uBucketTotal == 3);
+      ASSURE(sHistogram.maxNs <= sHistogram.totalNs);
+      ASSURE(SymTable_latencyPercentile(&sHistogram, 100.0)
+             >= sHistogram.maxNs);
+
+      SymTable_getLatencyHistogram(SYMTABLE_OP_GET, &sHistogram);
+      ASSURE(sHistogram.count == 2);
+      SymTable_getLatencyHistogram(SYMTABLE_OP_REMOVE, &sHistogram);
+      ASSURE(sHistogram.count == 2);
+      SymTable_getLatencyHistogram(SYMTABLE_OP_MAP, &sHistogram);
+      ASSURE(sHistogram.count == 1);
+   }
+   else
+   {
+      ASSURE(sHistogram.count == 0);
+      ASSURE(SymTable_latencyPercentile(&sHistogram, 99.0) == 0.0);
+   }
+
+   SymTable_resetLatencyHistograms();
+   SymTable_getLatencyHistogram(SYMTABLE_OP_GET, &sHistogram);
+   ASSURE(sHistogram.count == 0);
+
+   SymTable_free(oSymTable);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test the filter of SymTable_enableFilter() on a potentially large
+   table of iBindingCount bindings, removing every other binding so
+   that the filter is rebuilt. */
+
+static void testFilter(int iBindingCount)
+{
+   enum {MAX_KEY_LENGTH = 16};
+
+   SymTable_T oSymTable;
+   struct SymTableStats sStats;
+   char acKey[MAX_KEY_LENGTH];
+   char acShortstop[] = "Shortstop";
+   int iSuccessful;
+   int i;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing the SymTable_enableFilter() function.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   oSymTable = SymTable_new();
+   ASSURE(oSymTable != NULL);
+
+   /* A filter can be enabled on a table that holds bindings. */
+   iSuccessful = SymTable_put(oSymTable, "Jeter", acShortstop);
+   ASSURE(iSuccessful);
+   iSuccessful = SymTable_enableFilter(oSymTable);
+   ASSURE(iSuccessful);
+   iSuccessful = SymTable_enableFilter(oSymTable);
+   ASSURE(iSuccessful);
+   ASSURE(SymTable_contains(oSymTable, "Jeter"));
+   ASSURE(! SymTable_contains(oSymTable, "Mantle"));
+
+   SymTable_getStats(oSymTable, &sStats);
+   ASSURE(sStats.filterEnabled);
+   ASSURE(sStats.filterBytes > 0);
+
+   for (i = 0; i < iBindingCount; i++)
+   {
+      sprintf(acKey, "%d", i);
+      iSuccessful = SymTable_put(oSymTable, acKey, acShortstop);
+      ASSURE(iSuccessful);
+   }
+   for (i = 0; i < iBindingCount; i += 2)
+   {
+      sprintf(acKey, "%d", i);
+      ASSURE(SymTable_remove(oSymTable, acKey) == acShortstop);
+   }
+
+   /* No false negatives, through growth and rebuilds. */
+   for (i = 0; i < iBindingCount; i++)
+   {
+      sprintf(acKey, "%d", i);
+      if (i % 2 == 0)
+         ASSURE(SymTable_get(oSymTable, acKey) == NULL);
+      else
+         ASSURE(SymTable_get(oSymTable, acKey) == acShortstop);
+      sprintf(acKey, "%d", -i - 1);
+      ASSURE(! SymTable_contains(oSymTable, acKey));
+      ASSURE(SymTable_remove(oSymTable, acKey) == NULL);
+   }
+
+   SymTable_getStats(oSymTable, &sStats);
+   if (iBindingCount >= 100)
+      ASSURE(sStats.filterRejects > sStats.filterFalsePositives);
+
+   SymTable_disableFilter(oSymTable);
+   SymTable_getStats(oSymTable, &sStats);
+   ASSURE(! sStats.filterEnabled);
+   ASSURE(sStats.filterBytes == 0);
+   ASSURE(SymTable_contains(oSymTable, "Jeter"));
+
+   SymTable_free(oSymTable);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Allocate uSize bytes with malloc, counting the allocations in the
+   size_t that pvContext points to. */
+
+static void *countingAlloc(void *pvContext, size_t uSize)
+{
+   assert(pvContext != NULL);
+
+   (*(size_t*)pvContext)++;
+   return malloc(uSize);
+}
+
+/* Allocate uSize bytes with malloc, unless the size_t that pvContext
+   points to, the number of allocations left, is 0. */
+
+static void *limitedAlloc(void *pvContext, size_t uSize)
+{
+   assert(pvContext != NULL);
+
+   if (*(size_t*)pvContext == 0)
+      return NULL;
+   (*(size_t*)pvContext)--;
+   return malloc(uSize);
+}
+
+/* Free pvMemory, an allocation of uSize bytes. */
+
+static void countingFree(void *pvContext, void *pvMemory, size_t uSize)
+{
+   (void)pvContext;
+   (void)uSize;
+   free(pvMemory);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test the SymTable_merge() function, merging a table of
+   iBindingCount bindings into an empty one. */
+
+static void testMerge(int iBindingCount)
+{
+   enum {MAX_KEY_LENGTH = 16};
+
+   SymTable_T oDst;
+   SymTable_T oSrc;
+   SymTableHandle_T oHandle;
+   struct SymTableStats sStats;
+   struct SymTableAllocator sAllocator;
+   char acKey[MAX_KEY_LENGTH];
+   char acDst[] = "dst";
+   char acSrc[] = "src";
+   size_t uAllocations = 0;
+   size_t uAllocationsBefore;
+   int iSuccessful;
+   int i;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing the SymTable_merge() function.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   sAllocator.pfAlloc = countingAlloc;
+   sAllocator.pfFree = countingFree;
+   sAllocator.pfSlack = NULL;
+
+   /* The destination keeps its binding of "b". */
+   oDst = SymTable_newWithAllocator(&sAllocator, &uAllocations);
+   ASSURE(oDst != NULL);
+   oSrc = SymTable_newWithAllocator(&sAllocator, &uAllocations);
+   ASSURE(oSrc != NULL);
+   iSuccessful = SymTable_put(oDst, "a", acDst);
+   ASSURE(iSuccessful);
+   oHandle = SymTable_putHandle(oDst, "b", acDst);
+   ASSURE(oHandle != NULL);
+   iSuccessful = SymTable_put(oSrc, "b", acSrc);
+   ASSURE(iSuccessful);
+   iSuccessful = SymTable_put(oSrc, "c", acSrc);
+   ASSURE(iSuccessful);
+   iSuccessful = SymTable_enableFilter(oDst);
+   ASSURE(iSuccessful);
+
+   /* Nodes move between tables of one allocator. */
+   uAllocationsBefore = uAllocations;
+   ASSURE(SymTable_merge(oDst, oSrc, SYMTABLE_MERGE_KEEP_DST) == 1);
+   ASSURE(uAllocations == uAllocationsBefore);
+   ASSURE(SymTable_getLength(oDst) == 3);
+   ASSURE(SymTable_get(oDst, "b") == acDst);
+   ASSURE(SymTable_get(oDst, "c") == acSrc);
+   ASSURE(SymTable_getLength(oSrc) == 1);
+   ASSURE(SymTable_get(oSrc, "b") == acSrc);
+   ASSURE(! SymTable_contains(oSrc, "c"));
+
+   /* Now the source's binding of "b" wins, and the destination's
+      moves to the source, along with the handle to it. */
+   ASSURE(SymTable_merge(oDst, oSrc, SYMTABLE_MERGE_TAKE_SRC) == 1);
+   ASSURE(SymTable_getLength(oDst) == 3);
+   ASSURE(SymTable_get(oDst, "b") == acSrc);
+   ASSURE(SymTable_getLength(oSrc) == 1);
+   ASSURE(SymTable_get(oSrc, "b") == acDst);
+   ASSURE(SymTable_handleGet(oHandle) == acDst);
+   ASSURE(SymTable_handleSet(oSrc, oHandle, acSrc) == acDst);
+   ASSURE(SymTable_get(oSrc, "b") == acSrc);
+   ASSURE(SymTable_get(oDst, "b") == acSrc);
+   SymTable_handleSet(oSrc, oHandle, acDst);
+   SymTable_free(oSrc);
+
+   /* A table of malloc cannot give its nodes to oDst, so they are
+      copied. */
+   oSrc = SymTable_new();
+   ASSURE(oSrc != NULL);
+   iSuccessful = SymTable_put(oSrc, "b", acDst);
+   ASSURE(iSuccessful);
+   iSuccessful = SymTable_put(oSrc, "d", acSrc);
+   ASSURE(iSuccessful);
+   ASSURE(SymTable_merge(oDst, oSrc, SYMTABLE_MERGE_TAKE_SRC) == 2);
+   ASSURE(SymTable_get(oDst, "b") == acDst);
+   ASSURE(SymTable_get(oDst, "d") == acSrc);
+   ASSURE(SymTable_getLength(oSrc) == 1);
+   ASSURE(SymTable_get(oSrc, "b") == acSrc);
+   SymTable_free(oSrc);
+   SymTable_free(oDst);
+
+   /* A large merge grows the destination once. */
+   oDst = SymTable_new();
+   ASSURE(oDst != NULL);
+   oSrc = SymTable_new();
+   ASSURE(oSrc != NULL);
+   iSuccessful = SymTable_enableFilter(oSrc);
+   ASSURE(iSuccessful);
+   for (i = 0; i < iBindingCount; i++)
+   {
+      sprintf(acKey, "%d", i);
+      iSuccessful = SymTable_put(oSrc, acKey, acSrc);
+      ASSURE(iSuccessful);
+   }
+   ASSURE(SymTable_merge(oDst, oSrc, SYMTABLE_MERGE_KEEP_DST)
+          == (size_t)iBindingCount);
+   ASSURE(SymTable_getLength(oDst) == (size_t)iBindingCount);
+   ASSURE(SymTable_getLength(oSrc) == 0);
+   SymTable_getStats(oDst, &sStats);
+   ASSURE(sStats.bucketCount >= (size_t)iBindingCount
+          || sStats.bucketCount == 65521);
+   if (sStats.countersEnabled && iBindingCount > 509)
+      ASSURE(sStats.expansions == 1);
+   for (i = 0; i < iBindingCount; i++)
+   {
+      sprintf(acKey, "%d", i);
+      ASSURE(SymTable_get(oDst, acKey) == acSrc);
+      ASSURE(! SymTable_contains(oSrc, acKey));
+   }
+   SymTable_free(oSrc);
+   SymTable_free(oDst);
+
+   /* So does one that copies the bindings. */
+   oDst = SymTable_newWithAllocator(&sAllocator, &uAllocations);
+   ASSURE(oDst != NULL);
+   oSrc = SymTable_new();
+   ASSURE(oSrc != NULL);
+   for (i = 0; i < iBindingCount; i++)
+   {
+      sprintf(acKey, "%d", i);
+      iSuccessful = SymTable_put(oSrc, acKey, acSrc);
+      ASSURE(iSuccessful);
+   }
+   ASSURE(SymTable_merge(oDst, oSrc, SYMTABLE_MERGE_KEEP_DST)
+          == (size_t)iBindingCount);
+   ASSURE(SymTable_getLength(oDst) == (size_t)iBindingCount);
+   ASSURE(SymTable_getLength(oSrc) == 0);
+   SymTable_getStats(oDst, &sStats);
+   if (sStats.countersEnabled && iBindingCount > 509)
+      ASSURE(sStats.expansions == 1);
+   SymTable_free(oSrc);
+   SymTable_free(oDst);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test the SymTable_enterScope() and SymTable_exitScope() functions,
+   shadowing a potentially large table of iBindingCount bindings. */
+
+static void testScopes(int iBindingCount)
+{
+   enum {MAX_KEY_LENGTH = 16};
+
+   SymTable_T oSymTable;
+   char acKey[MAX_KEY_LENGTH];
+   char acShortstop[] = "Shortstop";
+   char acCenterField[] = "Center Field";
+   char acRightField[] = "Right Field";
+   int iSuccessful;
+   int i;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing the SymTable_enterScope() function.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   oSymTable = SymTable_new();
+   ASSURE(oSymTable != NULL);
+   ASSURE(! SymTable_exitScope(oSymTable));
+
+   iSuccessful = SymTable_put(oSymTable, "Jeter", acShortstop);
+   ASSURE(iSuccessful);
+   iSuccessful = SymTable_put(oSymTable, "Mantle", acCenterField);
+   ASSURE(iSuccessful);
+
+   /* An inner scope shadows, declares, and hides. */
+   SymTable_enterScope(oSymTable);
+   ASSURE(SymTable_getScopeDepth(oSymTable) == 1);
+   iSuccessful = SymTable_put(oSymTable, "Jeter", acRightField);
+   ASSURE(iSuccessful);
+   iSuccessful = SymTable_put(oSymTable, "Jeter", acCenterField);
+   ASSURE(! iSuccessful);
+   iSuccessful = SymTable_put(oSymTable, "Ruth", acRightField);
+   ASSURE(iSuccessful);
+   ASSURE(SymTable_get(oSymTable, "Jeter") == acRightField);
+   ASSURE(SymTable_getLength(oSymTable) == 3);
+
+   SymTable_enterScope(oSymTable);
+   ASSURE(SymTable_remove(oSymTable, "Ruth") == acRightField);
+   ASSURE(! SymTable_contains(oSymTable, "Ruth"));
+   iSuccessful = SymTable_put(oSymTable, "Ruth", acShortstop);
+   ASSURE(iSuccessful);
+   ASSURE(SymTable_remove(oSymTable, "Jeter") == acRightField);
+   ASSURE(SymTable_replace(oSymTable, "Mantle", acShortstop)
+          == acCenterField);
+   ASSURE(SymTable_getLength(oSymTable) == 2);
+
+   /* Exiting brings back what the scopes shadowed and hid. */
+   ASSURE(SymTable_exitScope(oSymTable));
+   ASSURE(SymTable_get(oSymTable, "Ruth") == acRightField);
+   ASSURE(SymTable_get(oSymTable, "Jeter") == acRightField);
+   ASSURE(SymTable_get(oSymTable, "Mantle") == acShortstop);
+   ASSURE(SymTable_exitScope(oSymTable));
+   ASSURE(SymTable_getScopeDepth(oSymTable) == 0);
+   ASSURE(SymTable_get(oSymTable, "Jeter") == acShortstop);
+   ASSURE(! SymTable_contains(oSymTable, "Ruth"));
+   ASSURE(SymTable_getLength(oSymTable) == 2);
+
+   /* A large scope, exited with lookups still correct. */
+   for (i = 0; i < iBindingCount; i++)
+   {
+      sprintf(acKey, "%d", i);
+      iSuccessful = SymTable_put(oSymTable, acKey, acShortstop);
+      ASSURE(iSuccessful);
+   }
+   SymTable_enterScope(oSymTable);
+   for (i = 0; i < iBindingCount; i++)
+   {
+      sprintf(acKey, "%d", i);
+      iSuccessful = SymTable_put(oSymTable, acKey, acCenterField);
+      ASSURE(iSuccessful);
+      sprintf(acKey, "%d", -i - 1);
+      iSuccessful = SymTable_put(oSymTable, acKey, acCenterField);
+      ASSURE(iSuccessful);
+   }
+   ASSURE(SymTable_getLength(oSymTable)
+          == 2 * (size_t)iBindingCount + 2);
+   ASSURE(SymTable_exitScope(oSymTable));
+   ASSURE(SymTable_getLength(oSymTable) == (size_t)iBindingCount + 2);
+   for (i = 0; i < iBindingCount; i++)
+   {
+      sprintf(acKey, "%d", i);
+      ASSURE(SymTable_get(oSymTable, acKey) == acShortstop);
+      sprintf(acKey, "%d", -i - 1);
+      ASSURE(! SymTable_contains(oSymTable, acKey));
+   }
+
+   /* Freeing a table with scopes open frees what they hid. */
+   SymTable_enterScope(oSymTable);
+   iSuccessful = SymTable_put(oSymTable, "Ruth", acRightField);
+   ASSURE(iSuccessful);
+   SymTable_enterScope(oSymTable);
+   ASSURE(SymTable_remove(oSymTable, "Ruth") == acRightField);
+   SymTable_free(oSymTable);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test the SymTable_begin(), SymTable_rollback(), and
+   SymTable_commit() functions on a potentially large table of
+   iBindingCount bindings. */
+
+static void testTransactions(int iBindingCount)
+{
+   enum {MAX_KEY_LENGTH = 16};
+
+   SymTable_T oSymTable;
+   char acKey[MAX_KEY_LENGTH];
+   char acShortstop[] = "Shortstop";
+   char acCenterField[] = "Center Field";
+   char acRightField[] = "Right Field";
+   int iSuccessful;
+   int i;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing the SymTable_begin() function.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   oSymTable = SymTable_new();
+   ASSURE(oSymTable != NULL);
+   ASSURE(! SymTable_rollback(oSymTable));
+   ASSURE(! SymTable_commit(oSymTable));
+
+   iSuccessful = SymTable_put(oSymTable, "Jeter", acShortstop);
+   ASSURE(iSuccessful);
+   iSuccessful = SymTable_put(oSymTable, "Mantle", acCenterField);
+   ASSURE(iSuccessful);
+
+   /* A rollback undoes puts, replaces, and removes. */
+   iSuccessful = SymTable_begin(oSymTable);
+   ASSURE(iSuccessful);
+   iSuccessful = SymTable_put(oSymTable, "Ruth", acRightField);
+   ASSURE(iSuccessful);
+   ASSURE(SymTable_replace(oSymTable, "Jeter", acRightField)
+          == acShortstop);
+   ASSURE(SymTable_replace(oSymTable, "Jeter", acCenterField)
+          == acRightField);
+   ASSURE(SymTable_remove(oSymTable, "Mantle") == acCenterField);
+   ASSURE(SymTable_remove(oSymTable, "Ruth") == acRightField);
+   iSuccessful = SymTable_put(oSymTable, "Mantle", acShortstop);
+   ASSURE(iSuccessful);
+   ASSURE(SymTable_getLength(oSymTable) == 2);
+   ASSURE(SymTable_rollback(oSymTable));
+   ASSURE(SymTable_getLength(oSymTable) == 2);
+   ASSURE(SymTable_get(oSymTable, "Jeter") == acShortstop);
+   ASSURE(SymTable_get(oSymTable, "Mantle") == acCenterField);
+   ASSURE(! SymTable_contains(oSymTable, "Ruth"));
+
+   /* A committed inner transaction is undone by the outer one. */
+   iSuccessful = SymTable_begin(oSymTable);
+   ASSURE(iSuccessful);
+   ASSURE(SymTable_remove(oSymTable, "Jeter") == acShortstop);
+   iSuccessful = SymTable_begin(oSymTable);
+   ASSURE(iSuccessful);
+   iSuccessful = SymTable_put(oSymTable, "Ruth", acRightField);
+   ASSURE(iSuccessful);
+   ASSURE(SymTable_commit(oSymTable));
+   ASSURE(SymTable_contains(oSymTable, "Ruth"));
+   ASSURE(SymTable_rollback(oSymTable));
+   ASSURE(! SymTable_contains(oSymTable, "Ruth"));
+   ASSURE(SymTable_get(oSymTable, "Jeter") == acShortstop);
+
+   /* A committed transaction keeps its changes. */
+   iSuccessful = SymTable_begin(oSymTable);
+   ASSURE(iSuccessful);
+   ASSURE(SymTable_remove(oSymTable, "Jeter") == acShortstop);
+   for (i = 0; i < iBindingCount; i++)
+   {
+      sprintf(acKey, "%d", i);
+      iSuccessful = SymTable_put(oSymTable, acKey, acShortstop);
+      ASSURE(iSuccessful);
+   }
+   ASSURE(SymTable_commit(oSymTable));
+   ASSURE(SymTable_getLength(oSymTable) == (size_t)iBindingCount + 1);
+   ASSURE(! SymTable_contains(oSymTable, "Jeter"));
+
+   /* A large rollback, across growth of the bucket array. */
+   iSuccessful = SymTable_begin(oSymTable);
+   ASSURE(iSuccessful);
+   for (i = 0; i < iBindingCount; i++)
+   {
+      sprintf(acKey, "%d", i);
+      if (i % 2 == 0)
+         ASSURE(SymTable_remove(oSymTable, acKey) == acShortstop);
+      else
+         ASSURE(SymTable_replace(oSymTable, acKey, acCenterField)
+                == acShortstop);
+      sprintf(acKey, "%d", -i - 1);
+      iSuccessful = SymTable_put(oSymTable, acKey, acRightField);
+      ASSURE(iSuccessful);
+   }
+   ASSURE(SymTable_rollback(oSymTable));
+   ASSURE(SymTable_getLength(oSymTable) == (size_t)iBindingCount + 1);
+   for (i = 0; i < iBindingCount; i++)
+   {
+      sprintf(acKey, "%d", i);
+      ASSURE(SymTable_get(oSymTable, acKey) == acShortstop);
+      sprintf(acKey, "%d", -i - 1);
+      ASSURE(! SymTable_contains(oSymTable, acKey));
+   }
+
+   /* Freeing a table with a transaction open frees what it removed. */
+   iSuccessful = SymTable_begin(oSymTable);
+   ASSURE(iSuccessful);
+   ASSURE(SymTable_remove(oSymTable, "Mantle") == acCenterField);
+   SymTable_free(oSymTable);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test SymTable_prepareKey() and the _h functions, reusing each
+   SymTableKey while the table grows from iBindingCount bindings. */
+
+static void testKeyHandles(int iBindingCount)
+{
+   enum {MAX_KEY_LENGTH = 16};
+
+   SymTable_T oSymTable;
+   SymTable_T oSymTable2;
+   struct SymTableKey sJeter;
+   struct SymTableKey sKey;
+   char acKey[MAX_KEY_LENGTH];
+   char acShortstop[] = "Shortstop";
+   char acCenterField[] = "Center Field";
+   int iSuccessful;
+   int i;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing the SymTable_prepareKey() function.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   oSymTable = SymTable_new();
+   ASSURE(oSymTable != NULL);
+   oSymTable2 = SymTable_new();
+   ASSURE(oSymTable2 != NULL);
+
+   sJeter = SymTable_prepareKey("Jeter");
+   ASSURE(sJeter.length == 5);
+   ASSURE(! SymTable_contains_h(oSymTable, &sJeter));
+   ASSURE(SymTable_get_h(oSymTable, &sJeter) == NULL);
+   ASSURE(SymTable_replace_h(oSymTable, &sJeter, acShortstop) == NULL);
+   ASSURE(SymTable_remove_h(oSymTable, &sJeter) == NULL);
+
+   iSuccessful = SymTable_put_h(oSymTable, &sJeter, acShortstop);
+   ASSURE(iSuccessful);
+   iSuccessful = SymTable_put_h(oSymTable, &sJeter, acShortstop);
+   ASSURE(! iSuccessful);
+   ASSURE(SymTable_contains(oSymTable, "Jeter"));
+
+   /* The handle stays good while the bucket array grows. */
+   for (i = 0; i < iBindingCount; i++)
+   {
+      sprintf(acKey, "%d", i);
+      sKey = SymTable_prepareKey(acKey);
+      iSuccessful = SymTable_put_h(oSymTable, &sKey, acCenterField);
+      ASSURE(iSuccessful);
+      ASSURE(SymTable_get_h(oSymTable, &sKey) == acCenterField);
+   }
+   ASSURE(SymTable_contains_h(oSymTable, &sJeter));
+   ASSURE(SymTable_replace_h(oSymTable, &sJeter, acCenterField)
+          == acShortstop);
+   ASSURE(SymTable_get_h(oSymTable, &sJeter) == acCenterField);
+
+   /* The same handle may be used with a table of another size. */
+   ASSURE(! SymTable_contains_h(oSymTable2, &sJeter));
+   iSuccessful = SymTable_put_h(oSymTable2, &sJeter, acShortstop);
+   ASSURE(iSuccessful);
+   ASSURE(SymTable_get(oSymTable2, "Jeter") == acShortstop);
+   ASSURE(SymTable_get_h(oSymTable, &sJeter) == acCenterField);
+
+   ASSURE(SymTable_remove_h(oSymTable, &sJeter) == acCenterField);
+   ASSURE(! SymTable_contains(oSymTable, "Jeter"));
+   ASSURE(SymTable_getLength(oSymTable) == (size_t)iBindingCount);
+   for (i = 0; i < iBindingCount; i++)
+   {
+      sprintf(acKey, "%d", i);
+      sKey = SymTable_prepareKey(acKey);
+      ASSURE(SymTable_remove_h(oSymTable, &sKey) == acCenterField);
+   }
+   ASSURE(SymTable_getLength(oSymTable) == 0);
+
+   SymTable_free(oSymTable);
+   SymTable_free(oSymTable2);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test SymTable_putHandle(), SymTable_handleGet(), and
+   SymTable_handleSet(), keeping iBindingCount handles while the
+   table grows. */
+
+static void testHandles(int iBindingCount)
+{
+   enum {MAX_KEY_LENGTH = 16};
+
+   SymTable_T oSymTable;
+   SymTableHandle_T *poHandles;
+   SymTableHandle_T oJeter;
+   char acKey[MAX_KEY_LENGTH];
+   char acShortstop[] = "Shortstop";
+   char acCenterField[] = "Center Field";
+   int i;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing the SymTable_putHandle() function.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   oSymTable = SymTable_new();
+   ASSURE(oSymTable != NULL);
+   poHandles = (SymTableHandle_T*)
+      malloc(((size_t)iBindingCount + 1) * sizeof(SymTableHandle_T));
+   ASSURE(poHandles != NULL);
+
+   oJeter = SymTable_putHandle(oSymTable, "Jeter", acShortstop);
+   ASSURE(oJeter != NULL);
+   ASSURE(SymTable_putHandle(oSymTable, "Jeter", acShortstop)
+          == NULL);
+   ASSURE(SymTable_handleGet(oJeter) == acShortstop);
+
+   for (i = 0; i < iBindingCount; i++)
+   {
+      sprintf(acKey, "%d", i);
+      poHandles[i] = SymTable_putHandle(oSymTable, acKey, acShortstop);
+      ASSURE(poHandles[i] != NULL);
+   }
+
+   /* The handles survive the growth of the bucket array. */
+   ASSURE(SymTable_handleSet(oSymTable, oJeter, acCenterField)
+          == acShortstop);
+   ASSURE(SymTable_get(oSymTable, "Jeter") == acCenterField);
+   for (i = 0; i < iBindingCount; i++)
+   {
+      ASSURE(SymTable_handleGet(poHandles[i]) == acShortstop);
+      if (i % 2 == 0)
+         ASSURE(SymTable_handleSet(oSymTable, poHandles[i],
+                                   acCenterField) == acShortstop);
+   }
+   for (i = 0; i < iBindingCount; i++)
+   {
+      sprintf(acKey, "%d", i);
+      ASSURE(SymTable_get(oSymTable, acKey)
+             == ((i % 2 == 0) ? acCenterField : acShortstop));
+   }
+
+   /* A rollback undoes a change made through a handle. */
+   ASSURE(SymTable_begin(oSymTable));
+   ASSURE(SymTable_handleSet(oSymTable, oJeter, acShortstop)
+          == acCenterField);
+   ASSURE(SymTable_get(oSymTable, "Jeter") == acShortstop);
+   ASSURE(SymTable_rollback(oSymTable));
+   ASSURE(SymTable_handleGet(oJeter) == acCenterField);
+
+   free(poHandles);
+   SymTable_free(oSymTable);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Count the bindings that a table evicts: pvExtra is the count. */
+
+static void countEviction(const char *pcKey, void *pvValue,
+   void *pvExtra)
+{
+   ASSURE(pcKey != NULL);
+   ASSURE(pvValue != NULL);
+   (*(size_t*)pvExtra)++;
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test SymTable_setCapacity() and SymTable_setEvictHandler(), putting
+   iBindingCount bindings into a table with a smaller capacity. */
+
+static void testCapacity(int iBindingCount)
+{
+   enum {MAX_KEY_LENGTH = 16};
+   enum {CAPACITY = 10};
+
+   SymTable_T oSymTable;
+   SymTable_T oSymTable2;
+   struct SymTableAllocator sAllocator;
+   char acKey[MAX_KEY_LENGTH];
+   char acShortstop[] = "Shortstop";
+   char acCenterField[] = "Center Field";
+   size_t uEvicted = 0;
+   size_t uAllocationsLeft = (size_t)-1;
+   int iSuccessful;
+   int i;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing the SymTable_setCapacity() function.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   oSymTable = SymTable_new();
+   ASSURE(oSymTable != NULL);
+   SymTable_setEvictHandler(oSymTable, countEviction, &uEvicted);
+   SymTable_setCapacity(oSymTable, CAPACITY);
+
+   /* A binding used before each put is never evicted. */
+   iSuccessful = SymTable_put(oSymTable, "Jeter", acShortstop);
+   ASSURE(iSuccessful);
+   for (i = 0; i < iBindingCount; i++)
+   {
+      ASSURE(SymTable_get(oSymTable, "Jeter") == acShortstop);
+      sprintf(acKey, "%d", i);
+      iSuccessful = SymTable_put(oSymTable, acKey, acCenterField);
+      ASSURE(iSuccessful);
+      ASSURE(SymTable_getLength(oSymTable) <= CAPACITY);
+   }
+   ASSURE(SymTable_contains(oSymTable, "Jeter"));
+   ASSURE(SymTable_getLength(oSymTable) + uEvicted
+          == (size_t)iBindingCount + 1);
+
+   /* Lowering the capacity evicts at once; 0 lifts the limit. */
+   SymTable_setCapacity(oSymTable, 1);
+   ASSURE(SymTable_getLength(oSymTable) == 1);
+   ASSURE(uEvicted == (size_t)iBindingCount);
+   SymTable_setCapacity(oSymTable, 0);
+   for (i = 0; i < iBindingCount; i++)
+   {
+      sprintf(acKey, "%d", i);
+      SymTable_put(oSymTable, acKey, acCenterField);
+   }
+   ASSURE(uEvicted == (size_t)iBindingCount);
+
+   /* A merge does not leave the destination over its capacity. */
+   oSymTable2 = SymTable_new();
+   ASSURE(oSymTable2 != NULL);
+   SymTable_setEvictHandler(oSymTable2, countEviction, &uEvicted);
+   SymTable_setCapacity(oSymTable2, CAPACITY);
+   SymTable_merge(oSymTable2, oSymTable, SYMTABLE_MERGE_KEEP_DST);
+   ASSURE(SymTable_getLength(oSymTable2)
+          == ((iBindingCount < CAPACITY) ? (size_t)iBindingCount + 1
+              : CAPACITY));
+   ASSURE(SymTable_getLength(oSymTable) == 0);
+
+   SymTable_free(oSymTable);
+   SymTable_free(oSymTable2);
+
+   /* A put that runs out of memory evicts nothing. */
+   sAllocator.pfAlloc = limitedAlloc;
+   sAllocator.pfFree = countingFree;
+   sAllocator.pfSlack = NULL;
+   oSymTable = SymTable_newWithAllocator(&sAllocator,
+                                         &uAllocationsLeft);
+   ASSURE(oSymTable != NULL);
+   SymTable_setEvictHandler(oSymTable, countEviction, &uEvicted);
+   SymTable_setCapacity(oSymTable, CAPACITY);
+   for (i = 0; i < CAPACITY; i++)
+   {
+      sprintf(acKey, "%d", i);
+      iSuccessful = SymTable_put(oSymTable, acKey, acCenterField);
+      ASSURE(iSuccessful);
+   }
+   uEvicted = 0;
+   for (i = 0; i < 2; i++)
+   {
+      /* The binding or else the key cannot be allocated. */
+      uAllocationsLeft = (size_t)i;
+      iSuccessful = SymTable_put(oSymTable, "Jeter", acShortstop);
+      ASSURE(! iSuccessful);
+      ASSURE(SymTable_getLength(oSymTable) == CAPACITY);
+      ASSURE(uEvicted == 0);
+   }
+   uAllocationsLeft = (size_t)-1;
+   iSuccessful = SymTable_put(oSymTable, "Jeter", acShortstop);
+   ASSURE(iSuccessful);
+   ASSURE(uEvicted == 1);
+
+   SymTable_free(oSymTable);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Return the time that pvContext points to, as a clock for a
+   SymTable_T. */
+
+static unsigned long fakeClock(void *pvContext)
+{
+   return *(unsigned long*)pvContext;
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test SymTable_putWithTTL() and SymTable_expire() on iBindingCount
+   bindings, with a clock that the test sets. */
+
+static void testTTL(int iBindingCount)
+{
+   enum {MAX_KEY_LENGTH = 16};
+
+   SymTable_T oSymTable;
+   struct SymTableMemory sEmpty;
+   struct SymTableMemory sMemory;
+   char acKey[MAX_KEY_LENGTH];
+   char acShortstop[] = "Shortstop";
+   char acCenterField[] = "Center Field";
+   unsigned long ulNow = 1000;
+   size_t uEvicted = 0;
+   size_t uExpired;
+   int iSuccessful;
+   int i;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing the SymTable_putWithTTL() function.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   oSymTable = SymTable_new();
+   ASSURE(oSymTable != NULL);
+   SymTable_setClock(oSymTable, fakeClock, &ulNow);
+   SymTable_setEvictHandler(oSymTable, countEviction, &uEvicted);
+   SymTable_memoryUsage(oSymTable, &sEmpty);
+   ASSURE(SymTable_expire(oSymTable, 100) == 0);
+
+   /* A lookup of an expired binding finds it absent and frees it. */
+   iSuccessful = SymTable_putWithTTL(oSymTable, "Jeter", acShortstop,
+                                     10);
+   ASSURE(iSuccessful);
+   iSuccessful = SymTable_putWithTTL(oSymTable, "Jeter", acShortstop,
+                                     10);
+   ASSURE(! iSuccessful);
+   iSuccessful = SymTable_put(oSymTable, "Mantle", acCenterField);
+   ASSURE(iSuccessful);
+   ulNow += 9;
+   ASSURE(SymTable_get(oSymTable, "Jeter") == acShortstop);
+   ulNow++;
+   ASSURE(SymTable_get(oSymTable, "Jeter") == NULL);
+   ASSURE(uEvicted == 1);
+   ASSURE(SymTable_getLength(oSymTable) == 1);
+   iSuccessful = SymTable_putWithTTL(oSymTable, "Jeter", acShortstop,
+                                     10);
+   ASSURE(iSuccessful);
+   ASSURE(SymTable_remove(oSymTable, "Jeter") == acShortstop);
+   ASSURE(uEvicted == 1);
+
+   /* The sweeper frees them in bounded steps, beyond one turn of
+      the wheel too. */
+   for (i = 0; i < iBindingCount; i++)
+   {
+      sprintf(acKey, "%d", i);
+      iSuccessful = SymTable_putWithTTL(oSymTable, acKey,
+                                        acCenterField,
+                                        (unsigned long)(i % 1000));
+      ASSURE(iSuccessful);
+   }
+   ulNow += 499;
+   uExpired = 0;
+   for (i = 0; i < iBindingCount / 16 + 64; i++)
+      uExpired += SymTable_expire(oSymTable, 32);
+   ASSURE(uExpired == (size_t)iBindingCount / 1000 * 500
+          + ((iBindingCount % 1000 < 500)
+             ? (size_t)(iBindingCount % 1000) : 500));
+   ASSURE(SymTable_getLength(oSymTable)
+          == (size_t)iBindingCount - uExpired + 1);
+   ulNow += 5000;
+   while (SymTable_getLength(oSymTable) > 1)
+      SymTable_expire(oSymTable, 1);
+   ASSURE(SymTable_get(oSymTable, "Mantle") == acCenterField);
+   ASSURE(uEvicted == (size_t)iBindingCount + 1);
+   ASSURE(SymTable_remove(oSymTable, "Mantle") == acCenterField);
+   SymTable_memoryUsage(oSymTable, &sMemory);
+   ASSURE(sMemory.nodes == sEmpty.nodes);
+
+   /* Freeing a table frees the bindings that have yet to expire. */
+   iSuccessful = SymTable_putWithTTL(oSymTable, "Ruth", acShortstop,
+                                     100000);
+   ASSURE(iSuccessful);
+   SymTable_free(oSymTable);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test that the keys of a table stay reachable while it grows, when
+   its bindings are split between the old and new bucket arrays, by
+   checking after each of iBindingCount puts and removes. */
+
+static void testIncrementalRehash(int iBindingCount)
+{
+   enum {MAX_KEY_LENGTH = 16};
+
+   SymTable_T oSymTable;
+   char acKey[MAX_KEY_LENGTH];
+   char acShortstop[] = "Shortstop";
+   int iSuccessful;
+   int i;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing the SymTable_put() function while growing.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   oSymTable = SymTable_new();
+   ASSURE(oSymTable != NULL);
+
+   for (i = 0; i < iBindingCount; i++)
+   {
+      sprintf(acKey, "%d", i);
+      iSuccessful = SymTable_put(oSymTable, acKey, acShortstop);
+      ASSURE(iSuccessful);
+      sprintf(acKey, "%d", -i - 1);
+      iSuccessful = SymTable_put(oSymTable, acKey, acShortstop);
+      ASSURE(iSuccessful);
+      sprintf(acKey, "%d", i / 2);
+      ASSURE(SymTable_get(oSymTable, acKey) == acShortstop);
+      if (i % 2 == 1)
+      {
+         sprintf(acKey, "%d", -(i / 2) - 1);
+         ASSURE(SymTable_remove(oSymTable, acKey) == acShortstop);
+         ASSURE(! SymTable_contains(oSymTable, acKey));
+      }
+      ASSURE(SymTable_getLength(oSymTable)
+             == (size_t)(2 * (i + 1) - (i + 1) / 2));
+   }
+   for (i = 0; i < iBindingCount; i++)
+   {
+      sprintf(acKey, "%d", i);
+      ASSURE(SymTable_contains(oSymTable, acKey));
+      sprintf(acKey, "%d", -i - 1);
+      ASSURE(SymTable_contains(oSymTable, acKey)
+             == (i + 1 > iBindingCount / 2));
+   }
+
+   SymTable_free(oSymTable);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test the modules built on top of the SymTable ADT. Write the output
+   of the tests to stdout. argv[1] is the number of bindings to put
+   into potentially large tables. Exit with EXIT_FAILURE if argv[1] is
+   missing or not numeric. Otherwise return 0. */
+
+int main(int argc, char *argv[])
+{
+   int iBindingCount;
+
+   if (argc != 2)
+   {
+      fprintf(stderr, "Usage: %s bindingcount\n", argv[0]);
+      exit(EXIT_FAILURE);
+   }
+
+   if (sscanf(argv[1], "%d", &iBindingCount) != 1)
+   {
+      fprintf(stderr, "bindingcount must be numeric\n");
+      exit(EXIT_FAILURE);
+   }
+   if (iBindingCount < 0)
+   {
+      fprintf(stderr, "bindingcount cannot be negative\n");
+      exit(EXIT_FAILURE);
+   }
+
+   testFreeze();
+   testFreezeLarge(iBindingCount);
+   testStats();
+   testLatency();
+   testFilter(iBindingCount);
+   testMerge(iBindingCount);
+   testScopes(iBindingCount);
+   testTransactions(iBindingCount);
+   testKeyHandles(iBindingCount);
+   testHandles(iBindingCount);
+   testCapacity(iBindingCount);
+   testTTL(iBindingCount);
+   testIncrementalRehash(iBindingCount);
+
+   printf("------------------------------------------------------\n");
+   printf("End of %s.\n", argv[0]);
+   return 0;
+}
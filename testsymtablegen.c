@@ -0,0 +1,271 @@
+/*--------------------------------------------------------------------*/
+/* testsymtablegen.c                                                  */
+/* Author: Hugh Peterson                                              */
+/* Tests for the tables generated by the macros of symtablegen.h.     */
+/*--------------------------------------------------------------------*/
+
+#include "symtablegen.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/*--------------------------------------------------------------------*/
+
+#define ASSURE(i) assure(i, __LINE__)
+
+/*--------------------------------------------------------------------*/
+
+/* A value larger than a pointer. */
+
+struct Position
+{
+   char acName[16];
+   int iNumber;
+};
+
+SYMTABLE_DECLARE(IntTable, int);
+SYMTABLE_DEFINE(IntTable, int);
+
+SYMTABLE_DECLARE(PositionTable, struct Position);
+SYMTABLE_DEFINE(PositionTable, struct Position);
+
+/*--------------------------------------------------------------------*/
+
+/* If !iSuccessful, print a message to stdout indicating that the
+   test at line iLineNum failed. */
+
+static void assure(int iSuccessful, int iLineNum)
+{
+   if (! iSuccessful)
+   {
+      printf("Test at line %d failed.\n", iLineNum);
+      fflush(stdout);
+   }
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Multiply the int that piValue points to by the int that pvExtra
+   points to. */
+
+static void scale(const char *pcKey, int *piValue, void *pvExtra)
+{
+   assert(pcKey != NULL);
+   assert(piValue != NULL);
+   assert(pvExtra != NULL);
+
+   *piValue *= *(int*)pvExtra;
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Add the int that piValue points to to the long that pvExtra points
+   to. */
+
+static void sum(const char *pcKey, int *piValue, void *pvExtra)
+{
+   assert(pcKey != NULL);
+   assert(piValue != NULL);
+   assert(pvExtra != NULL);
+
+   *(long*)pvExtra += *piValue;
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test a table of ints, as the DEBUG main of symtablehash.c uses
+   them. */
+
+static void testIntTable(void)
+{
+   IntTable_T oTable;
+   int *piValue;
+   int iValue = 0;
+   int iFactor = 3;
+   int iSuccessful;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing a generated table of ints.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   oTable = IntTable_new();
+   ASSURE(oTable != NULL);
+   ASSURE(IntTable_getLength(oTable) == 0);
+   ASSURE(IntTable_get(oTable, "a") == NULL);
+
+   iSuccessful = IntTable_put(oTable, "a", 1);
+   ASSURE(iSuccessful);
+   iSuccessful = IntTable_put(oTable, "b", 2);
+   ASSURE(iSuccessful);
+   iSuccessful = IntTable_put(oTable, "", 0);
+   ASSURE(iSuccessful);
+   iSuccessful = IntTable_put(oTable, "a", 5);
+   ASSURE(! iSuccessful);
+   ASSURE(IntTable_getLength(oTable) == 3);
+
+   piValue = IntTable_get(oTable, "a");
+   ASSURE((piValue != NULL) && (*piValue == 1));
+   ASSURE(IntTable_contains(oTable, ""));
+   ASSURE(! IntTable_contains(oTable, "c"));
+
+   /* Values can be changed in place. */
+   *piValue = 69;
+   piValue = IntTable_get(oTable, "a");
+   ASSURE((piValue != NULL) && (*piValue == 69));
+
+   IntTable_map(oTable, scale, &iFactor);
+   piValue = IntTable_get(oTable, "b");
+   ASSURE((piValue != NULL) && (*piValue == 6));
+
+   iSuccessful = IntTable_remove(oTable, "a", &iValue);
+   ASSURE(iSuccessful);
+   ASSURE(iValue == 207);
+   iSuccessful = IntTable_remove(oTable, "a", &iValue);
+   ASSURE(! iSuccessful);
+   iSuccessful = IntTable_remove(oTable, "b", NULL);
+   ASSURE(iSuccessful);
+   ASSURE(IntTable_getLength(oTable) == 1);
+
+   IntTable_free(oTable);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test a table whose values are structures. */
+
+static void testStructTable(void)
+{
+   PositionTable_T oTable;
+   struct Position sPosition;
+   struct Position *psPosition;
+   int iSuccessful;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing a generated table of structures.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   oTable = PositionTable_new();
+   ASSURE(oTable != NULL);
+
+   strcpy(sPosition.acName, "Shortstop");
+   sPosition.iNumber = 6;
+   iSuccessful = PositionTable_put(oTable, "Jeter", sPosition);
+   ASSURE(iSuccessful);
+   strcpy(sPosition.acName, "Center Field");
+   sPosition.iNumber = 8;
+   iSuccessful = PositionTable_put(oTable, "Mantle", sPosition);
+   ASSURE(iSuccessful);
+
+   /* The table holds copies. */
+   strcpy(sPosition.acName, "Catcher");
+   psPosition = PositionTable_get(oTable, "Jeter");
+   ASSURE(psPosition != NULL);
+   ASSURE(strcmp(psPosition->acName, "Shortstop") == 0);
+   ASSURE(psPosition->iNumber == 6);
+
+   iSuccessful = PositionTable_remove(oTable, "Mantle", &sPosition);
+   ASSURE(iSuccessful);
+   ASSURE(strcmp(sPosition.acName, "Center Field") == 0);
+   ASSURE(PositionTable_getLength(oTable) == 1);
+
+   PositionTable_free(oTable);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test a potentially large generated table of iBindingCount
+   bindings, removing every third binding. */
+
+static void testLargeTable(int iBindingCount)
+{
+   enum {MAX_KEY_LENGTH = 16};
+
+   IntTable_T oTable;
+   char acKey[MAX_KEY_LENGTH];
+   int *piValue;
+   long lSum = 0;
+   long lExpected = 0;
+   int iSuccessful;
+   int i;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing a potentially large generated table.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   oTable = IntTable_new();
+   ASSURE(oTable != NULL);
+
+   for (i = 0; i < iBindingCount; i++)
+   {
+      sprintf(acKey, "%d", i);
+      iSuccessful = IntTable_put(oTable, acKey, i);
+      ASSURE(iSuccessful);
+   }
+   ASSURE(IntTable_getLength(oTable) == (size_t)iBindingCount);
+
+   for (i = 0; i < iBindingCount; i += 3)
+   {
+      sprintf(acKey, "%d", i);
+      iSuccessful = IntTable_remove(oTable, acKey, NULL);
+      ASSURE(iSuccessful);
+   }
+
+   for (i = 0; i < iBindingCount; i++)
+   {
+      sprintf(acKey, "%d", i);
+      piValue = IntTable_get(oTable, acKey);
+      if (i % 3 == 0)
+         ASSURE(piValue == NULL);
+      else
+      {
+         ASSURE((piValue != NULL) && (*piValue == i));
+         lExpected += i;
+      }
+   }
+
+   IntTable_map(oTable, sum, &lSum);
+   ASSURE(lSum == lExpected);
+
+   IntTable_free(oTable);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test the tables generated by symtablegen.h. Write the output of
+   the tests to stdout. argv[1] is the number of bindings to put into
+   a potentially large table. Exit with EXIT_FAILURE if argv[1] is
+   missing or not numeric. Otherwise return 0. */
+
+int main(int argc, char *argv[])
+{
+   int iBindingCount;
+
+   if (argc != 2)
+   {
+      fprintf(stderr, "Usage: %s bindingcount\n", argv[0]);
+      exit(EXIT_FAILURE);
+   }
+
+   if (sscanf(argv[1], "%d", &iBindingCount) != 1)
+   {
+      fprintf(stderr, "bindingcount must be numeric\n");
+      exit(EXIT_FAILURE);
+   }
+   if (iBindingCount < 0)
+   {
+      fprintf(stderr, "bindingcount cannot be negative\n");
+      exit(EXIT_FAILURE);
+   }
+
+   testIntTable();
+   testStructTable();
+   testLargeTable(iBindingCount);
+
+   printf("------------------------------------------------------\n");
+   printf("End of %s.\n", argv[0]);
+   return 0;
+}
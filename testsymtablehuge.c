@@ -0,0 +1,194 @@
+/*--------------------------------------------------------------------*/
+/* testsymtablehuge.c                                                 */
+/* Author: Hugh Peterson                                              */
+/* Tests for the huge page allocator of the symbol table module.      */
+/*--------------------------------------------------------------------*/
+
+#include "symtablehuge.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/*--------------------------------------------------------------------*/
+
+#define ASSURE(i) assure(i, __LINE__)
+
+/*--------------------------------------------------------------------*/
+
+enum {MAX_KEY_LENGTH = 32};
+
+/*--------------------------------------------------------------------*/
+
+/* If !iSuccessful, print a message to stdout indicating that the
+   test at line iLineNum failed. */
+
+static void assure(int iSuccessful, int iLineNum)
+{
+   if (! iSuccessful)
+   {
+      printf("Test at line %d failed.\n", iLineNum);
+      fflush(stdout);
+   }
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Return the number of bytes that oHuge has mapped, however they
+   are backed. */
+
+static size_t mappedBytes(SymTableHuge_T oHuge)
+{
+   struct SymTableHugeStats sStats;
+
+   assert(oHuge != NULL);
+
+   SymTableHuge_getStats(oHuge, &sStats);
+   return sStats.hugetlbBytes + sStats.advisedBytes
+      + sStats.plainBytes;
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Put iBindingCount bindings whose keys are numbers in decimal into
+   oSymTable, and check that they are all there. */
+
+static void fill(SymTable_T oSymTable, int iBindingCount)
+{
+   static char acValue[] = "value";
+   char acKey[MAX_KEY_LENGTH];
+   int iSuccessful;
+   int i;
+
+   assert(oSymTable != NULL);
+
+   for (i = 0; i < iBindingCount; i++)
+   {
+      sprintf(acKey, "%d", i);
+      iSuccessful = SymTable_put(oSymTable, acKey, acValue);
+      ASSURE(iSuccessful);
+   }
+   ASSURE(SymTable_getLength(oSymTable) == (size_t)iBindingCount);
+   for (i = 0; i < iBindingCount; i++)
+   {
+      sprintf(acKey, "%d", i);
+      ASSURE(SymTable_get(oSymTable, acKey) == acValue);
+   }
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test tables made with a SymTableHuge_T on iBindingCount bindings:
+   two tables sharing the allocator, and a table that reuses the
+   memory a freed one released. */
+
+static void testHuge(int iBindingCount)
+{
+   struct SymTableAllocator sAllocator;
+   struct SymTableMemory sMemory;
+   SymTableHuge_T oHuge;
+   SymTable_T oSymTable1;
+   SymTable_T oSymTable2;
+   char acKey[MAX_KEY_LENGTH];
+   size_t uMapped;
+   int i;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing tables made with a SymTableHuge_T.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   oHuge = SymTableHuge_new();
+   ASSURE(oHuge != NULL);
+   if (oHuge == NULL)
+      exit(EXIT_FAILURE);
+   ASSURE(mappedBytes(oHuge) == 0);
+   SymTableHuge_getAllocator(&sAllocator);
+
+   oSymTable1 = SymTable_newWithAllocator(&sAllocator, oHuge);
+   ASSURE(oSymTable1 != NULL);
+   oSymTable2 = SymTable_newWithAllocator(&sAllocator, oHuge);
+   ASSURE(oSymTable2 != NULL);
+   if (oSymTable1 == NULL || oSymTable2 == NULL)
+      exit(EXIT_FAILURE);
+   ASSURE(mappedBytes(oHuge) > 0);
+
+   fill(oSymTable1, iBindingCount);
+   ASSURE(SymTable_put(oSymTable2, "Ruth", "3"));
+
+   /* The rounding of each request up to a block counts as slack. */
+   SymTable_memoryUsage(oSymTable2, &sMemory);
+   ASSURE(sMemory.slack > 0);
+   ASSURE(! SymTable_put(oSymTable2, "Ruth", "4"));
+   ASSURE(strcmp((char*)SymTable_get(oSymTable2, "Ruth"), "3") == 0);
+   ASSURE(! SymTable_contains(oSymTable1, "Ruth"));
+
+   /* Removing every other binding and putting them back reuses the
+      blocks they released. */
+   for (i = 0; i < iBindingCount; i += 2)
+   {
+      sprintf(acKey, "%d", i);
+      ASSURE(SymTable_remove(oSymTable1, acKey) != NULL);
+   }
+   SymTable_memoryUsage(oSymTable1, &sMemory);
+   uMapped = mappedBytes(oHuge);
+   for (i = 0; i < iBindingCount; i += 2)
+   {
+      sprintf(acKey, "%d", i);
+      ASSURE(SymTable_put(oSymTable1, acKey, acKey));
+   }
+   ASSURE(mappedBytes(oHuge) == uMapped);
+   ASSURE(SymTable_getLength(oSymTable1) == (size_t)iBindingCount);
+
+   /* A table as large as a freed one fits in the memory it
+      released, once it has finished growing: the bucket array it
+      grows out of is released only then, and SymTable_memoryUsage()
+      finishes the growth. */
+   SymTable_free(oSymTable1);
+   oSymTable1 = SymTable_newWithAllocator(&sAllocator, oHuge);
+   ASSURE(oSymTable1 != NULL);
+   if (oSymTable1 == NULL)
+      exit(EXIT_FAILURE);
+   fill(oSymTable1, iBindingCount);
+   SymTable_memoryUsage(oSymTable1, &sMemory);
+   ASSURE(mappedBytes(oHuge) == uMapped);
+
+   SymTable_free(oSymTable1);
+   SymTable_free(oSymTable2);
+   SymTableHuge_free(oHuge);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test the huge page allocator of the SymTable module. Write the
+   output of the tests to stdout. argv[1] is the number of bindings
+   to put into a potentially large table. Exit with EXIT_FAILURE if
+   argv[1] is missing or not numeric. Otherwise return 0. */
+
+int main(int argc, char *argv[])
+{
+   int iBindingCount;
+
+   if (argc != 2)
+   {
+      fprintf(stderr, "Usage: %s bindingcount\n", argv[0]);
+      exit(EXIT_FAILURE);
+   }
+
+   if (sscanf(argv[1], "%d", &iBindingCount) != 1)
+   {
+      fprintf(stderr, "bindingcount must be numeric\n");
+      exit(EXIT_FAILURE);
+   }
+   if (iBindingCount < 0)
+   {
+      fprintf(stderr, "bindingcount cannot be negative\n");
+      exit(EXIT_FAILURE);
+   }
+
+   testHuge(iBindingCount);
+
+   printf("------------------------------------------------------\n");
+   printf("End of %s.\n", argv[0]);
+   return 0;
+}
@@ -0,0 +1,293 @@
+/*--------------------------------------------------------------------*/
+/* testsymtableprefix.c                                               */
+/* Author: Hugh Peterson                                              */
+/* Tests for the prefix queries of the radix tree symbol table        */
+/* module.                                                            */
+/*--------------------------------------------------------------------*/
+
+#include "symtableradix.h"
+#include "symtablefrozen.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/*--------------------------------------------------------------------*/
+
+#define ASSURE(i) assure(i, __LINE__)
+
+/*--------------------------------------------------------------------*/
+
+enum {MAX_KEY_LENGTH = 32};
+
+/* The keys that collectKey() has seen, in order. */
+
+struct Collected
+{
+   /* The prefix every key must begin with. */
+   const char *pcPrefix;
+
+   /* The last key seen, to check that the keys come in order. */
+   char acLast[MAX_KEY_LENGTH];
+
+   /* The number of keys seen. */
+   size_t uCount;
+};
+
+/*--------------------------------------------------------------------*/
+
+/* If !iSuccessful, print a message to stdout indicating that the
+   test at line iLineNum failed. */
+
+static void assure(int iSuccessful, int iLineNum)
+{
+   if (! iSuccessful)
+   {
+      printf("Test at line %d failed.\n", iLineNum);
+      fflush(stdout);
+   }
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Check that pcKey begins with the prefix of the Collected that
+   pvExtra points to, that it follows the last key seen, and that
+   pvValue is its own copy of pcKey. Then count it. */
+
+static void collectKey(const char *pcKey, void *pvValue, void *pvExtra)
+{
+   struct Collected *psCollected = (struct Collected*)pvExtra;
+
+   assert(pcKey != NULL);
+   assert(psCollected != NULL);
+
+   ASSURE(strncmp(pcKey, psCollected->pcPrefix,
+                  strlen(psCollected->pcPrefix)) == 0);
+   ASSURE(pvValue != NULL && strcmp(pcKey, (char*)pvValue) == 0);
+   if (psCollected->uCount > 0)
+      ASSURE(strcmp(psCollected->acLast, pcKey) < 0);
+   strcpy(psCollected->acLast, pcKey);
+   psCollected->uCount++;
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Return the number of bindings of oSymTable that begin with
+   pcPrefix, as SymTable_mapPrefix() finds them. */
+
+static size_t mapCount(SymTable_T oSymTable, const char *pcPrefix)
+{
+   struct Collected sCollected;
+
+   sCollected.pcPrefix = pcPrefix;
+   sCollected.uCount = 0;
+   SymTable_mapPrefix(oSymTable, pcPrefix, collectKey, &sCollected);
+   return sCollected.uCount;
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test SymTable_mapPrefix() and SymTable_countPrefix() on a few
+   keys that share prefixes. */
+
+static void testPrefixes(void)
+{
+   static const char *apcKeys[] =
+   {
+      "std::vector", "std::map", "std::mutex", "std::", "stdio",
+      "boost::asio", "", "s"
+   };
+   enum {KEY_COUNT = sizeof(apcKeys) / sizeof(apcKeys[0])};
+
+   SymTable_T oSymTable;
+   int iSuccessful;
+   int i;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing SymTable_mapPrefix() and SymTable_countPrefix().\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   oSymTable = SymTable_new();
+   ASSURE(oSymTable != NULL);
+   ASSURE(SymTable_countPrefix(oSymTable, "") == 0);
+   ASSURE(mapCount(oSymTable, "") == 0);
+
+   for (i = 0; i < KEY_COUNT; i++)
+   {
+      iSuccessful = SymTable_put(oSymTable, apcKeys[i],
+                                 (void*)apcKeys[i]);
+      ASSURE(iSuccessful);
+   }
+
+   ASSURE(SymTable_countPrefix(oSymTable, "") == KEY_COUNT);
+   ASSURE(SymTable_countPrefix(oSymTable, "std::") == 4);
+   ASSURE(SymTable_countPrefix(oSymTable, "std::m") == 2);
+   ASSURE(SymTable_countPrefix(oSymTable, "std::mu") == 1);
+   ASSURE(SymTable_countPrefix(oSymTable, "st") == 5);
+   ASSURE(SymTable_countPrefix(oSymTable, "s") == 6);
+   ASSURE(SymTable_countPrefix(oSymTable, "std::vectors") == 0);
+   ASSURE(SymTable_countPrefix(oSymTable, "java") == 0);
+
+   ASSURE(mapCount(oSymTable, "") == KEY_COUNT);
+   ASSURE(mapCount(oSymTable, "std::") == 4);
+   ASSURE(mapCount(oSymTable, "std::m") == 2);
+   ASSURE(mapCount(oSymTable, "boost") == 1);
+   ASSURE(mapCount(oSymTable, "java") == 0);
+
+   /* Removing keys merges the nodes they split. */
+   ASSURE(SymTable_remove(oSymTable, "std::") == apcKeys[3]);
+   ASSURE(SymTable_remove(oSymTable, "std::map") == apcKeys[1]);
+   ASSURE(SymTable_countPrefix(oSymTable, "std::") == 2);
+   ASSURE(SymTable_countPrefix(oSymTable, "std::m") == 1);
+   ASSURE(mapCount(oSymTable, "std::") == 2);
+   ASSURE(SymTable_get(oSymTable, "std::mutex") == apcKeys[2]);
+   ASSURE(! SymTable_contains(oSymTable, "std::"));
+
+   for (i = 0; i < KEY_COUNT; i++)
+      SymTable_remove(oSymTable, apcKeys[i]);
+   ASSURE(SymTable_getLength(oSymTable) == 0);
+   ASSURE(mapCount(oSymTable, "") == 0);
+
+   SymTable_free(oSymTable);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test SymTable_freeze() on a radix tree table, whose SymTable_map()
+   spells every key out in the same buffer. */
+
+static void testFreeze(void)
+{
+   static const char *apcKeys[] =
+   {
+      "std::vector", "std::map", "std::", "stdio", ""
+   };
+   enum {KEY_COUNT = sizeof(apcKeys) / sizeof(apcKeys[0])};
+
+   SymTable_T oSymTable;
+   SymTableFrozen_T oFrozen;
+   int i;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing SymTable_freeze() on a radix tree table.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   oSymTable = SymTable_new();
+   ASSURE(oSymTable != NULL);
+   if (oSymTable == NULL)
+      exit(EXIT_FAILURE);
+   for (i = 0; i < KEY_COUNT; i++)
+      ASSURE(SymTable_put(oSymTable, apcKeys[i], (void*)apcKeys[i]));
+
+   oFrozen = SymTable_freeze(oSymTable);
+   ASSURE(oFrozen != NULL);
+   if (oFrozen == NULL)
+      exit(EXIT_FAILURE);
+
+   /* The frozen table keeps its own copies of the keys. */
+   SymTable_free(oSymTable);
+   ASSURE(SymTableFrozen_getLength(oFrozen) == KEY_COUNT);
+   for (i = 0; i < KEY_COUNT; i++)
+      ASSURE(SymTableFrozen_get(oFrozen, apcKeys[i]) == apcKeys[i]);
+   ASSURE(SymTableFrozen_get(oFrozen, "std::m") == NULL);
+
+   SymTableFrozen_free(oFrozen);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test prefix queries on a potentially large table of iBindingCount
+   bindings whose keys are numbers in decimal. */
+
+static void testLargePrefixes(int iBindingCount)
+{
+   SymTable_T oSymTable;
+   char acKey[MAX_KEY_LENGTH];
+   char *pcKey;
+   size_t uExpected = 0;
+   int iSuccessful;
+   int i;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing prefix queries of a potentially large table.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   oSymTable = SymTable_new();
+   ASSURE(oSymTable != NULL);
+
+   for (i = 0; i < iBindingCount; i++)
+   {
+      pcKey = (char*)malloc(MAX_KEY_LENGTH);
+      ASSURE(pcKey != NULL);
+      if (pcKey == NULL)
+         exit(EXIT_FAILURE);
+      sprintf(pcKey, "%d", i);
+      iSuccessful = SymTable_put(oSymTable, pcKey, pcKey);
+      ASSURE(iSuccessful);
+      if (pcKey[0] == '1')
+         uExpected++;
+   }
+
+   ASSURE(SymTable_countPrefix(oSymTable, "1") == uExpected);
+   ASSURE(mapCount(oSymTable, "1") == uExpected);
+   ASSURE(mapCount(oSymTable, "") == (size_t)iBindingCount);
+
+   /* Remove the keys beginning with 1, each through its value. */
+   for (i = 0; i < iBindingCount; i++)
+   {
+      sprintf(acKey, "%d", i);
+      if (acKey[0] == '1')
+         free(SymTable_remove(oSymTable, acKey));
+   }
+   ASSURE(SymTable_countPrefix(oSymTable, "1") == 0);
+   ASSURE(SymTable_getLength(oSymTable)
+          == (size_t)iBindingCount - uExpected);
+
+   for (i = 0; i < iBindingCount; i++)
+   {
+      sprintf(acKey, "%d", i);
+      free(SymTable_remove(oSymTable, acKey));
+   }
+   ASSURE(SymTable_getLength(oSymTable) == 0);
+   SymTable_free(oSymTable);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test the prefix queries of the radix tree SymTable. Write the
+   output of the tests to stdout. argv[1] is the number of bindings
+   to put into a potentially large table. Exit with EXIT_FAILURE if
+   argv[1] is missing or not numeric. Otherwise return 0. */
+
+int main(int argc, char *argv[])
+{
+   int iBindingCount;
+
+   if (argc != 2)
+   {
+      fprintf(stderr, "Usage: %s bindingcount\n", argv[0]);
+      exit(EXIT_FAILURE);
+   }
+
+   if (sscanf(argv[1], "%d", &iBindingCount) != 1)
+   {
+      fprintf(stderr, "bindingcount must be numeric\n");
+      exit(EXIT_FAILURE);
+   }
+   if (iBindingCount < 0)
+   {
+      fprintf(stderr, "bindingcount cannot be negative\n");
+      exit(EXIT_FAILURE);
+   }
+
+   testPrefixes();
+   testFreeze();
+   testLargePrefixes(iBindingCount);
+
+   printf("------------------------------------------------------\n");
+   printf("End of %s.\n", argv[0]);
+   return 0;
+}
@@ -0,0 +1,245 @@
+/*--------------------------------------------------------------------*/
+/* testsymtablesharded.c                                              */
+/* Author: Hugh Peterson                                              */
+/* Tests for the sharded symbol table module.                         */
+/*--------------------------------------------------------------------*/
+
+#define _POSIX_C_SOURCE 200112L
+
+#include "symtablesharded.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/*--------------------------------------------------------------------*/
+
+#define ASSURE(i) assure(i, __LINE__)
+
+/*--------------------------------------------------------------------*/
+
+enum {THREAD_COUNT = 8};
+enum {MAX_KEY_LENGTH = 32};
+
+/* The work of one thread of testThreads(). */
+
+struct Work
+{
+   /* The table that all of the threads share. */
+   SymTableSharded_T oSharded;
+
+   /* The number of the thread, which appears in each of its keys. */
+   int iThread;
+
+   /* The number of bindings the thread puts. */
+   int iBindingCount;
+
+   /* The number of operations of the thread that went wrong. */
+   int iFailures;
+};
+
+/*--------------------------------------------------------------------*/
+
+/* If !iSuccessful, print a message to stdout indicating that the
+   test at line iLineNum failed. */
+
+static void assure(int iSuccessful, int iLineNum)
+{
+   if (! iSuccessful)
+   {
+      printf("Test at line %d failed.\n", iLineNum);
+      fflush(stdout);
+   }
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Increment the size_t that pvExtra points to. */
+
+static void countBinding(const char *pcKey, void *pvValue,
+                         void *pvExtra)
+{
+   assert(pcKey != NULL);
+   assert(pvExtra != NULL);
+
+   (void)pvValue;
+   (*(size_t*)pvExtra)++;
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test the basic SymTableSharded functions. */
+
+static void testBasics(void)
+{
+   SymTableSharded_T oSharded;
+   char acShortstop[] = "Shortstop";
+   char acCenterField[] = "Center Field";
+   size_t uCount = 0;
+   int iSuccessful;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing the basic SymTableSharded functions.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   ASSURE(SymTableSharded_new(0) == NULL);
+
+   oSharded = SymTableSharded_new(5);
+   ASSURE(oSharded != NULL);
+   ASSURE(SymTableSharded_getShardCount(oSharded) == 8);
+   ASSURE(SymTableSharded_getLength(oSharded) == 0);
+
+   iSuccessful = SymTableSharded_put(oSharded, "Jeter", acShortstop);
+   ASSURE(iSuccessful);
+   iSuccessful = SymTableSharded_put(oSharded, "Mantle",
+                                     acCenterField);
+   ASSURE(iSuccessful);
+   iSuccessful = SymTableSharded_put(oSharded, "Jeter", acCenterField);
+   ASSURE(! iSuccessful);
+   ASSURE(SymTableSharded_getLength(oSharded) == 2);
+
+   ASSURE(SymTableSharded_get(oSharded, "Jeter") == acShortstop);
+   ASSURE(SymTableSharded_contains(oSharded, "Mantle"));
+   ASSURE(! SymTableSharded_contains(oSharded, "Ruth"));
+   ASSURE(SymTableSharded_replace(oSharded, "Mantle", acShortstop)
+          == acCenterField);
+   ASSURE(SymTableSharded_replace(oSharded, "Ruth", acShortstop)
+          == NULL);
+
+   SymTableSharded_map(oSharded, countBinding, &uCount);
+   ASSURE(uCount == 2);
+
+   ASSURE(SymTableSharded_remove(oSharded, "Jeter") == acShortstop);
+   ASSURE(SymTableSharded_remove(oSharded, "Jeter") == NULL);
+   ASSURE(SymTableSharded_getLength(oSharded) == 1);
+
+   SymTableSharded_free(oSharded);
+
+   /* A single shard works too. */
+   oSharded = SymTableSharded_new(1);
+   ASSURE(oSharded != NULL);
+   ASSURE(SymTableSharded_getShardCount(oSharded) == 1);
+   iSuccessful = SymTableSharded_put(oSharded, "Jeter", acShortstop);
+   ASSURE(iSuccessful);
+   ASSURE(SymTableSharded_get(oSharded, "Jeter") == acShortstop);
+   SymTableSharded_free(oSharded);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Put the keys of the thread described by the Work that pvWork points
+   to, look them up along with the keys of the other threads, and
+   remove every other one. Count the operations that go wrong. */
+
+static void *work(void *pvWork)
+{
+   struct Work *psWork = (struct Work*)pvWork;
+   char acKey[MAX_KEY_LENGTH];
+   int i;
+
+   assert(psWork != NULL);
+
+   for (i = 0; i < psWork->iBindingCount; i++)
+   {
+      sprintf(acKey, "%d.%d", psWork->iThread, i);
+      if (! SymTableSharded_put(psWork->oSharded, acKey, psWork))
+         psWork->iFailures++;
+      /* a key of another thread, which may or may not be there */
+      sprintf(acKey, "%d.%d", (psWork->iThread + 1) % THREAD_COUNT, i);
+      SymTableSharded_get(psWork->oSharded, acKey);
+   }
+
+   for (i = 0; i < psWork->iBindingCount; i++)
+   {
+      sprintf(acKey, "%d.%d", psWork->iThread, i);
+      if (SymTableSharded_get(psWork->oSharded, acKey) != psWork)
+         psWork->iFailures++;
+      if (i % 2 == 0
+          && SymTableSharded_remove(psWork->oSharded, acKey) != psWork)
+         psWork->iFailures++;
+   }
+   return NULL;
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test a SymTableSharded object that THREAD_COUNT threads use at once,
+   each putting iBindingCount / THREAD_COUNT bindings. */
+
+static void testThreads(int iBindingCount)
+{
+   SymTableSharded_T oSharded;
+   struct Work asWork[THREAD_COUNT];
+   pthread_t aThreads[THREAD_COUNT];
+   size_t uExpected = 0;
+   size_t uCount = 0;
+   int i;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing a SymTableSharded object shared by threads.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   oSharded = SymTableSharded_new(16);
+   ASSURE(oSharded != NULL);
+
+   for (i = 0; i < THREAD_COUNT; i++)
+   {
+      asWork[i].oSharded = oSharded;
+      asWork[i].iThread = i;
+      asWork[i].iBindingCount = iBindingCount / THREAD_COUNT;
+      asWork[i].iFailures = 0;
+      uExpected += (size_t)(asWork[i].iBindingCount / 2);
+      ASSURE(pthread_create(&aThreads[i], NULL, work, &asWork[i])
+             == 0);
+   }
+   for (i = 0; i < THREAD_COUNT; i++)
+   {
+      ASSURE(pthread_join(aThreads[i], NULL) == 0);
+      ASSURE(asWork[i].iFailures == 0);
+   }
+
+   ASSURE(SymTableSharded_getLength(oSharded) == uExpected);
+   SymTableSharded_map(oSharded, countBinding, &uCount);
+   ASSURE(uCount == uExpected);
+
+   SymTableSharded_free(oSharded);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test the SymTableSharded ADT. Write the output of the tests to
+   stdout. argv[1] is the number of bindings the threads put into a
+   potentially large table. Exit with EXIT_FAILURE if argv[1] is
+   missing or not numeric. Otherwise return 0. */
+
+int main(int argc, char *argv[])
+{
+   int iBindingCount;
+
+   if (argc != 2)
+   {
+      fprintf(stderr, "Usage: %s bindingcount\n", argv[0]);
+      exit(EXIT_FAILURE);
+   }
+
+   if (sscanf(argv[1], "%d", &iBindingCount) != 1)
+   {
+      fprintf(stderr, "bindingcount must be numeric\n");
+      exit(EXIT_FAILURE);
+   }
+   if (iBindingCount < 0)
+   {
+      fprintf(stderr, "bindingcount cannot be negative\n");
+      exit(EXIT_FAILURE);
+   }
+
+   testBasics();
+   testThreads(iBindingCount);
+
+   printf("------------------------------------------------------\n");
+   printf("End of %s.\n", argv[0]);
+   return 0;
+}
@@ -0,0 +1,217 @@
+/*--------------------------------------------------------------------*/
+/* testsymtablesnapshot.c                                             */
+/* Author: Hugh Peterson                                              */
+/* Tests for the snapshots of the persistent symbol table module.     */
+/*--------------------------------------------------------------------*/
+
+#include "symtablehamt.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/*--------------------------------------------------------------------*/
+
+#define ASSURE(i) assure(i, __LINE__)
+
+/*--------------------------------------------------------------------*/
+
+enum {MAX_KEY_LENGTH = 32};
+
+/*--------------------------------------------------------------------*/
+
+/* If !iSuccessful, print a message to stdout indicating that the
+   test at line iLineNum failed. */
+
+static void assure(int iSuccessful, int iLineNum)
+{
+   if (! iSuccessful)
+   {
+      printf("Test at line %d failed.\n", iLineNum);
+      fflush(stdout);
+   }
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Increment the size_t that pvExtra points to. */
+
+static void countBinding(const char *pcKey, void *pvValue,
+                         void *pvExtra)
+{
+   assert(pcKey != NULL);
+   assert(pvExtra != NULL);
+
+   (void)pvValue;
+   (*(size_t*)pvExtra)++;
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test that a snapshot keeps the bindings of its table at the time it
+   was taken, however the two are changed afterwards. */
+
+static void testSnapshot(void)
+{
+   SymTable_T oSymTable;
+   SymTable_T oSnapshot;
+   SymTable_T oSecond;
+   char acShortstop[] = "Shortstop";
+   char acCenterField[] = "Center Field";
+   char acRightField[] = "Right Field";
+   size_t uCount = 0;
+   int iSuccessful;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing SymTable_snapshot.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   oSymTable = SymTable_new();
+   ASSURE(oSymTable != NULL);
+
+   /* A snapshot of an empty table. */
+   oSnapshot = SymTable_snapshot(oSymTable);
+   ASSURE(oSnapshot != NULL);
+   iSuccessful = SymTable_put(oSymTable, "Jeter", acShortstop);
+   ASSURE(iSuccessful);
+   ASSURE(SymTable_getLength(oSnapshot) == 0);
+   ASSURE(! SymTable_contains(oSnapshot, "Jeter"));
+   SymTable_free(oSnapshot);
+
+   iSuccessful = SymTable_put(oSymTable, "Mantle", acCenterField);
+   ASSURE(iSuccessful);
+   oSnapshot = SymTable_snapshot(oSymTable);
+   ASSURE(oSnapshot != NULL);
+
+   /* Changes to the table do not reach the snapshot. */
+   ASSURE(SymTable_replace(oSymTable, "Jeter", acRightField)
+          == acShortstop);
+   ASSURE(SymTable_remove(oSymTable, "Mantle") == acCenterField);
+   iSuccessful = SymTable_put(oSymTable, "Ruth", acRightField);
+   ASSURE(iSuccessful);
+
+   ASSURE(SymTable_getLength(oSnapshot) == 2);
+   ASSURE(SymTable_get(oSnapshot, "Jeter") == acShortstop);
+   ASSURE(SymTable_get(oSnapshot, "Mantle") == acCenterField);
+   ASSURE(! SymTable_contains(oSnapshot, "Ruth"));
+   SymTable_map(oSnapshot, countBinding, &uCount);
+   ASSURE(uCount == 2);
+
+   /* Nor do changes to the snapshot reach the table. */
+   oSecond = SymTable_snapshot(oSnapshot);
+   ASSURE(oSecond != NULL);
+   ASSURE(SymTable_remove(oSnapshot, "Jeter") == acShortstop);
+   ASSURE(SymTable_get(oSymTable, "Jeter") == acRightField);
+   ASSURE(SymTable_get(oSecond, "Jeter") == acShortstop);
+   ASSURE(SymTable_getLength(oSymTable) == 2);
+   ASSURE(SymTable_getLength(oSecond) == 2);
+
+   /* Each version lives on after the others are freed. */
+   SymTable_free(oSymTable);
+   SymTable_free(oSnapshot);
+   ASSURE(SymTable_get(oSecond, "Mantle") == acCenterField);
+   SymTable_free(oSecond);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Put iBindingCount bindings into a table, snapshotting it after each
+   tenth, then check every snapshot and remove the bindings from the
+   table. Keys are numbers in decimal, so the trie has many levels
+   once iBindingCount is large. */
+
+static void testManySnapshots(int iBindingCount)
+{
+   enum {SNAPSHOT_COUNT = 10};
+
+   SymTable_T oSymTable;
+   SymTable_T aoSnapshots[SNAPSHOT_COUNT];
+   int aiLengths[SNAPSHOT_COUNT];
+   char acKey[MAX_KEY_LENGTH];
+   int iSnapshots = 0;
+   int iSuccessful;
+   int i;
+   int j;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing many snapshots of a potentially large table.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   oSymTable = SymTable_new();
+   ASSURE(oSymTable != NULL);
+
+   for (i = 0; i < iBindingCount; i++)
+   {
+      if (iSnapshots < SNAPSHOT_COUNT
+          && i == iSnapshots * (iBindingCount / SNAPSHOT_COUNT))
+      {
+         aoSnapshots[iSnapshots] = SymTable_snapshot(oSymTable);
+         ASSURE(aoSnapshots[iSnapshots] != NULL);
+         aiLengths[iSnapshots] = i;
+         iSnapshots++;
+      }
+      sprintf(acKey, "%d", i);
+      iSuccessful = SymTable_put(oSymTable, acKey, (void*)acKey);
+      ASSURE(iSuccessful);
+   }
+
+   for (i = 0; i < iBindingCount; i++)
+   {
+      sprintf(acKey, "%d", i);
+      ASSURE(SymTable_remove(oSymTable, acKey) == (void*)acKey);
+   }
+   ASSURE(SymTable_getLength(oSymTable) == 0);
+   SymTable_free(oSymTable);
+
+   /* Snapshot j holds exactly the keys below aiLengths[j]. */
+   for (j = 0; j < iSnapshots; j++)
+   {
+      ASSURE(SymTable_getLength(aoSnapshots[j])
+             == (size_t)aiLengths[j]);
+      for (i = 0; i < iBindingCount; i += 7)
+      {
+         sprintf(acKey, "%d", i);
+         ASSURE(SymTable_contains(aoSnapshots[j], acKey)
+                == (i < aiLengths[j]));
+      }
+      SymTable_free(aoSnapshots[j]);
+   }
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test SymTable_snapshot. Write the output of the tests to stdout.
+   argv[1] is the number of bindings to put into a potentially large
+   table. Exit with EXIT_FAILURE if argv[1] is missing or not numeric.
+   Otherwise return 0. */
+
+int main(int argc, char *argv[])
+{
+   int iBindingCount;
+
+   if (argc != 2)
+   {
+      fprintf(stderr, "Usage: %s bindingcount\n", argv[0]);
+      exit(EXIT_FAILURE);
+   }
+
+   if (sscanf(argv[1], "%d", &iBindingCount) != 1)
+   {
+      fprintf(stderr, "bindingcount must be numeric\n");
+      exit(EXIT_FAILURE);
+   }
+   if (iBindingCount < 0)
+   {
+      fprintf(stderr, "bindingcount cannot be negative\n");
+      exit(EXIT_FAILURE);
+   }
+
+   testSnapshot();
+   testManySnapshots(iBindingCount);
+
+   printf("------------------------------------------------------\n");
+   printf("End of %s.\n", argv[0]);
+   return 0;
+}
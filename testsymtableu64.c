@@ -0,0 +1,205 @@
+/*--------------------------------------------------------------------*/
+/* testsymtableu64.c                                                  */
+/* Author: Hugh Peterson                                              */
+/* Tests for the integer-keyed symbol table module.                   */
+/*--------------------------------------------------------------------*/
+
+#include "symtableu64.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <assert.h>
+
+/*--------------------------------------------------------------------*/
+
+#define ASSURE(i) assure(i, __LINE__)
+
+/*--------------------------------------------------------------------*/
+
+/* If !iSuccessful, print a message to stdout indicating that the
+   test at line iLineNum failed. */
+
+static void assure(int iSuccessful, int iLineNum)
+{
+   if (! iSuccessful)
+   {
+      printf("Test at line %d failed.\n", iLineNum);
+      fflush(stdout);
+   }
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Add ulKey to the unsigned long that pvExtra points to, checking
+   that pvValue points to an unsigned long equal to ulKey. */
+
+static void sumKeys(unsigned long ulKey, void *pvValue, void *pvExtra)
+{
+   assert(pvExtra != NULL);
+
+   ASSURE((pvValue != NULL) && (*(unsigned long*)pvValue == ulKey));
+   *(unsigned long*)pvExtra += ulKey;
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test the basic operations, including on the keys 0 and
+   ULONG_MAX. */
+
+static void testBasics(void)
+{
+   SymTableU64_T oSymTable;
+   char acShortstop[] = "Shortstop";
+   char acCenterField[] = "Center Field";
+   char acCatcher[] = "Catcher";
+   char *pcValue;
+   int iSuccessful;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing the basic SymTableU64 functions.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   oSymTable = SymTableU64_new();
+   ASSURE(oSymTable != NULL);
+   ASSURE(SymTableU64_getLength(oSymTable) == 0);
+   ASSURE(! SymTableU64_contains(oSymTable, 0));
+   ASSURE(SymTableU64_get(oSymTable, 2) == NULL);
+
+   iSuccessful = SymTableU64_put(oSymTable, 2, acShortstop);
+   ASSURE(iSuccessful);
+   iSuccessful = SymTableU64_put(oSymTable, 0, acCenterField);
+   ASSURE(iSuccessful);
+   iSuccessful = SymTableU64_put(oSymTable, ULONG_MAX, acCatcher);
+   ASSURE(iSuccessful);
+   iSuccessful = SymTableU64_put(oSymTable, 0, acCatcher);
+   ASSURE(! iSuccessful);
+   iSuccessful = SymTableU64_put(oSymTable, 2, acCatcher);
+   ASSURE(! iSuccessful);
+   ASSURE(SymTableU64_getLength(oSymTable) == 3);
+
+   ASSURE(SymTableU64_get(oSymTable, 2) == acShortstop);
+   ASSURE(SymTableU64_get(oSymTable, 0) == acCenterField);
+   ASSURE(SymTableU64_get(oSymTable, ULONG_MAX) == acCatcher);
+   ASSURE(SymTableU64_contains(oSymTable, 0));
+   ASSURE(! SymTableU64_contains(oSymTable, 1));
+
+   pcValue = (char*)SymTableU64_replace(oSymTable, 0, acShortstop);
+   ASSURE(pcValue == acCenterField);
+   pcValue = (char*)SymTableU64_replace(oSymTable, 2, NULL);
+   ASSURE(pcValue == acShortstop);
+   ASSURE(SymTableU64_contains(oSymTable, 2));
+   ASSURE(SymTableU64_get(oSymTable, 2) == NULL);
+   pcValue = (char*)SymTableU64_replace(oSymTable, 3, acShortstop);
+   ASSURE(pcValue == NULL);
+
+   pcValue = (char*)SymTableU64_remove(oSymTable, 0);
+   ASSURE(pcValue == acShortstop);
+   ASSURE(! SymTableU64_contains(oSymTable, 0));
+   ASSURE(SymTableU64_remove(oSymTable, 0) == NULL);
+   pcValue = (char*)SymTableU64_remove(oSymTable, ULONG_MAX);
+   ASSURE(pcValue == acCatcher);
+   ASSURE(SymTableU64_getLength(oSymTable) == 1);
+
+   SymTableU64_free(oSymTable);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test a potentially large SymTableU64 object of iBindingCount
+   bindings, removing every other binding to exercise the shifting of
+   probe sequences, and mapping over the rest. */
+
+static void testLargeTable(int iBindingCount)
+{
+   SymTableU64_T oSymTable;
+   unsigned long *aulValues;
+   unsigned long ulKey;
+   unsigned long ulSum = 0;
+   unsigned long ulExpected = 0;
+   int iSuccessful;
+   int i;
+
+   printf("------------------------------------------------------\n");
+   printf("Testing a potentially large SymTableU64 object.\n");
+   printf("No output should appear here:\n");
+   fflush(stdout);
+
+   aulValues = (unsigned long*)
+      malloc(sizeof(unsigned long) * (size_t)(iBindingCount + 1));
+   ASSURE(aulValues != NULL);
+
+   oSymTable = SymTableU64_new();
+   ASSURE(oSymTable != NULL);
+
+   /* Keys in arithmetic progression share their low bits. */
+   for (i = 0; i < iBindingCount; i++)
+   {
+      ulKey = (unsigned long)i * 4096;
+      aulValues[i] = ulKey;
+      iSuccessful = SymTableU64_put(oSymTable, ulKey, &aulValues[i]);
+      ASSURE(iSuccessful);
+   }
+   ASSURE(SymTableU64_getLength(oSymTable) == (size_t)iBindingCount);
+
+   for (i = 0; i < iBindingCount; i += 2)
+      ASSURE(SymTableU64_remove(oSymTable, (unsigned long)i * 4096)
+             == &aulValues[i]);
+
+   for (i = 0; i < iBindingCount; i++)
+   {
+      ulKey = (unsigned long)i * 4096;
+      if (i % 2 == 0)
+         ASSURE(! SymTableU64_contains(oSymTable, ulKey));
+      else
+      {
+         ASSURE(SymTableU64_get(oSymTable, ulKey) == &aulValues[i]);
+         ulExpected += ulKey;
+      }
+      ASSURE(! SymTableU64_contains(oSymTable, ulKey + 1));
+   }
+
+   SymTableU64_map(oSymTable, sumKeys, &ulSum);
+   ASSURE(ulSum == ulExpected);
+   ASSURE(SymTableU64_getLength(oSymTable)
+          == (size_t)(iBindingCount / 2));
+
+   SymTableU64_free(oSymTable);
+   free(aulValues);
+}
+
+/*--------------------------------------------------------------------*/
+
+/* Test the SymTableU64 ADT. Write the output of the tests to stdout.
+   argv[1] is the number of bindings to put into a potentially large
+   table. Exit with EXIT_FAILURE if argv[1] is missing or not numeric.
+   Otherwise return 0. */
+
+int main(int argc, char *argv[])
+{
+   int iBindingCount;
+
+   if (argc != 2)
+   {
+      fprintf(stderr, "Usage: %s bindingcount\n", argv[0]);
+      exit(EXIT_FAILURE);
+   }
+
+   if (sscanf(argv[1], "%d", &iBindingCount) != 1)
+   {
+      fprintf(stderr, "bindingcount must be numeric\n");
+      exit(EXIT_FAILURE);
+   }
+   if (iBindingCount < 0)
+   {
+      fprintf(stderr, "bindingcount cannot be negative\n");
+      exit(EXIT_FAILURE);
+   }
+
+   testBasics();
+   testLargeTable(iBindingCount);
+
+   printf("------------------------------------------------------\n");
+   printf("End of %s.\n", argv[0]);
+   return 0;
+}